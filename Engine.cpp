@@ -5,7 +5,9 @@
 #include "Engine.h"
 #include "common/debug.h"
 #include "util/Time.h"
+#include "util/WorkerPool.h"
 #include "GL/GraphicsGL.h"
+#include "Null/GraphicsNull.h"
 #include "geometry/Vector3.h"
 #include "math/Math.h"
 #include "math/Quaternion.h"
@@ -14,6 +16,7 @@
 #include "animation/VertexBoneMap.h"
 #include "render/BaseObject3DRenderer.h"
 #include "render/ReflectionProbe.h"
+#include "render/Renderer.h"
 #include "scene/Scene.h"
 #include "scene/Object3D.h"
 #include "render/Camera.h"
@@ -34,6 +37,7 @@ namespace Core {
 
     std::shared_ptr<Engine> Engine::_instance;
     Bool Engine::_shuttingDown = false;
+    Engine::GraphicsBackend Engine::_graphicsBackend = Engine::GraphicsBackend::OpenGL;
 
     WeakPointer<Engine> Engine::instance() {
         errorIfShuttingDown();
@@ -48,6 +52,21 @@ namespace Core {
         return _shuttingDown;
     }
 
+    /*
+     * Select the graphics implementation the engine is created with. GraphicsBackend::Null runs the full
+     * frame pipeline without a graphics context (see GraphicsNull). Must be called before the first call to instance().
+     */
+    void Engine::setGraphicsBackend(GraphicsBackend backend) {
+        if (_instance) {
+            throw Exception("Engine::setGraphicsBackend() -> Graphics backend cannot be changed after the engine has been created.");
+        }
+        _graphicsBackend = backend;
+    }
+
+    Engine::GraphicsBackend Engine::getGraphicsBackend() {
+        return _graphicsBackend;
+    }
+
     void Engine::errorIfShuttingDown() {
         if(_shuttingDown) {
             throw Exception("Cannot access engine during shutdown.");
@@ -63,10 +82,16 @@ namespace Core {
     }
     
     void Engine::init() {
-
-        // TODO: make this configurable so that it is not hard-coded to use OpenGL
-        std::shared_ptr<GraphicsGL> graphicsSystem(new GraphicsGL(GraphicsGL::GLVersion::Three));
-        this->graphics = std::static_pointer_cast<Graphics>(graphicsSystem);
+        this->setWorkerCount(WorkerPool::getDefaultWorkerCount());
+
+        switch (_graphicsBackend) {
+            case GraphicsBackend::Null:
+                this->graphics = std::shared_ptr<Graphics>(new GraphicsNull());
+            break;
+            case GraphicsBackend::OpenGL:
+                this->graphics = std::shared_ptr<Graphics>(new GraphicsGL(GraphicsGL::GLVersion::Three));
+            break;
+        }
         this->graphics->init();
 
         this->animationManager = std::shared_ptr<AnimationManager>(new AnimationManager());
@@ -154,11 +179,27 @@ namespace Core {
             this->graphics->preRender();
             this->resolveRenderCallbacks(this->preRenderCallbacks, this->persistentPreRenderCallbacks);
             if (this->graphics->getRenderer()) {
-               this->graphics->getRenderer()->renderScene(this->activeScene);
+               WeakPointer<Renderer> renderer = this->graphics->getRenderer();
+               renderer->renderScene(this->activeScene);
+               // particle simulation LOD is driven by the cameras that were actually rendered; cube cameras
+               // (reflection probes) aren't reported, so particles seen only in reflections may be paused
+               for (const Renderer::RenderedView& view : renderer->getRenderedViews()) {
+                   this->particleSystemManager->addView(view.frustum, view.position);
+               }
             }
             this->resolveRenderCallbacks(this->postRenderCallbacks, this->persistentPostRenderCallbacks);
             this->graphics->postRender();
         }
+        this->destroyReleasedObjects();
+    }
+
+    /*
+     * Destroy the objects whose last owner released them since the previous call. Engine objects go first, since
+     * their destructors release graphics objects (textures, render targets) in turn.
+     */
+    void Engine::destroyReleasedObjects() {
+        this->objectManager.destroyReleasedObjects();
+        this->graphics->objectManager.destroyReleasedObjects();
     }
 
     void Engine::setRenderSize(UInt32 width, UInt32 height, Bool updateViewport) {
@@ -196,6 +237,24 @@ namespace Core {
         return this->particleSystemManager;
     }
 
+    WeakPointer<WorkerPool> Engine::getWorkerPool() {
+        errorIfShuttingDown();
+        return this->workerPool;
+    }
+
+    /*
+     * Set the number of background threads shared by animation, particle simulation and rendering. With a count
+     * of 0 all of that work runs on the calling thread. Must not be called while one of them is using the pool.
+     */
+    void Engine::setWorkerCount(UInt32 workerCount) {
+        if (this->workerPool && this->workerPool->getWorkerCount() == workerCount) return;
+        this->workerPool = std::make_shared<WorkerPool>(workerCount);
+    }
+
+    UInt32 Engine::getWorkerCount() const {
+        return this->workerPool->getWorkerCount();
+    }
+
     void Engine::safeReleaseObject(WeakPointer<CoreObject> object) {
         if(!Engine::isShuttingDown()) {
             Engine::instance()->objectManager.removeReference(object);
@@ -206,6 +265,10 @@ namespace Core {
         this->objectManager.addReferenceOwner(object);
     }
 
+    const CoreObjectReferenceManager& Engine::getObjectManager() const {
+        return this->objectManager;
+    }
+
     void Engine::setActiveScene(WeakPointer<Scene> scene) {
         this->activeScene = scene.lock();
     }
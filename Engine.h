@@ -38,15 +38,23 @@ namespace Core {
     class Mesh;
     class AttributeArrayGPUStorage;
     class IndexBuffer;
+    class WorkerPool;
 
     class Engine final {
     public:
         typedef std::function<void()> LifecycleEventCallback;
 
+        enum class GraphicsBackend {
+            OpenGL = 0,
+            Null = 1
+        };
+
         ~Engine();
 
         static WeakPointer<Engine> instance();
         static Bool isShuttingDown();
+        static void setGraphicsBackend(GraphicsBackend backend);
+        static GraphicsBackend getGraphicsBackend();
 
         void update();
         void render();
@@ -61,9 +69,14 @@ namespace Core {
         WeakPointer<Graphics> getGraphicsSystem();
         WeakPointer<AnimationManager> getAnimationManager();
         WeakPointer<ParticleSystemManager> getParticleSystemManager();
+        WeakPointer<WorkerPool> getWorkerPool();
+        void setWorkerCount(UInt32 workerCount);
+        UInt32 getWorkerCount() const;
 
         static void safeReleaseObject(WeakPointer<CoreObject> object);
         void addOwner(WeakPointer<CoreObject> object);
+        void destroyReleasedObjects();
+        const CoreObjectReferenceManager& getObjectManager() const;
 
         void setActiveScene(WeakPointer<Scene> scene);
         WeakPointer<Scene> getActiveScene();
@@ -121,9 +134,9 @@ namespace Core {
         template <typename T, typename R>
         WeakPointer<typename std::enable_if<std::is_base_of<RenderableContainer<R>, T>::value, T>::type> createRenderableContainer(WeakPointer<Object3D> owner) {
             std::shared_ptr<T> renderableContainer = std::shared_ptr<T>(new T(owner));
+            this->objectManager.addReference(renderableContainer, CoreObjectReferenceManager::OwnerType::Single);
             WeakPointer<T> _temp = renderableContainer;
             owner->addComponent(_temp);
-            this->objectManager.addReference(renderableContainer, CoreObjectReferenceManager::OwnerType::Single);
             return renderableContainer;
         }
 
@@ -131,9 +144,9 @@ namespace Core {
         WeakPointer<typename std::enable_if<std::is_base_of<Object3DRenderer<R>, T>::value, T>::type> createRenderer(WeakPointer<Material> material,
                                                                                                                      WeakPointer<Object3D> owner) {
             std::shared_ptr<T> renderer = std::shared_ptr<T>(new T(material, owner));
+            this->objectManager.addReference(renderer, CoreObjectReferenceManager::OwnerType::Single);
             WeakPointer<T> _temp = renderer;
             owner->addComponent(_temp);
-            this->objectManager.addReference(renderer, CoreObjectReferenceManager::OwnerType::Single);
             renderer->init();
             return renderer;
         }
@@ -141,9 +154,9 @@ namespace Core {
         template <typename T, typename R>
         WeakPointer<typename std::enable_if<std::is_base_of<Object3DRenderer<R>, T>::value, T>::type> createRenderer(WeakPointer<Object3D> owner) {
             std::shared_ptr<T> renderer = std::shared_ptr<T>(new T(owner));
+            this->objectManager.addReference(renderer, CoreObjectReferenceManager::OwnerType::Single);
             WeakPointer<T> _temp = renderer;
             owner->addComponent(_temp);
-            this->objectManager.addReference(renderer, CoreObjectReferenceManager::OwnerType::Single);
             renderer->init();
             return renderer;
         }
@@ -190,11 +203,14 @@ namespace Core {
 
         static std::shared_ptr<Engine> _instance;
         static Bool _shuttingDown;
+        static GraphicsBackend _graphicsBackend;
         static void errorIfShuttingDown();
 
         Bool profilingEnabled;
 
         CoreObjectReferenceManager objectManager;
+        // background threads shared by animation, particle simulation and rendering, which take turns using it
+        std::shared_ptr<WorkerPool> workerPool;
         std::shared_ptr<ParticleSystemManager> particleSystemManager;
         std::shared_ptr<AnimationManager> animationManager;
         std::shared_ptr<Graphics> graphics;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string.h>
+#include <stdint.h>
 #include <new>
 
 #include "../geometry/AttributeArrayGPUStorage.h"
@@ -12,16 +13,16 @@ namespace Core {
     class AttributeArrayGPUStorageGL final: public AttributeArrayGPUStorage {
     public:
         AttributeArrayGPUStorageGL(UInt32 size, UInt32 componentCount, GLenum type, GLboolean normalize, GLsizei stride): 
-            size(size), componentCount(componentCount), type(type), normalize(normalize), stride(stride) {
-            buildGPUBuffer();
+            size(size), componentCount(componentCount), type(type), normalize(normalize), stride(stride), builtBufferCount(0), currentBuffer(0) {
+            buildGPUBuffers(1);
         }
 
         ~AttributeArrayGPUStorageGL() override{
-            destroyGPUBuffer();
+            destroyGPUBuffers();
         }
 
         Int32 getBufferID() const override {
-            return this->bufferID;
+            return this->bufferIDs[this->currentBuffer];
         }
 
         GLenum getType() const {
@@ -37,16 +38,21 @@ namespace Core {
         }
 
         void enableAndSendToActiveShader(UInt32 location) override {
-            glBindBuffer(GL_ARRAY_BUFFER, this->bufferID);
+            this->enableAndSendToActiveShader(location, this->componentCount, this->stride, 0);
+        }
+
+        void enableAndSendToActiveShader(UInt32 location, UInt32 componentCount, UInt32 byteStride, UInt32 byteOffset) override {
+            const GLvoid* offset = (const GLvoid*)(uintptr_t)byteOffset;
+            glBindBuffer(GL_ARRAY_BUFFER, this->bufferIDs[this->currentBuffer]);
             glEnableVertexAttribArray(location);
             if (this->type == GL_INT || this->type == GL_UNSIGNED_INT) {
 #ifdef __APPLE__
-                glVertexAttribIPointerEXT(location, this->componentCount, this->type, this->stride, 0);
+                glVertexAttribIPointerEXT(location, componentCount, this->type, byteStride, offset);
 #else
-                glVertexAttribIPointer(location, this->componentCount, this->type, this->stride, 0);
+                glVertexAttribIPointer(location, componentCount, this->type, byteStride, offset);
 #endif
             } else {
-                glVertexAttribPointer(location, this->componentCount, this->type, this->normalize, this->stride, 0);
+                glVertexAttribPointer(location, componentCount, this->type, this->normalize, byteStride, offset);
             }
             glBindBuffer(GL_ARRAY_BUFFER, 0);
         }
@@ -56,25 +62,62 @@ namespace Core {
         }
 
         void updateBufferData(void * data) override {
-            glBindBuffer(GL_ARRAY_BUFFER, this->bufferID);
+            if (this->ringBuffered) {
+                this->updateBufferRange(data, 0, this->size);
+                return;
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, this->bufferIDs[this->currentBuffer]);
             glBufferData(GL_ARRAY_BUFFER, this->size, data, GL_DYNAMIC_DRAW);
             glBindBuffer(GL_ARRAY_BUFFER, 0);
+            this->recordUpload(this->size);
+        }
+
+        /*
+         * Upload bytes [byteOffset, byteOffset + byteCount) of [data], which points at the start of the buffer's
+         * contents. When ring buffered, the range goes to the buffer least recently written, which draws issued
+         * against the other two don't depend on, so the driver doesn't have to wait for them or copy the buffer.
+         * Otherwise a range starting at the front of the buffer is taken to be its live contents: the storage is
+         * orphaned with glBufferData() first, for the same reason, and the bytes past the range are left undefined.
+         */
+        void updateBufferRange(const void * data, UInt32 byteOffset, UInt32 byteCount) override {
+            if (byteOffset >= this->size) return;
+            if (byteCount > this->size - byteOffset) byteCount = this->size - byteOffset;
+            if (byteCount == 0) return;
+
+            if (this->ringBuffered) {
+                if (this->builtBufferCount < RingBufferCount) this->buildGPUBuffers(RingBufferCount);
+                this->currentBuffer = (this->currentBuffer + 1) % RingBufferCount;
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, this->bufferIDs[this->currentBuffer]);
+            if (!this->ringBuffered && byteOffset == 0) glBufferData(GL_ARRAY_BUFFER, this->size, nullptr, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, byteOffset, byteCount, (const Byte*)data + byteOffset);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            this->recordUpload(byteCount);
         }
 
     private:
         UInt32 size;
         UInt32 componentCount;
-        GLuint bufferID;
+        GLuint bufferIDs[RingBufferCount];
         GLenum type;
         GLboolean normalize;
         GLsizei stride;
-
-        void buildGPUBuffer() {
-            glGenBuffers(1, &this->bufferID);
+        UInt32 builtBufferCount;
+        UInt32 currentBuffer;
+
+        // storage is allocated up front so ranges can be uploaded before the buffer has ever been filled
+        void buildGPUBuffers(UInt32 bufferCount) {
+            glGenBuffers(bufferCount - this->builtBufferCount, this->bufferIDs + this->builtBufferCount);
+            for (UInt32 i = this->builtBufferCount; i < bufferCount; i++) {
+                glBindBuffer(GL_ARRAY_BUFFER, this->bufferIDs[i]);
+                glBufferData(GL_ARRAY_BUFFER, this->size, nullptr, GL_DYNAMIC_DRAW);
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            this->builtBufferCount = bufferCount;
         }
 
-        void destroyGPUBuffer() {
-            glDeleteBuffers(1, &this->bufferID);
+        void destroyGPUBuffers() {
+            glDeleteBuffers(this->builtBufferCount, this->bufferIDs);
         }
 
     };
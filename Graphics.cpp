@@ -44,6 +44,10 @@ namespace Core {
         }
     }
 
+    const CoreObjectReferenceManager& Graphics::getObjectManager() const {
+        return this->objectManager;
+    }
+
     WeakPointer<Texture2D> Graphics::getPlaceHolderTexture2D() {
         return this->placeHolderTexture2D;
     }
@@ -43,6 +43,7 @@ namespace Core {
         virtual void init();
 
         static void safeReleaseObject(WeakPointer<CoreObject> object);
+        const CoreObjectReferenceManager& getObjectManager() const;
 
         WeakPointer<Texture2D> getPlaceHolderTexture2D();
         WeakPointer<CubeTexture> getPlaceHolderCubeTexture();
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../geometry/AttributeArrayGPUStorage.h"
+#include "../common/types.h"
+#include "RecordingStats.h"
+
+namespace Core {
+
+    class AttributeArrayGPUStorageNull final: public AttributeArrayGPUStorage {
+    public:
+        AttributeArrayGPUStorageNull(UInt32 size, UInt32 bufferID, RecordingStats& stats):
+            size(size), bufferID(bufferID), stats(stats) {
+        }
+
+        ~AttributeArrayGPUStorageNull() override {
+        }
+
+        Int32 getBufferID() const override {
+            return this->bufferID;
+        }
+
+        void enableAndSendToActiveShader(UInt32 location) override {
+        }
+
+        void enableAndSendToActiveShader(UInt32 location, UInt32 componentCount, UInt32 byteStride, UInt32 byteOffset) override {
+        }
+
+        void disable(UInt32 location) override {
+        }
+
+        void updateBufferData(void * data) override {
+            this->stats.bufferUploads++;
+            this->stats.bufferBytesUploaded += this->size;
+            this->recordUpload(this->size);
+        }
+
+        void updateBufferRange(const void * data, UInt32 byteOffset, UInt32 byteCount) override {
+            if (byteOffset >= this->size) return;
+            if (byteCount > this->size - byteOffset) byteCount = this->size - byteOffset;
+            if (byteCount == 0) return;
+            this->stats.bufferUploads++;
+            this->stats.bufferBytesUploaded += byteCount;
+            this->recordUpload(byteCount);
+        }
+
+    private:
+        UInt32 size;
+        UInt32 bufferID;
+        RecordingStats& stats;
+    };
+}
@@ -0,0 +1,44 @@
+#include "CubeTextureNull.h"
+#include "../image/RawImage.h"
+
+namespace Core {
+
+    CubeTextureNull::CubeTextureNull(const TextureAttributes& attributes, UInt32 reservedTextureID, RecordingStats& stats):
+        CubeTexture(attributes), reservedTextureID(reservedTextureID), stats(stats) {
+
+    }
+
+    CubeTextureNull::~CubeTextureNull() {
+
+    }
+
+    void CubeTextureNull::buildFromImages(WeakPointer<StandardImage> front, WeakPointer<StandardImage> back,
+                                          WeakPointer<StandardImage> top, WeakPointer<StandardImage> bottom,
+                                          WeakPointer<StandardImage> left, WeakPointer<StandardImage> right) {
+        if (this->attributes.Format != TextureFormat::RGBA8) {
+            throw TextureException("CubeTextureNull::build() -> Textures built with StandardImage must have type RGBA8.");
+        }
+        this->setupTexture();
+    }
+
+    void CubeTextureNull::buildFromImages(WeakPointer<HDRImage> front, WeakPointer<HDRImage> back,
+                                          WeakPointer<HDRImage> top, WeakPointer<HDRImage> bottom,
+                                          WeakPointer<HDRImage> left, WeakPointer<HDRImage> right) {
+        if (this->attributes.Format != TextureFormat::RGBA16F && this->attributes.Format != TextureFormat::RGBA32F) {
+            throw TextureException("CubeTextureNull::build() -> Textures built with HDRImage must have type RGBA16F or RGBA32F.");
+        }
+        this->setupTexture();
+    }
+
+    void CubeTextureNull::buildEmpty(UInt32 width, UInt32 height) {
+        this->setupTexture();
+    }
+
+    void CubeTextureNull::updateMipMaps() {
+    }
+
+    void CubeTextureNull::setupTexture() {
+        this->textureId = this->reservedTextureID;
+        this->stats.textureBuilds++;
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../image/CubeTexture.h"
+#include "RecordingStats.h"
+
+namespace Core {
+
+    // forward declaration
+    class GraphicsNull;
+
+    class CubeTextureNull final : public CubeTexture {
+        friend class GraphicsNull;
+
+    public:
+        ~CubeTextureNull() override;
+        void buildFromImages(WeakPointer<StandardImage> frontData, WeakPointer<StandardImage> backData,
+                             WeakPointer<StandardImage> topData,WeakPointer<StandardImage> bottomData,
+                             WeakPointer<StandardImage> leftData, WeakPointer<StandardImage> rightData) override;
+        void buildFromImages(WeakPointer<HDRImage> frontData, WeakPointer<HDRImage> backData,
+                             WeakPointer<HDRImage> topData,WeakPointer<HDRImage> bottomData,
+                             WeakPointer<HDRImage> leftData, WeakPointer<HDRImage> rightData) override;
+        void buildEmpty(UInt32 width, UInt32 height) override;
+        void updateMipMaps() override;
+
+    private:
+        CubeTextureNull(const TextureAttributes& attributes, UInt32 reservedTextureID, RecordingStats& stats);
+        void setupTexture();
+
+        UInt32 reservedTextureID;
+        RecordingStats& stats;
+    };
+}
@@ -0,0 +1,328 @@
+#include "../common/Exception.h"
+#include "GraphicsNull.h"
+#include "AttributeArrayGPUStorageNull.h"
+#include "CubeTextureNull.h"
+#include "IndexBufferNull.h"
+#include "RendererNull.h"
+#include "ShaderNull.h"
+#include "Texture2DNull.h"
+#include "RenderTarget2DNull.h"
+#include "RenderTargetCubeNull.h"
+
+namespace Core {
+
+    GraphicsNull::GraphicsNull(): lastResourceID(0) {
+    }
+
+    GraphicsNull::~GraphicsNull() {
+    }
+
+    void GraphicsNull::init() {
+        Graphics::init();
+
+        this->defaultRenderTarget = this->createDefaultRenderTarget();
+        this->currentRenderTarget = this->defaultRenderTarget;
+        this->shaderDirectory.init();
+
+        this->renderer = this->createRenderer();
+    }
+
+    WeakPointer<Renderer> GraphicsNull::getRenderer() {
+        return std::static_pointer_cast<Renderer>(this->renderer);
+    }
+
+    void GraphicsNull::preRender() {
+    }
+
+    void GraphicsNull::postRender() {
+    }
+
+    WeakPointer<Texture2D> GraphicsNull::createTexture2D(const TextureAttributes& attributes) {
+        Texture2DNull* newTexturePtr = new(std::nothrow) Texture2DNull(attributes, this->nextResourceID(), this->stats);
+        if (newTexturePtr == nullptr) {
+            throw AllocationException("GraphicsNull::createTexture2D -> Unable to allocate new Texture2DNull");
+        }
+        std::shared_ptr<Texture2DNull> newTexture = std::shared_ptr<Texture2DNull>(newTexturePtr);
+        this->addCoreObjectReference(newTexture, CoreObjectReferenceManager::OwnerType::Single);
+        this->stats.texturesCreated++;
+        return std::static_pointer_cast<Texture2D>(newTexture);
+    }
+
+    WeakPointer<CubeTexture> GraphicsNull::createCubeTexture(const TextureAttributes& attributes) {
+        CubeTextureNull* newTexturePtr = new(std::nothrow) CubeTextureNull(attributes, this->nextResourceID(), this->stats);
+        if (newTexturePtr == nullptr) {
+            throw AllocationException("GraphicsNull::createCubeTexture -> Unable to allocate new CubeTextureNull");
+        }
+        std::shared_ptr<CubeTextureNull> newTexture = std::shared_ptr<CubeTextureNull>(newTexturePtr);
+        this->addCoreObjectReference(newTexture, CoreObjectReferenceManager::OwnerType::Single);
+        this->stats.texturesCreated++;
+        return std::static_pointer_cast<CubeTexture>(newTexture);
+    }
+
+    WeakPointer<Shader> GraphicsNull::createShader(const std::string& vertex, const std::string& fragment) {
+        ShaderNull* shaderPtr = new(std::nothrow) ShaderNull(this->nextResourceID(), vertex, fragment);
+        return this->addShader(shaderPtr);
+    }
+
+    WeakPointer<Shader> GraphicsNull::createShader(const std::string& vertex, const std::string& geometry, const std::string& fragment) {
+        ShaderNull* shaderPtr = new(std::nothrow) ShaderNull(this->nextResourceID(), vertex, geometry, fragment);
+        return this->addShader(shaderPtr);
+    }
+
+    WeakPointer<Shader> GraphicsNull::createShader(const char vertex[], const char fragment[]) {
+        return this->createShader(std::string(vertex), std::string(fragment));
+    }
+
+    WeakPointer<Shader> GraphicsNull::createShader(const char vertex[], const char geometry[], const char fragment[]) {
+        return this->createShader(std::string(vertex), std::string(geometry), std::string(fragment));
+    }
+
+    WeakPointer<Shader> GraphicsNull::addShader(ShaderNull* shaderPtr) {
+        if (shaderPtr == nullptr) {
+            throw AllocationException("GraphicsNull::addShader -> Could not allocate new shader.");
+        }
+        std::shared_ptr<ShaderNull> spShaderNull(shaderPtr);
+        this->addCoreObjectReference(spShaderNull, CoreObjectReferenceManager::OwnerType::Single);
+        this->stats.shadersCreated++;
+        std::shared_ptr<Shader> spShader = std::static_pointer_cast<Shader>(spShaderNull);
+        return spShader;
+    }
+
+    void GraphicsNull::activateShader(WeakPointer<Shader> shader) {
+        UInt64 newShaderID = shader->getObjectID();
+        Bool newShader = lastActivatedShaderID != newShaderID;
+        Bool shouldActivate = newShader || !hasAnyShaderBeenActivated;
+        Graphics::activateShader(shader);
+        if (shouldActivate) {
+            this->stats.shaderActivations++;
+        }
+    }
+
+    std::shared_ptr<AttributeArrayGPUStorage> GraphicsNull::createGPUStorage(UInt32 size, UInt32 componentCount, AttributeType type, Bool normalize) {
+        AttributeArrayGPUStorageNull* gpuStoragePtr = new (std::nothrow) AttributeArrayGPUStorageNull(size, this->nextResourceID(), this->stats);
+        if (gpuStoragePtr == nullptr) {
+            throw AllocationException("GraphicsNull::createGPUStorage() -> Unable to allocate gpu buffer.");
+        }
+        this->stats.buffersCreated++;
+        std::shared_ptr<AttributeArrayGPUStorageNull> spGpuStorage(gpuStoragePtr);
+        return spGpuStorage;
+    }
+
+    std::shared_ptr<IndexBuffer> GraphicsNull::createIndexBuffer(UInt32 size) {
+        IndexBufferNull* indexBufferPtr = new (std::nothrow) IndexBufferNull(size, this->nextResourceID(), this->stats);
+        if (indexBufferPtr == nullptr) {
+            throw AllocationException("GraphicsNull::createIndexBuffer() -> Unable to allocate index buffer.");
+        }
+        indexBufferPtr->initIndices();
+        this->stats.buffersCreated++;
+        std::shared_ptr<IndexBufferNull> spIndexBuffer(indexBufferPtr);
+        return spIndexBuffer;
+    }
+
+    void GraphicsNull::drawBoundVertexBuffer(UInt32 vertexCount, PrimitiveType primitiveType) {
+        this->stats.drawCalls++;
+        this->stats.verticesDrawn += vertexCount;
+    }
+
+    void GraphicsNull::drawBoundVertexBuffer(UInt32 vertexCount, WeakPointer<IndexBuffer> indices, PrimitiveType primitiveType) {
+        this->stats.drawCalls++;
+        this->stats.indexedDrawCalls++;
+        this->stats.verticesDrawn += vertexCount;
+    }
+
+    ShaderManager& GraphicsNull::getShaderManager() {
+        return this->shaderDirectory;
+    }
+
+    void GraphicsNull::setBlendingEnabled(Bool enabled) {
+    }
+
+    void GraphicsNull::setBlendingEquation(RenderState::BlendingEquation equation) {
+    }
+
+    void GraphicsNull::setBlendingFactors(RenderState::BlendingFactor source, RenderState::BlendingFactor dest) {
+    }
+
+    void GraphicsNull::setBlendingFactors(RenderState::BlendingFactor source, RenderState::BlendingFactor sourceAlpha,
+                                          RenderState::BlendingFactor dest, RenderState::BlendingFactor destAlpha) {
+    }
+
+    WeakPointer<RenderTarget2D> GraphicsNull::createRenderTarget2D(Bool hasColor, Bool hasDepth, Bool enableStencilBuffer,
+                                                                   const TextureAttributes& colorTextureAttributes,
+                                                                   const TextureAttributes& depthTextureAttributes,
+                                                                   const Vector2u& size) {
+
+        RenderTarget2DNull* renderTargetPtr = new(std::nothrow) RenderTarget2DNull(hasColor, hasDepth, enableStencilBuffer,
+                                                                                   colorTextureAttributes, depthTextureAttributes, size);
+        if (renderTargetPtr == nullptr) {
+            throw AllocationException("GraphicsNull::createRenderTarget2D -> Unable to allocate render target.");
+        }
+        std::shared_ptr<RenderTarget2DNull> target(renderTargetPtr);
+        target->init();
+        this->addCoreObjectReference(target, CoreObjectReferenceManager::OwnerType::Single);
+        this->stats.renderTargetsCreated++;
+
+        WeakPointer<RenderTarget2DNull> weakPtr = target;
+        return weakPtr;
+    }
+
+    WeakPointer<RenderTargetCube> GraphicsNull::createRenderTargetCube(Bool hasColor, Bool hasDepth, Bool enableStencilBuffer,
+                                                                       const TextureAttributes& colorTextureAttributes,
+                                                                       const TextureAttributes& depthTextureAttributes, const Vector2u& size) {
+
+        RenderTargetCubeNull* renderTargetPtr = new(std::nothrow) RenderTargetCubeNull(hasColor, hasDepth, enableStencilBuffer,
+                                                                                       colorTextureAttributes, depthTextureAttributes, size);
+        if (renderTargetPtr == nullptr) {
+            throw AllocationException("GraphicsNull::createRenderTargetCube -> Unable to allocate render target.");
+        }
+        std::shared_ptr<RenderTargetCubeNull> target(renderTargetPtr);
+        target->init();
+        this->addCoreObjectReference(target, CoreObjectReferenceManager::OwnerType::Single);
+        this->stats.renderTargetsCreated++;
+
+        WeakPointer<RenderTargetCubeNull> weakPtr = target;
+        return weakPtr;
+    }
+
+    void GraphicsNull::setColorWriteEnabled(Bool enabled) {
+    }
+
+    void GraphicsNull::setClearColor(Color color) {
+    }
+
+    void GraphicsNull::clearActiveRenderTarget(Bool colorBuffer, Bool depthBuffer, Bool stencilBuffer) {
+        this->stats.clears++;
+    }
+
+    void GraphicsNull::setDefaultRenderTargetToCurrent() {
+    }
+
+    WeakPointer<RenderTarget> GraphicsNull::getDefaultRenderTarget() {
+        return this->defaultRenderTarget;
+    }
+
+    WeakPointer<RenderTarget> GraphicsNull::getCurrentRenderTarget() {
+        return this->currentRenderTarget;
+    }
+
+    Bool GraphicsNull::activateRenderTarget(WeakPointer<RenderTarget> target) {
+        if (!target.isValid()) {
+            throw NullPointerException("GraphicsNull::activateRenderTarget -> 'target' is not valid.");
+        }
+
+        // prevent activating the currently active target.
+        if (this->currentRenderTarget.isValid() && this->currentRenderTarget.get() == target.get()) return true;
+
+        this->currentRenderTarget = target;
+        this->stats.renderTargetActivations++;
+        return true;
+    }
+
+    Bool GraphicsNull::activateRenderTarget2DMipLevel(UInt32 mipLevel) {
+        return this->currentRenderTarget.isValid();
+    }
+
+    Bool GraphicsNull::activateCubeRenderTargetSide(CubeTextureSide side, UInt32 mipLevel) {
+        return this->currentRenderTarget.isValid();
+    }
+
+    void GraphicsNull::updateDefaultRenderTargetSize(Vector2u size) {
+        this->defaultRenderTarget->size = size;
+    }
+
+    void GraphicsNull::updateDefaultRenderTargetViewport(Vector4u viewport) {
+        this->defaultRenderTarget->viewport = viewport;
+    }
+
+    Vector4u GraphicsNull::getViewport() {
+        return this->viewport;
+    }
+
+    void GraphicsNull::setViewport(UInt32 hOffset, UInt32 vOffset, UInt32 viewPortWidth, UInt32 viewPortHeight) {
+        this->viewport.set(hOffset, vOffset, viewPortWidth, viewPortHeight);
+    }
+
+    void GraphicsNull::setRenderStyle(RenderStyle style) {
+    }
+
+    void GraphicsNull::setDepthWriteEnabled(Bool enabled) {
+    }
+
+    void GraphicsNull::setDepthTestEnabled(Bool enabled) {
+    }
+
+    void GraphicsNull::setDepthFunction(RenderState::DepthFunction function) {
+    }
+
+    void GraphicsNull::setStencilTestEnabled(Bool enabled) {
+    }
+
+    void GraphicsNull::setStencilWriteMask(UInt32 mask) {
+    }
+
+    void GraphicsNull::setStencilFunction(RenderState::StencilFunction function, Int16 value, UInt16 mask) {
+    }
+
+    void GraphicsNull::setStencilOperation(RenderState::StencilAction sFail, RenderState::StencilAction dpFail, RenderState::StencilAction dpPass) {
+    }
+
+    void GraphicsNull::setFaceCullingEnabled(Bool enabled) {
+    }
+
+    void GraphicsNull::setCullFace(RenderState::CullFace face) {
+    }
+
+    void GraphicsNull::setRenderLineSize(Real size) {
+    }
+
+    void GraphicsNull::saveState() {
+    }
+
+    void GraphicsNull::restoreState() {
+    }
+
+    void GraphicsNull::lowLevelBlit(WeakPointer<RenderTarget> source, WeakPointer<RenderTarget> destination, Int16 cubeFace, Bool includeColor, Bool includeDepth) {
+        this->stats.blits++;
+    }
+
+    const RecordingStats& GraphicsNull::getStats() const {
+        return this->stats;
+    }
+
+    void GraphicsNull::resetStats() {
+        this->stats.reset();
+    }
+
+    std::shared_ptr<RendererNull> GraphicsNull::createRenderer() {
+        RendererNull* renderPtr = new(std::nothrow) RendererNull();
+        if (renderPtr == nullptr) {
+            throw AllocationException("GraphicsNull::createRenderer -> Unable to allocate renderer.");
+        }
+        std::shared_ptr<RendererNull> renderer(renderPtr);
+        renderer->init();
+        return renderer;
+    }
+
+    std::shared_ptr<RenderTarget2DNull> GraphicsNull::createDefaultRenderTarget() {
+        TextureAttributes colorAttributes;
+        TextureAttributes depthAttributes;
+        Vector2u renderSize(1024, 1024);
+        RenderTarget2DNull* defaultTargetPtr = new(std::nothrow) RenderTarget2DNull(false, false, false, colorAttributes,
+                                                                                    depthAttributes, renderSize);
+        if (defaultTargetPtr == nullptr) {
+            throw AllocationException("GraphicsNull::createDefaultRenderTarget -> Unable to allocate default render target.");
+        }
+        std::shared_ptr<RenderTarget2DNull> defaultTarget(defaultTargetPtr);
+        this->addCoreObjectReference(defaultTarget, CoreObjectReferenceManager::OwnerType::Single);
+        defaultTarget->setHDRIncapableOverride(true);
+        return defaultTarget;
+    }
+
+    /*
+     * IDs handed out for textures, shaders and buffers. They are never zero, so textures report themselves
+     * as built and programs as valid exactly as their OpenGL counterparts would.
+     */
+    UInt32 GraphicsNull::nextResourceID() {
+        return ++this->lastResourceID;
+    }
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <memory>
+
+#include "../util/PersistentWeakPointer.h"
+#include "../base/CoreObjectReferenceManager.h"
+#include "../Graphics.h"
+#include "../geometry/AttributeType.h"
+#include "../GL/ShaderManagerGL.h"
+#include "RecordingStats.h"
+
+namespace Core {
+
+    // forward declarations
+    class Engine;
+    class RendererNull;
+    class ShaderNull;
+    class RenderTarget2DNull;
+
+    /*
+     * Headless implementation of Graphics. Resources are created and tracked as usual but no GPU work is
+     * performed; draw calls, state changes and uploads are only counted in RecordingStats. This lets the
+     * CPU side of Engine::update() and Engine::render() run (and be measured) without a graphics context.
+     */
+    class GraphicsNull final : public Graphics {
+        friend class Engine;
+
+    public:
+        ~GraphicsNull() override;
+        void init() override;
+        WeakPointer<Renderer> getRenderer() override;
+        void preRender() override;
+        void postRender() override;
+
+        void setViewport(UInt32 hOffset, UInt32 vOffset, UInt32 viewPortWidth, UInt32 viewPortHeight) override;
+        Vector4u getViewport() override;
+
+        WeakPointer<Texture2D> createTexture2D(const TextureAttributes& attributes) override;
+        WeakPointer<CubeTexture> createCubeTexture(const TextureAttributes& attributes) override;
+
+        WeakPointer<Shader> createShader(const std::string& vertex, const std::string& fragment) override;
+        WeakPointer<Shader> createShader(const std::string& vertex, const std::string& geometry, const std::string& fragment) override;
+        WeakPointer<Shader> createShader(const char vertex[], const char fragment[]) override;
+        WeakPointer<Shader> createShader(const char vertex[], const char geometry[], const char fragment[]) override;
+        void activateShader(WeakPointer<Shader> shader) override;
+
+        void drawBoundVertexBuffer(UInt32 vertexCount, PrimitiveType primitiveType = PrimitiveType::Triangles) override;
+        void drawBoundVertexBuffer(UInt32 vertexCount, WeakPointer<IndexBuffer> indices, PrimitiveType primitiveType = PrimitiveType::Triangles) override;
+
+        ShaderManager& getShaderManager() override;
+
+        void setBlendingEnabled(Bool enabled) override;
+        void setBlendingEquation(RenderState::BlendingEquation) override;
+        void setBlendingFactors(RenderState::BlendingFactor source, RenderState::BlendingFactor dest) override;
+        void setBlendingFactors(RenderState::BlendingFactor source, RenderState::BlendingFactor sourceAlpha,
+                                RenderState::BlendingFactor dest, RenderState::BlendingFactor destAlpha) override;
+
+        WeakPointer<RenderTarget2D> createRenderTarget2D(Bool hasColor, Bool hasDepth, Bool enableStencilBuffer,
+                                                         const TextureAttributes& colorTextureAttributes,
+                                                         const TextureAttributes& depthTextureAttributes, const Vector2u& size) override;
+        WeakPointer<RenderTargetCube> createRenderTargetCube(Bool hasColor, Bool hasDepth, Bool enableStencilBuffer,
+                                                             const TextureAttributes& colorTextureAttributes,
+                                                             const TextureAttributes& depthTextureAttributes, const Vector2u& size) override;
+
+        void setColorWriteEnabled(Bool enabled) override;
+        void setClearColor(Color color) override;
+        void clearActiveRenderTarget(Bool colorBuffer, Bool depthBuffer, Bool stencilBuffer) override;
+        void setDefaultRenderTargetToCurrent() override;
+        WeakPointer<RenderTarget> getDefaultRenderTarget() override;
+        WeakPointer<RenderTarget> getCurrentRenderTarget() override;
+        void updateDefaultRenderTargetSize(Vector2u size) override;
+        void updateDefaultRenderTargetViewport(Vector4u viewport) override;
+        Bool activateRenderTarget(WeakPointer<RenderTarget> target) override;
+        Bool activateRenderTarget2DMipLevel(UInt32 mipLevel) override;
+        Bool activateCubeRenderTargetSide(CubeTextureSide side, UInt32 mipLevel) override;
+        void setRenderStyle(RenderStyle style) override;
+
+        void setDepthWriteEnabled(Bool enabled) override;
+        void setDepthTestEnabled(Bool enabled) override;
+        void setDepthFunction(RenderState::DepthFunction function) override;
+
+        void setStencilTestEnabled(Bool enabled) override;
+        void setStencilWriteMask(UInt32 mask) override;
+        void setStencilFunction(RenderState::StencilFunction function, Int16 value, UInt16 mask) override;
+        void setStencilOperation(RenderState::StencilAction sFail, RenderState::StencilAction dpFail, RenderState::StencilAction dpPass) override;
+
+        void setFaceCullingEnabled(Bool enabled) override;
+        void setCullFace(RenderState::CullFace face) override;
+
+        void setRenderLineSize(Real size) override;
+
+        void saveState() override;
+        void restoreState() override;
+
+        void lowLevelBlit(WeakPointer<RenderTarget> source, WeakPointer<RenderTarget> destination, Int16 cubeFace, Bool includeColor, Bool includeDepth) override;
+
+        const RecordingStats& getStats() const;
+        void resetStats();
+
+    protected:
+
+        std::shared_ptr<AttributeArrayGPUStorage> createGPUStorage(UInt32 size, UInt32 componentCount, AttributeType type, Bool normalize) override;
+        std::shared_ptr<IndexBuffer> createIndexBuffer(UInt32 size) override;
+
+    private:
+        GraphicsNull();
+        std::shared_ptr<RendererNull> createRenderer();
+        std::shared_ptr<RenderTarget2DNull> createDefaultRenderTarget();
+        WeakPointer<Shader> addShader(ShaderNull* shaderPtr);
+        UInt32 nextResourceID();
+
+        std::shared_ptr<RendererNull> renderer;
+
+        PersistentWeakPointer<RenderTarget2DNull> defaultRenderTarget;
+        PersistentWeakPointer<RenderTarget> currentRenderTarget;
+        // shader sources are shared with the OpenGL backend so materials resolve them exactly as they would there
+        ShaderManagerGL shaderDirectory;
+
+        Vector4u viewport;
+        UInt32 lastResourceID;
+        RecordingStats stats;
+    };
+}
@@ -0,0 +1,26 @@
+#include "IndexBufferNull.h"
+
+namespace Core {
+
+    IndexBufferNull::IndexBufferNull(UInt32 size, UInt32 bufferID, RecordingStats& stats): IndexBuffer(size), bufferID(bufferID), stats(stats) {
+
+    }
+
+    IndexBufferNull::~IndexBufferNull() {
+
+    }
+
+    Int32 IndexBufferNull::getBufferID() const {
+        return this->bufferID;
+    }
+
+    void IndexBufferNull::initIndices() {
+    }
+
+    void IndexBufferNull::setIndices(UInt32* indices) {
+        IndexBuffer::setIndices(indices);
+        this->stats.bufferUploads++;
+        this->stats.bufferBytesUploaded += this->size * sizeof(UInt32);
+    }
+
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "../geometry/IndexBuffer.h"
+#include "RecordingStats.h"
+
+namespace Core {
+
+    class IndexBufferNull final: public IndexBuffer {
+    public:
+        IndexBufferNull(UInt32 size, UInt32 bufferID, RecordingStats& stats);
+        ~IndexBufferNull() override;
+        Int32 getBufferID() const override;
+        void setIndices(UInt32 * indices) override;
+        void initIndices() override;
+
+    private:
+        UInt32 bufferID;
+        RecordingStats& stats;
+    };
+
+}
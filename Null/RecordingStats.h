@@ -0,0 +1,31 @@
+#pragma once
+
+#include "../common/types.h"
+
+namespace Core {
+
+    /*
+     * Counters kept by the headless GraphicsNull backend in place of the GPU work it skips.
+     */
+    class RecordingStats {
+    public:
+        UInt64 drawCalls = 0;
+        UInt64 indexedDrawCalls = 0;
+        UInt64 verticesDrawn = 0;
+        UInt64 shaderActivations = 0;
+        UInt64 renderTargetActivations = 0;
+        UInt64 clears = 0;
+        UInt64 blits = 0;
+        UInt64 texturesCreated = 0;
+        UInt64 textureBuilds = 0;
+        UInt64 shadersCreated = 0;
+        UInt64 renderTargetsCreated = 0;
+        UInt64 buffersCreated = 0;
+        UInt64 bufferUploads = 0;
+        UInt64 bufferBytesUploaded = 0;
+
+        void reset() {
+            *this = RecordingStats();
+        }
+    };
+}
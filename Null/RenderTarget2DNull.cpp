@@ -0,0 +1,79 @@
+#include "../Engine.h"
+#include "../Graphics.h"
+#include "../image/Texture2D.h"
+#include "../image/CubeTexture.h"
+#include "RenderTarget2DNull.h"
+
+namespace Core {
+
+    RenderTarget2DNull::RenderTarget2DNull(Bool hasColor, Bool hasDepth, Bool enableStencilBuffer,
+                                           const TextureAttributes& colorTextureAttributes,
+                                           const TextureAttributes& depthTextureAttributes, Vector2u size) :
+        RenderTarget2D(hasColor, hasDepth, enableStencilBuffer, colorTextureAttributes, depthTextureAttributes, size) {
+
+    }
+
+    RenderTarget2DNull::~RenderTarget2DNull() {
+        for (UInt32 i = 0; i < this->activeColorTextures; i++) {
+            this->destroyColorBuffer(i);
+        }
+        this->destroyDepthBuffer();
+    }
+
+    /*
+     * Create the same texture attachments the OpenGL implementation would, without a framebuffer behind them.
+     */
+    Bool RenderTarget2DNull::init() {
+        if (this->hasColorBuffer) {
+            this->initColorTexture(0);
+        }
+
+        if (this->hasDepthBuffer && !this->enableStencilBuffer) {
+            this->depthTexture = Engine::instance()->createTexture2D(this->depthTextureAttributes);
+            this->buildAndVerifyTexture(this->depthTexture);
+        }
+
+        return true;
+    }
+
+    Bool RenderTarget2DNull::addColorTexture(TextureAttributes attributes) {
+        if (this->activeColorTextures < RenderTarget::MaxRenderTargetOutputTargets - 1) {
+            this->colorTextureAttributes[this->activeColorTextures] = attributes;
+            this->mipLevel[this->activeColorTextures] = 0;
+            this->colorBufferIsTexture[this->activeColorTextures] = true;
+            this->initColorTexture(this->activeColorTextures);
+            this->activeColorTextures++;
+        }
+        return true;
+    }
+
+    Bool RenderTarget2DNull::initColorTexture(UInt32 index) {
+        this->colorTexture[index] = Engine::instance()->createTexture2D(this->colorTextureAttributes[index]);
+        this->buildAndVerifyTexture(this->colorTexture[index]);
+        return true;
+    }
+
+    void RenderTarget2DNull::destroyColorBuffer(UInt32 index) {
+        if (index > this->activeColorTextures) {
+            throw OutOfRangeException("RenderTarget2DNull::destroyColorBuffer -> Output color target index is out of range.");
+        }
+        if (this->hasColorBuffer) {
+            if (this->colorTexture[index]) {
+                WeakPointer<Texture2D> texture = WeakPointer<Texture>::dynamicPointerCast<Texture2D>(this->colorTexture[index]);
+                Graphics::safeReleaseObject(texture);
+                this->colorTexture[index] = WeakPointer<Texture>::nullPtr();
+            }
+        }
+    }
+
+    void RenderTarget2DNull::destroyDepthBuffer() {
+        if (this->hasDepthBuffer && !this->enableStencilBuffer) {
+            if (this->depthTexture) {
+                WeakPointer<Texture2D> texture = WeakPointer<Texture>::dynamicPointerCast<Texture2D>(this->depthTexture);
+                Graphics::safeReleaseObject(texture);
+                this->depthTexture = WeakPointer<Texture>::nullPtr();
+            }
+        }
+    }
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "../render/RenderTarget2D.h"
+
+namespace Core {
+
+    // forward declarations
+    class GraphicsNull;
+
+    class RenderTarget2DNull final : public RenderTarget2D {
+        friend class GraphicsNull;
+    public:
+        ~RenderTarget2DNull() override;
+        Bool init() override;
+        Bool addColorTexture(TextureAttributes attributes) override;
+        void destroyColorBuffer(UInt32 index = 0) override;
+        void destroyDepthBuffer() override;
+
+    protected:
+        RenderTarget2DNull(Bool hasColor, Bool hasDepth, Bool enableStencilBuffer,
+                           const TextureAttributes& colorTextureAttributes,
+                           const TextureAttributes& depthTextureAttributes, Vector2u size);
+        Bool initColorTexture(UInt32 index);
+    };
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "../render/RenderTargetCube.h"
+
+namespace Core {
+
+    // forward declarations
+    class GraphicsNull;
+
+    class RenderTargetCubeNull final : public RenderTargetCube {
+        friend class GraphicsNull;
+    public:
+        ~RenderTargetCubeNull() override;
+        Bool init() override;
+        Bool addColorTexture(TextureAttributes attributes) override;
+        void destroyColorBuffer(UInt32 index = 0) override;
+        void destroyDepthBuffer() override;
+
+    protected:
+        RenderTargetCubeNull(Bool hasColor, Bool hasDepth, Bool enableStencilBuffer,
+                             const TextureAttributes& colorTextureAttributes,
+                             const TextureAttributes& depthTextureAttributes, Vector2u size);
+        Bool initColorTexture(UInt32 index);
+    };
+}
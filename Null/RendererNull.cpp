@@ -0,0 +1,16 @@
+#include "RendererNull.h"
+
+namespace Core {
+
+    RendererNull::RendererNull() {
+    }
+
+    Bool RendererNull::init() {
+        Renderer::init();
+        return true;
+    }
+
+    RendererNull::~RendererNull() {
+    }
+
+}
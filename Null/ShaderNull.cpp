@@ -0,0 +1,143 @@
+#include "ShaderNull.h"
+
+namespace Core {
+
+    ShaderNull::ShaderNull(UInt32 program, const std::string &vertex, const std::string &fragment) :
+        Shader(vertex, fragment), program(program) {
+    }
+
+    ShaderNull::ShaderNull(UInt32 program, const std::string &vertex, const std::string &geometry, const std::string &fragment) :
+        Shader(vertex, geometry, fragment), program(program) {
+    }
+
+    ShaderNull::~ShaderNull() {
+    }
+
+    Bool ShaderNull::build() {
+        UInt32 program;
+        if (this->hasGeometryShader) {
+            program = this->createProgram(this->vertexSource, this->geometrySource, this->fragmentSource);
+        }
+        else {
+            program = this->createProgram(this->vertexSource, this->fragmentSource);
+        }
+        return program ? true : false;
+    }
+
+    UInt32 ShaderNull::getProgram() const {
+        return this->program;
+    }
+
+    Int32 ShaderNull::getUniformLocation(const std::string &var) const {
+        return this->getLocation(this->uniformLocations, var);
+    }
+
+    Int32 ShaderNull::getUniformLocation(const std::string &var, UInt32 index) const {
+        return this->getUniformLocation(var + "[" + std::to_string(index) + "]");
+    }
+
+    Int32 ShaderNull::getAttributeLocation(const std::string &var) const {
+        return this->getLocation(this->attributeLocations, var);
+    }
+
+    Int32 ShaderNull::getAttributeLocation(const std::string &var, UInt32 index) const {
+        return this->getAttributeLocation(var + "[" + std::to_string(index) + "]");
+    }
+
+    Int32 ShaderNull::getUniformLocation(const char var[]) const {
+        return this->getUniformLocation(std::string(var));
+    }
+
+    Int32 ShaderNull::getUniformLocation(const char var[], UInt32 index) const {
+        return this->getUniformLocation(std::string(var), index);
+    }
+
+    Int32 ShaderNull::getAttributeLocation(const char var[]) const {
+        return this->getAttributeLocation(std::string(var));
+    }
+
+    Int32 ShaderNull::getAttributeLocation(const char var[], UInt32 index) const {
+        return this->getAttributeLocation(std::string(var), index);
+    }
+
+    Int32 ShaderNull::getUniformLocation(StandardUniform uniform) const {
+        return this->getUniformLocation(StandardUniforms::getUniformName(uniform));
+    }
+
+    Int32 ShaderNull::getUniformLocation(StandardUniform uniform, UInt32 index) const {
+        return this->getUniformLocation(StandardUniforms::getUniformName(uniform), index);
+    }
+
+    Int32 ShaderNull::getAttributeLocation(StandardAttribute attribute) const {
+        return this->getAttributeLocation(StandardAttributes::getAttributeName(attribute));
+    }
+
+    Int32 ShaderNull::getAttributeLocation(StandardAttribute attribute, UInt32 index) const {
+        return this->getAttributeLocation(StandardAttributes::getAttributeName(attribute), index);
+    }
+
+    void ShaderNull::setTexture2D(UInt32 slot, UInt32 textureID) {
+        if (slot >= 31) {
+            throw Shader::ShaderVariableException("ShaderNull::setTexture2D() value for [slot] is too high.");
+        }
+    }
+
+    void ShaderNull::setTexture2D(UInt32 samplerSlot, UInt32 uniformLocation, UInt32 textureID) {
+        this->setTexture2D(samplerSlot, textureID);
+        this->setUniform1i(uniformLocation, samplerSlot);
+    }
+
+    void ShaderNull::setTextureCube(UInt32 slot, UInt32 textureID) {
+        if (slot >= 31) {
+            throw Shader::ShaderVariableException("ShaderNull::setTextureCube() value for [slot] is too high.");
+        }
+    }
+
+    void ShaderNull::setTextureCube(UInt32 samplerSlot, UInt32 uniformLocation, UInt32 textureID) {
+        this->setTextureCube(samplerSlot, textureID);
+        this->setUniform1i(uniformLocation, samplerSlot);
+    }
+
+    void ShaderNull::setUniform1i(UInt32 location, Int32 val) {
+    }
+
+    void ShaderNull::setUniform1f(UInt32 location, Real val) {
+    }
+
+    void ShaderNull::setUniform2f(UInt32 location, Real x, Real y) {
+    }
+
+    void ShaderNull::setUniform3f(UInt32 location, Real x, Real y, Real z) {
+    }
+
+    void ShaderNull::setUniform4f(UInt32 location, Real x, Real y, Real z, Real w) {
+    }
+
+    void ShaderNull::setUniformMatrix4(UInt32 location, const Real* data) {
+    }
+
+    void ShaderNull::setUniformMatrix4(UInt32 location, const Matrix4x4& data) {
+    }
+
+    UInt32 ShaderNull::createShader(ShaderType shaderType, const std::string& src) {
+        return this->program;
+    }
+
+    UInt32 ShaderNull::createProgram(const std::string& vertex, const std::string& fragment) {
+        this->ready = true;
+        return this->program;
+    }
+
+    UInt32 ShaderNull::createProgram(const std::string& vertex, const std::string& geometry, const std::string& fragment) {
+        this->ready = true;
+        return this->program;
+    }
+
+    Int32 ShaderNull::getLocation(std::unordered_map<std::string, Int32>& locations, const std::string& var) const {
+        auto result = locations.find(var);
+        if (result != locations.end()) return result->second;
+        Int32 location = (Int32)locations.size();
+        locations[var] = location;
+        return location;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "../common/types.h"
+#include "../material/Shader.h"
+
+namespace Core {
+
+    // forward declarations
+    class GraphicsNull;
+
+    /*
+     * Shader that is never compiled. Every uniform or attribute name that is queried is handed a stable location
+     * of its own, so material code that only sets variables it can locate runs the same path it would on a GPU.
+     */
+    class ShaderNull final : public Shader {
+        friend class GraphicsNull;
+
+    public:
+        ~ShaderNull() override;
+
+        Bool build() override;
+        UInt32 getProgram() const override;
+        Int32 getUniformLocation(const std::string& var) const override;
+        Int32 getUniformLocation(const std::string& var, UInt32 index) const override;
+        Int32 getAttributeLocation(const std::string& var) const override;
+        Int32 getAttributeLocation(const std::string& var, UInt32 index) const override;
+        Int32 getUniformLocation(const char var[]) const override;
+        Int32 getUniformLocation(const char var[], UInt32 index) const override;
+        Int32 getAttributeLocation(const char var[]) const override;
+        Int32 getAttributeLocation(const char var[], UInt32 index) const override;
+        Int32 getUniformLocation(StandardUniform uniform) const override;
+        Int32 getUniformLocation(StandardUniform uniform, UInt32 index) const override;
+        Int32 getAttributeLocation(StandardAttribute attribute) const override;
+        Int32 getAttributeLocation(StandardAttribute attribute, UInt32 index) const override;
+
+        void setTexture2D(UInt32 samplerSlot, UInt32 textureID) override;
+        void setTexture2D(UInt32 samplerSlot, UInt32 uniformLocation, UInt32 textureID) override;
+        void setTextureCube(UInt32 samplerSlot, UInt32 textureID) override;
+        void setTextureCube(UInt32 samplerSlot, UInt32 uniformLocation, UInt32 textureID) override;
+        void setUniform1i(UInt32 location, Int32 val) override;
+        void setUniform1f(UInt32 location, Real val) override;
+        void setUniform2f(UInt32 location, Real x, Real y) override;
+        void setUniform3f(UInt32 location, Real x, Real y, Real z) override;
+        void setUniform4f(UInt32 location, Real x, Real y, Real z, Real w) override;
+        void setUniformMatrix4(UInt32 location, const Real* data) override;
+        void setUniformMatrix4(UInt32 location, const Matrix4x4& data) override;
+
+    protected:
+        ShaderNull(UInt32 program, const std::string& vertex, const std::string& fragment);
+        ShaderNull(UInt32 program, const std::string& vertex, const std::string& geometry, const std::string& fragment);
+
+        UInt32 createShader(ShaderType shaderType, const std::string& src) override;
+        UInt32 createProgram(const std::string& vertex, const std::string& fragment) override;
+        UInt32 createProgram(const std::string& vertex, const std::string& geometry, const std::string& fragment) override;
+        Int32 getLocation(std::unordered_map<std::string, Int32>& locations, const std::string& var) const;
+
+        UInt32 program;
+        mutable std::unordered_map<std::string, Int32> uniformLocations;
+        mutable std::unordered_map<std::string, Int32> attributeLocations;
+    };
+}
@@ -0,0 +1,54 @@
+#include "Texture2DNull.h"
+#include "../image/RawImage.h"
+
+namespace Core {
+
+    Texture2DNull::Texture2DNull(const TextureAttributes& attributes, UInt32 reservedTextureID, RecordingStats& stats):
+        Texture2D(attributes), reservedTextureID(reservedTextureID), stats(stats) {
+
+    }
+
+    Texture2DNull::~Texture2DNull() {
+    }
+
+    void Texture2DNull::buildFromImage(WeakPointer<StandardImage> imageData) {
+        this->buildFromImage(imageData, imageData->getWidth(), imageData->getHeight());
+    }
+
+    void Texture2DNull::buildFromImage(WeakPointer<StandardImage> imageData, UInt32 resizeWidth, UInt32 resizeHeight) {
+        if (this->attributes.Format != TextureFormat::RGBA8) {
+            throw TextureException("Texture2DNull::build() -> Textures built with StandardImage must have type RGBA8.");
+        }
+        this->setupTexture();
+    }
+
+    void Texture2DNull::buildFromImage(WeakPointer<HDRImage> imageData) {
+        this->buildFromImage(imageData, imageData->getWidth(), imageData->getHeight());
+    }
+
+    void Texture2DNull::buildFromImage(WeakPointer<HDRImage> imageData, UInt32 resizeWidth, UInt32 resizeHeight) {
+        if (this->attributes.Format != TextureFormat::RGBA16F && this->attributes.Format != TextureFormat::RGBA32F) {
+            throw TextureException("Texture2DNull::build() -> Textures built with HDRImage must have type RGBA16F or RGBA32F.");
+        }
+        this->setupTexture();
+    }
+
+    void Texture2DNull::buildFromData(Byte* data, UInt32 width, UInt32 height) {
+        this->setupTexture();
+    }
+
+    void Texture2DNull::buildEmpty(UInt32 width, UInt32 height) {
+        this->setupTexture();
+    }
+
+    void Texture2DNull::updateMipMaps() {
+    }
+
+    /*
+     * No storage is allocated; the texture simply takes on its reserved ID so that isBuilt() reports true.
+     */
+    void Texture2DNull::setupTexture() {
+        this->textureId = this->reservedTextureID;
+        this->stats.textureBuilds++;
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../image/Texture2D.h"
+#include "RecordingStats.h"
+
+namespace Core {
+
+    // forward declaration
+    class GraphicsNull;
+
+    class Texture2DNull final : public Texture2D {
+        friend class GraphicsNull;
+
+    public:
+        ~Texture2DNull() override;
+
+        void buildFromImage(WeakPointer<StandardImage> imageData) override;
+        void buildFromImage(WeakPointer<StandardImage> imageData, UInt32 resizeWidth, UInt32 resizeHeight) override;
+        void buildFromImage(WeakPointer<HDRImage> imageData) override;
+        void buildFromImage(WeakPointer<HDRImage> imageData, UInt32 resizeWidth, UInt32 resizeHeight) override;
+        void buildFromData(Byte* data, UInt32 width, UInt32 height) override;
+        void buildEmpty(UInt32 width, UInt32 height) override;
+        void updateMipMaps() override;
+
+    protected:
+        Texture2DNull(const TextureAttributes& attributes, UInt32 reservedTextureID, RecordingStats& stats);
+        void setupTexture();
+
+        UInt32 reservedTextureID;
+        RecordingStats& stats;
+    };
+}
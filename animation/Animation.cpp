@@ -170,4 +170,14 @@ namespace Core {
 	Real Animation::getEarlyEnd() const {
 		return earlyEndTicks / ticksPerSecond;
 	}
+
+	/*
+	 * Build the key frame lookup data (see KeyFrameSet::updateKeyFrameTimes()) for every key frame set
+	 * that doesn't have it yet.
+	 */
+	void Animation::updateKeyFrameTimes() {
+		for (UInt32 i = 0; i < channelCount; i++) {
+			if (!keyFrames[i].keyFrameTimesUpToDate()) keyFrames[i].updateKeyFrameTimes();
+		}
+	}
 }
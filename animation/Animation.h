@@ -47,6 +47,7 @@ namespace Core {
 		Real getDuration() const;
 		Real getStartOffset() const;
 		Real getEarlyEnd() const;
+		void updateKeyFrameTimes();
 
 	private:
 
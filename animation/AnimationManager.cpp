@@ -14,6 +14,7 @@
 #include "Skeleton.h"
 #include "Bone.h"
 #include "../util/Time.h"
+#include "../util/WorkerPool.h"
 
 namespace Core {
 
@@ -75,15 +76,28 @@ namespace Core {
 	}
 
 	/*
-	 * Loop through each active AnimationPlayer and drive its playback.
+	 * Loop through each active AnimationPlayer and drive its playback. Blending operations are advanced
+	 * serially, then each player (one per skeleton) evaluates its pose on the engine's worker pool, and finally the
+	 * poses are committed to the skeletons' node transforms on the calling thread.
 	 */
 	void AnimationManager::update() {
+		this->updatingPlayers.clear();
 		for (std::unordered_map<UInt64, std::shared_ptr<AnimationPlayer>>::iterator iter = this->activePlayers.begin(); iter != activePlayers.end(); ++iter) {
 			WeakPointer<AnimationPlayer> player = iter->second;
 			if (player.isValid()) {
-				player->update();
+				player->beginUpdate();
+				this->updatingPlayers.push_back(player.get());
 			}
 		}
+
+		WeakPointer<WorkerPool> workerPool = Engine::instance()->getWorkerPool();
+		workerPool->execute((UInt32)this->updatingPlayers.size(), [this](UInt32 playerIndex) {
+			this->updatingPlayers[playerIndex]->evaluate();
+		});
+
+		for (AnimationPlayer * player : this->updatingPlayers) {
+			player->commitPose();
+		}
 	}
 
 	WeakPointer<Animation> AnimationManager::createAnimation(Real durationTicks, Real ticksPerSecond) {
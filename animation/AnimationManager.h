@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
 #include <unordered_map>
 
 #include "../Engine.h"
@@ -48,5 +50,7 @@ namespace Core {
 		// map object IDs of Skeleton objects to their assign animation player
 		std::unordered_map<UInt64, std::shared_ptr<AnimationPlayer>> activePlayers;
 		std::vector<std::shared_ptr<AnimationInstance>> instances;
+		// players being updated during the current call to update()
+		std::vector<AnimationPlayer *> updatingPlayers;
 	};
 }
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "../Engine.h"
 #include "AnimationPlayer.h"
 #include "Bone.h"
@@ -121,159 +123,137 @@ namespace Core {
 	 * Trigger all update sub-operations.
 	 */
 	void AnimationPlayer::update() {
+		this->beginUpdate();
+		this->evaluate();
+		this->commitPose();
+	}
+
+	/*
+	 * First stage of an update: advance blending operations and validate the animation weights. This
+	 * stage may invoke BlendOp callbacks and must be run on the main thread.
+	 */
+	void AnimationPlayer::beginUpdate() {
 		// update current blending operation
 		this->updateBlendingOperations();
 		// validate animation weights
 		this->checkWeights();
-		// update the positions of all nodes in the target skeleton based on
+
+		UInt32 nodeCount = this->target->getNodeCount();
+		if (this->poseTransforms.size() != nodeCount) {
+			this->poseTransforms.resize(nodeCount);
+			this->nodePosed.resize(nodeCount);
+		}
+	}
+
+	/*
+	 * Second stage of an update: calculate the pose of the target skeleton into [poseTransforms] and drive the progress
+	 * of active animations. This stage only touches state owned by this player (and reads shared Animation data),
+	 * so the players of different skeletons can be evaluated concurrently.
+	 */
+	void AnimationPlayer::evaluate() {
+		// calculate the positions of all nodes in the target skeleton based on
 		// active animations
-		this->applyActiveAnimations();
+		this->calculatePose();
 		// drive the progress of active animations
 		this->updateAnimationsProgress();
 	}
 
+	/*
+	 * Final stage of an update: copy the pose calculated by evaluate() into the local transforms
+	 * of the target skeleton's nodes.
+	 */
+	void AnimationPlayer::commitPose() {
+		for (UInt32 node = 0; node < this->poseTransforms.size(); node++) {
+			if (!this->nodePosed[node]) continue;
+			Skeleton::SkeletonNode * targetNode = this->target->getNodeFromList(node);
+			targetNode->getLocalTransform().copy(this->poseTransforms[node]);
+		}
+	}
+
 	/*
 	 * Update the positions of all nodes of the target Skeleton object based on the progress of all
 	 * active animations.
 	 *
-	 * This method loops through each node in the target skeleton [target], and for each node it calculates
-	 * the interpolated translation, rotation, and scale for that node for each active animation. It combines
-	 * those transformations based on the weight of each active animation stored in member [weights] and
-	 * applies the final transformation to the node.
+	 * This method loops through each active animation, and for each one it calculates the interpolated translation,
+	 * rotation, and scale of every node in the target skeleton [target] into [sampledPose]. Those are combined into
+	 * [blendedPose] based on the weight of each active animation stored in member [weights] (translation and scale are
+	 * weighted sums, rotations are blended with normalized linear interpolation). Finally the transformation for each node
+	 * is stored in [poseTransforms], to be applied by commitPose().
 	 */
-	void AnimationPlayer::applyActiveAnimations() {
+	void AnimationPlayer::calculatePose() {
 		Vector3r translation;
 		Vector3r scale;
 		Quaternion rotation;
 
-		// storage for aggregate translation, rotation, and scale
-		Vector3r agTranslation;
-		Vector3r agScale;
-		Quaternion agRotation;
-
-		Quaternion temp;
-
-		// temp use Matrices
-		Matrix4x4 rotMatrix;
-		Matrix4x4 matrix;
+		UInt32 nodeCount = target->getNodeCount();
+		this->sampledPose.setNodeCount(nodeCount);
+		this->blendedPose.setNodeCount(nodeCount);
 
 		// keep track of the number of playing animations seen as we loop through all registered animations
 		UInt32 playingAnimationsSeen = 0;
+		Real agWeight = 0;
 
-		// loop through each node in the target Skeleton object, and calculate the position based on
-		// weighted average of positions returned from each active animation
-		for (UInt32 node = 0; node < target->getNodeCount(); node++) {
-			agScale.set(0, 0, 0);
-			agTranslation.set(0, 0, 0);
-			agRotation = Quaternion::Identity;
-
-			playingAnimationsSeen = 0;
-			Real agWeight = 0;
-
-			// get the Skeleton node corresponding to the current node index
-			Skeleton::SkeletonNode * targetNode = target->getNodeFromList(node);
-
-			// loop through all registered animations
-			for (Int32 i = (Int32)registeredAnimations.size() - 1; i >= 0; i--) {
-				WeakPointer<AnimationInstance> instance = this->registeredAnimations[i];
-
-				// include this animation only if it is playing
-				if (instance.isValid() && instance->playing) {
-
-					// if this node does not have an animation channel for it in the current animation, then ignore
-					Int32 mappedChannel = instance->getChannelMappingForTargetNode(node);
+		// loop through all registered animations
+		for (Int32 i = (Int32)registeredAnimations.size() - 1; i >= 0; i--) {
+			WeakPointer<AnimationInstance> instance = this->registeredAnimations[i];
 
-					// retrieve this animation's weight
-					Real weight = this->animationWeights[i];
+			// include this animation only if it is playing
+			if (!instance.isValid() || !instance->playing) continue;
 
-					// if this animation's weight is 0, then ignore it
-					if (weight <= 0)continue;
+			// retrieve this animation's weight
+			Real weight = this->animationWeights[i];
 
-					// calculate aggregate (sum of weights up until this point)
-					agWeight += weight;
+			// if this animation's weight is 0, then ignore it
+			if (weight <= 0)continue;
 
-					// calculate the translation, rotation, and scale for this animation at the current node
-					if (mappedChannel >= 0) {
-						this->calculateInterpolatedValues(instance, mappedChannel, translation, rotation, scale);
-					}
+			// calculate aggregate (sum of weights up until this point)
+			agWeight += weight;
 
-					// if there is no channel in the current animation for this node, use the
-					// default transformation values for this node
-					else {
-						translation = targetNode->InitialTranslation;
-						rotation = targetNode->InitialRotation;
-						scale = targetNode->InitialScale;
-					}
+			// calculate the translation, rotation, and scale for this animation at every node
+			for (UInt32 node = 0; node < nodeCount; node++) {
+				// if this node does not have an animation channel for it in the current animation, then
+				// use the default transformation values for this node
+				Int32 mappedChannel = instance->getChannelMappingForTargetNode(node);
+				if (mappedChannel >= 0) {
+					this->calculateInterpolatedValues(instance, node, mappedChannel, translation, rotation, scale);
+					this->sampledPose.setNode(node, translation, rotation, scale);
+				}
+				else {
+					Skeleton::SkeletonNode * targetNode = target->getNodeFromList(node);
+					this->sampledPose.setNode(node, targetNode->InitialTranslation, targetNode->InitialRotation, targetNode->InitialScale);
+				}
+			}
 
-					// if the number of active animations is 1, indicated by playingAnimationsCount == 1, and its
-					// weight is 1, then we simply use the results from CalculateInterpolatedValues() and apply those
-					// to the current node
-					if (this->playingAnimationsCount == 1 && weight == 1) {
-						agTranslation = translation;
-						agScale = scale;
-						agRotation = rotation;
-					}
-					// we have to apply weights across 1 or more animations
-					else {
-
-						// apply weight to each transformation
-						translation.scale(weight);
-						scale.scale(weight);
-						rotation.set(rotation.x() * weight, rotation.y() * weight, rotation.z() * weight, rotation.w() * weight);
-
-						// if this is the first active animation encountered, set the aggregate translation, rotation and scale
-						if (playingAnimationsSeen == 0) {
-							agTranslation = translation;
-							agScale = scale;
-							agRotation = rotation;
-						}
-						// this is not the first active animation encountered, so we additively combine the translation
-						// and scale into their aggregate counterparts. we use spherical interpolation to combine the
-						// rotation for this animation into the aggregate rotation.
-						else {
-							agTranslation = translation + agTranslation;
-							agScale = scale + agScale;
+			// if this is the first active animation encountered, it initializes the aggregate pose, otherwise
+			// it is combined with the aggregate pose
+			if (playingAnimationsSeen == 0) this->blendedPose.setWeighted(this->sampledPose, weight);
+			else this->blendedPose.blend(this->sampledPose, weight, weight / agWeight);
 
-							if (agWeight != 0)temp = Quaternion::slerp(agRotation, rotation, weight / agWeight);
-							else temp = rotation;
+			playingAnimationsSeen++;
+		}
 
-							agRotation = temp;
-						}
-					}
+		// only apply transformations if they were actually calculated
+		if (playingAnimationsSeen == 0) {
+			for (UInt32 node = 0; node < nodeCount; node++) this->nodePosed[node] = false;
+			return;
+		}
 
-					playingAnimationsSeen++;
-				}
+		for (UInt32 node = 0; node < nodeCount; node++) {
+			Skeleton::SkeletonNode * targetNode = target->getNodeFromList(node);
+			Matrix4x4& matrix = this->poseTransforms[node];
+			this->blendedPose.getTransform(node, matrix);
+
+			// if the agWeight for some reason is less than one, compensate by using
+			// the initial transformation values for the node
+			if (agWeight < .99) {
+				Matrix4x4 temp = targetNode->InitialTransform;
+				temp.multiplyByScalar(((Real)1.0 - agWeight));
+				matrix.add(temp);
 			}
 
-			// only apply transformations if they were actually calculated
-			if (playingAnimationsSeen > 0) {
-
-				matrix.setIdentity();
-				// apply interpolated scale
-				matrix.scale(agScale.x, agScale.y, agScale.z);
-				// apply interpolated rotation
-				agRotation.normalize();
-				rotMatrix = agRotation.rotationMatrix();
-
-				matrix.preMultiply(rotMatrix);
-				// apply interpolated translation
-				matrix.preTranslate(agTranslation.x, agTranslation.y, agTranslation.z);
-
-				// if the agWeight for some reason is less than one, compensate by using
-				// the initial transformation values for the node
-				if (agWeight < .99) {
-					Matrix4x4 temp = targetNode->InitialTransform;
-					temp.multiplyByScalar(((Real)1.0 - agWeight));
-					matrix.add(temp);
-				}
-
-				if (targetNode->hasTarget()) {
-					// get the local transform of the target of this node and apply
-					// [matrix], which contains the interpolated scale, rotation, and translation
-					Matrix4x4& localTransform = targetNode->getLocalTransform();
-					localTransform.copy(matrix);
-				}
-			}
+			// [matrix] contains the interpolated scale, rotation, and translation, and will be
+			// applied to the local transform of the target of this node
+			this->nodePosed[node] = targetNode->hasTarget();
 		}
 	}
 
@@ -282,7 +262,7 @@ namespace Core {
 	 * Then interpolate between those two key frames based on where the progress of [instance] lies between them, and store the
 	 * interpolated translation, rotation, and scale values in [translation], [rotation], and [scale].
 	 */
-	void AnimationPlayer::calculateInterpolatedValues(WeakPointer<AnimationInstance> instance, UInt32 channel, Vector3r& translation, Quaternion& rotation, Vector3r& scale) const
+	void AnimationPlayer::calculateInterpolatedValues(WeakPointer<AnimationInstance> instance, UInt32 node, UInt32 channel, Vector3r& translation, Quaternion& rotation, Vector3r& scale) const
 	{
 		Animation * animationPtr = const_cast<Animation *>(instance->sourceAnimation.get());
 		KeyFrameSet * frameSet = animationPtr->getKeyFrameSet(channel);
@@ -292,11 +272,15 @@ namespace Core {
 
 		// make sure it's an active KeyFrameSet
 		if (frameSet != nullptr && frameSet->Used) {
+			// the frame state for [node] remembers which key frames were used last time, so the search
+			// for the current key frames can usually start (and end) right there
+			AnimationInstance::FrameState * frameState = instance->getFrameState(node);
+
 			// for each of translation, scale, and rotation, find the two respective key frames between which
 			// instance->Progress lies, and interpolate between them based on instance->Progress.
-			this->calculateInterpolatedTranslation(instance, *frameSet, translation);
-			this->calculateInterpolatedScale(instance, *frameSet, scale);
-			this->calculateInterpolatedRotation(instance, *frameSet, rotation);
+			this->calculateInterpolatedTranslation(instance, *frameSet, frameState->TranslationKeyIndex, translation);
+			this->calculateInterpolatedScale(instance, *frameSet, frameState->ScaleKeyIndex, scale);
+			this->calculateInterpolatedRotation(instance, *frameSet, frameState->RotationKeyIndex, rotation);
 		}
 	}
 
@@ -353,7 +337,7 @@ namespace Core {
 	 * Use the value of instance->progress to find the two closest translation key frames in [keyFrameSet]. Then interpolate between the translation
 	 * values in those two key frames based on where instance->progress lies between them, and store the result in [vector].
 	 */
-	void AnimationPlayer::calculateInterpolatedTranslation(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, Vector3r& vector) const {
+	void AnimationPlayer::calculateInterpolatedTranslation(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, UInt32& keyIndexCursor, Vector3r& vector) const {
 		if (!instance.isValid()) {
 			throw InvalidReferenceException("AnimationPlayer::calculateInterpolatedTranslation -> 'instance' is invalid.");
 		}
@@ -365,7 +349,7 @@ namespace Core {
 
 		UInt32 previousIndex, nextIndex;
 		Real interFrameProgress;
-		Bool foundFrames = this->calculateInterpolation(instance, keyFrameSet, previousIndex, nextIndex, interFrameProgress, TransformationCompnent::Translation);
+		Bool foundFrames = this->calculateInterpolation(instance, keyFrameSet, keyIndexCursor, previousIndex, nextIndex, interFrameProgress, TransformationCompnent::Translation);
 
 		// did we successfully find 2 frames between which to interpolate?
 		if (foundFrames) {
@@ -386,7 +370,7 @@ namespace Core {
 	 * Use the value of instance->progress to find the two closest scale key frames in [keyFrameSet]. Then interpolate between the scale
 	 * values in those two key frames based on where instance->progress lies between them, and store the result in [vector].
 	 */
-	void AnimationPlayer::calculateInterpolatedScale(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, Vector3r& vector) const {
+	void AnimationPlayer::calculateInterpolatedScale(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, UInt32& keyIndexCursor, Vector3r& vector) const {
 		
 		if (!instance.isValid()) {
 			throw InvalidReferenceException("AnimationPlayer::calculateInterpolatedScale -> 'instance' is invalid.");
@@ -399,7 +383,7 @@ namespace Core {
 
 		UInt32 previousIndex, nextIndex;
 		Real interFrameProgress;
-		Bool foundFrames = calculateInterpolation(instance, keyFrameSet, previousIndex, nextIndex, interFrameProgress, TransformationCompnent::Scale);
+		Bool foundFrames = calculateInterpolation(instance, keyFrameSet, keyIndexCursor, previousIndex, nextIndex, interFrameProgress, TransformationCompnent::Scale);
 
 		// did we successfully find 2 frames between which to interpolate?
 		if (foundFrames) {
@@ -420,7 +404,7 @@ namespace Core {
 	 * Use the value of instance->progress to find the two closest rotation key frames in [keyFrameSet]. Then interpolate between the rotation
 	 * values in those two key frames based on where instance->progress lies between them, and store the result in [rotation].
 	 */
-	void AnimationPlayer::calculateInterpolatedRotation(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, Quaternion& rotation) const {
+	void AnimationPlayer::calculateInterpolatedRotation(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, UInt32& keyIndexCursor, Quaternion& rotation) const {
 		
 		if (!instance.isValid()) {
 			throw InvalidReferenceException("AnimationPlayer::calculateInterpolatedRotation -> 'instance' is invalid.");
@@ -433,7 +417,7 @@ namespace Core {
 
 		UInt32 previousIndex, nextIndex;
 		Real interFrameProgress;
-		Bool foundFrames = this->calculateInterpolation(instance, keyFrameSet, previousIndex, nextIndex, interFrameProgress, TransformationCompnent::Rotation);
+		Bool foundFrames = this->calculateInterpolation(instance, keyFrameSet, keyIndexCursor, previousIndex, nextIndex, interFrameProgress, TransformationCompnent::Rotation);
 
 		// did we successfully find 2 frames between which to interpolate?
 		if (foundFrames) {
@@ -456,109 +440,123 @@ namespace Core {
 	 * This method uses the value of instance->progress to find the two closest key frames in [keyFrameSet], of the type specified by [component]
 	 * and then stores the indices of those key frames in [previousIndex] and [nextIndex]. Then it uses instance->progress to determine how far from [lastIndex]
 	 * to [nextIndex] the animation currently is, and stores that value in [interFrameProgress] (range: 0 to 1).
+	 *
+	 * [keyIndexCursor] holds the result of the previous lookup for the same node & component and is updated with the
+	 * new result, see findKeyFrame().
 	 */
-	Bool AnimationPlayer::calculateInterpolation(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, UInt32& previousIndex, UInt32& nextIndex, Real& interFrameProgress, TransformationCompnent component) const {
+	Bool AnimationPlayer::calculateInterpolation(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, UInt32& keyIndexCursor, UInt32& previousIndex, UInt32& nextIndex, Real& interFrameProgress, TransformationCompnent component) const {
 		if (!instance.isValid()) {
 			throw InvalidReferenceException("AnimationPlayer::calculateInterpolation -> 'instance' is invalid.");
 		}
 
-		UInt32 frameCount = 0;
 		Real progress = instance->progress;
 		Real duration = instance->duration;
 
-		// get the correct frame count, which depends on [component]
-		if (component == TransformationCompnent::Translation)frameCount = (UInt32)keyFrameSet.TranslationKeyFrames.size();
-		else if (component == TransformationCompnent::Rotation)frameCount = (UInt32)keyFrameSet.RotationKeyFrames.size();
-		else if (component == TransformationCompnent::Scale)frameCount = (UInt32)keyFrameSet.ScaleKeyFrames.size();
-		else return false;
-
-		// loop through each key frame
-		for (UInt32 f = 0; f < frameCount; f++) {
-
-			KeyFrame * previousFrame = nullptr;
-			KeyFrame * nextFrame = nullptr;
+		// get the correct key frame times, which depend on [component]
+		const KeyFrameSet::KeyFrameTimes * keyFrameTimes = this->getKeyFrameTimes(component, keyFrameSet);
+		if (keyFrameTimes == nullptr) return false;
+		if (!keyFrameSet.keyFrameTimesUpToDate()) {
+			throw Exception("AnimationPlayer::calculateInterpolation -> Key frame times are out of date.");
+		}
+
+		const std::vector<Real>& realTimes = keyFrameTimes->RealTimes;
+		UInt32 frameCount = (UInt32)realTimes.size();
+		if (frameCount == 0) return false;
+
+		// [f] is the first key frame with a RealTime value greater than [progress] (or the last frame if there is no such frame),
+		// so the previous key frame and [f] are the frames we want
+		UInt32 f = this->findKeyFrame(*keyFrameTimes, progress, keyIndexCursor);
+		keyIndexCursor = f;
+		Real keyRealTime = realTimes[f];
+
+		previousIndex = 0;
+		if (f > 0)previousIndex = f - 1;
+		nextIndex = f;
+
+		// flag that indicates we need to interpolate from the last frame to the first frame
+		Bool overShoot = false;
+
+		// if f==frameCount-1 and keyRealTime <= progress, then we have reached the last frame and progress has moved
+		// beyond it. this means we need to interpolate between the last frame and the first frame (for smoothed animation looping).
+		if (f == frameCount - 1 && keyRealTime <= progress)
+		{
+			previousIndex = f;
+			nextIndex = 0;
+
+			// if the start offset for this animation is > 0, then we can't assume the
+			// next frame will be at index 0. in this case we must loop through each
+			// frame to find which one has a timestamp greater than StartOffset.
+			if (instance->startOffset > 0) {
+				for (UInt32 ff = 0; ff < frameCount; ff++) {
+					Real nextKeyRealTime = realTimes[ff];
+					if (nextKeyRealTime > instance->startOffset || ff == frameCount - 1) {
+						nextIndex = ff;
+					}
+				}
+			}
+			overShoot = true;
+		}
 
-			// get the correct time stamp for this frame, which depends on [component]
-			Real keyRealTime = this->getKeyFrameTime(component, f, keyFrameSet);
+		// calculate local progress between the previous frame and the next frame
+		Real previousRealTime = realTimes[previousIndex];
+		Real interFrameTimeDelta = realTimes[nextIndex] - previousRealTime;
+		if (overShoot)  interFrameTimeDelta = duration - previousRealTime;
 
-			// if the RealTime value for this key frame is greater than [progress], then the previous key frame and the current key frame
-			// are the frames we want
-			if (keyRealTime > progress || f == frameCount - 1) {
-				previousIndex = 0;
-				if (f > 0)previousIndex = f - 1;
-				nextIndex = f;
+		Real interFrameElapsed = progress - previousRealTime;
+		interFrameProgress = 1;
+		if (interFrameTimeDelta > 0)interFrameProgress = interFrameElapsed / interFrameTimeDelta;
 
-				// flag that indicates we need to interpolate from the last frame to the first frame
-				Bool overShoot = false;
+		return true;
+	}
 
-				// if f==frameCount-1 and keyRealTime <= progress, then we have reached the last frame and progress has moved
-				// beyond it. this means we need to interpolate between the last frame and the first frame (for smoothed animation looping).
-				if (f == frameCount - 1 && keyRealTime <= progress)
-				{
-					previousIndex = f;
-					nextIndex = 0;
-
-					// if the start offset for this animation is > 0, then we can't assume the
-					// next frame will be at index 0. in this case we must loop through each
-					// frame to find which one has a timestamp greater than StartOffset.
-					if (instance->startOffset > 0) {
-						for (UInt32 ff = 0; ff < frameCount; ff++) {
-							// get the correct time stamp for for frame [ff], which depends on [component]
-							Real nextKeyRealTime = this->getKeyFrameTime(component, ff, keyFrameSet);
-							if (nextKeyRealTime > instance->startOffset || ff == frameCount - 1) {
-								nextIndex = ff;
-							}
-						}
-					}
-					overShoot = true;
-				}
+	/*
+	 * Find the index of the first key frame in [keyFrameTimes] with a time greater than [progress], or the index of the last
+	 * key frame if there is none. Since progress normally moves forward by a small amount each update, the search starts
+	 * at [cursor] (the previous result) and walks a few frames from there; evenly spaced key frames start from the
+	 * directly computed frame instead. If neither gets there quickly, fall back to a binary search.
+	 */
+	UInt32 AnimationPlayer::findKeyFrame(const KeyFrameSet::KeyFrameTimes& keyFrameTimes, Real progress, UInt32 cursor) const {
+		static const UInt32 MaxCursorSteps = 4;
 
-				// get pointers to the previous frame and the next frame
-				if (component == TransformationCompnent::Translation) {
-					const TranslationKeyFrame& nextTranslationFrame = keyFrameSet.TranslationKeyFrames[nextIndex];
-					const TranslationKeyFrame& lastTranslationFrame = keyFrameSet.TranslationKeyFrames[previousIndex];
-					nextFrame = const_cast<TranslationKeyFrame *>(&nextTranslationFrame);
-					previousFrame = const_cast<TranslationKeyFrame *>(&lastTranslationFrame);
-				} else if (component == TransformationCompnent::Rotation) {
-					const RotationKeyFrame& nextRotationFrame = keyFrameSet.RotationKeyFrames[nextIndex];
-					const RotationKeyFrame& lastRotationFrame = keyFrameSet.RotationKeyFrames[previousIndex];
-					nextFrame = const_cast<RotationKeyFrame *>(&nextRotationFrame);
-					previousFrame = const_cast<RotationKeyFrame *>(&lastRotationFrame);
-				} else if (component == TransformationCompnent::Scale) {
-					const ScaleKeyFrame& nextScaleFrame = keyFrameSet.ScaleKeyFrames[nextIndex];
-					const ScaleKeyFrame& lastScaleFrame = keyFrameSet.ScaleKeyFrames[previousIndex];
-					nextFrame = const_cast<ScaleKeyFrame *>(&nextScaleFrame);
-					previousFrame = const_cast<ScaleKeyFrame *>(&lastScaleFrame);
-				}
+		const std::vector<Real>& realTimes = keyFrameTimes.RealTimes;
+		UInt32 frameCount = (UInt32)realTimes.size();
+		UInt32 lastFrame = frameCount - 1;
 
-				// calculate local progress between [previous] and [nextFrame]
-				Real interFrameTimeDelta = nextFrame->RealTime - previousFrame->RealTime;
-				if (overShoot)  interFrameTimeDelta = duration - previousFrame->RealTime;
+		UInt32 f = cursor;
+		if (keyFrameTimes.Uniform) {
+			Real frameOffset = (progress - keyFrameTimes.Start) / keyFrameTimes.Interval;
+			if (frameOffset < 0) f = 0;
+			else if (frameOffset >= (Real)lastFrame) f = lastFrame;
+			else f = (UInt32)frameOffset + 1;
+		}
+		if (f > lastFrame) f = lastFrame;
 
-				Real interFrameElapsed = progress - previousFrame->RealTime;
-				interFrameProgress = 1;
-				if (interFrameTimeDelta > 0)interFrameProgress = interFrameElapsed / interFrameTimeDelta;
+		for (UInt32 step = 0; step <= MaxCursorSteps; step++) {
+			Bool previousFrameOk = f == 0 || realTimes[f - 1] <= progress;
+			Bool currentFrameOk = f == lastFrame || realTimes[f] > progress;
+			if (previousFrameOk && currentFrameOk) return f;
 
-				return true;
-			}
+			if (!previousFrameOk) f--;
+			else f++;
 		}
 
-		return false;
+		f = (UInt32)(std::upper_bound(realTimes.begin(), realTimes.end(), progress) - realTimes.begin());
+		if (f > lastFrame) f = lastFrame;
+		return f;
 	}
 
 	/*
-	 * Get the key frame time for the frame at [frameIndex] for the desired transformation component [transformationComponent].
+	 * Get the key frame times for the desired transformation component [transformationComponent].
 	 */
-	Real AnimationPlayer::getKeyFrameTime(TransformationCompnent transformationComponent, Int32 frameIndex, const KeyFrameSet& keyFrameSet) const {
-		Real keyFrameTime = 0;
+	const KeyFrameSet::KeyFrameTimes * AnimationPlayer::getKeyFrameTimes(TransformationCompnent transformationComponent, const KeyFrameSet& keyFrameSet) const {
 		if (transformationComponent == TransformationCompnent::Translation)
-			keyFrameTime = keyFrameSet.TranslationKeyFrames[frameIndex].RealTime;
+			return &keyFrameSet.TranslationTimes;
 		else if (transformationComponent == TransformationCompnent::Rotation)
-			keyFrameTime = keyFrameSet.RotationKeyFrames[frameIndex].RealTime;
+			return &keyFrameSet.RotationTimes;
 		else if (transformationComponent == TransformationCompnent::Scale)
-			keyFrameTime = keyFrameSet.ScaleKeyFrames[frameIndex].RealTime;
+			return &keyFrameSet.ScaleTimes;
 
-		return keyFrameTime;
+		return nullptr;
 	}
 
 	/*
@@ -580,6 +578,8 @@ namespace Core {
 
 		// make sure an instance of [animation] does not already exist for this player
 		if (this->animationIndexMap.find(animation->getObjectID()) == this->animationIndexMap.end()) {
+			animation->updateKeyFrameTimes();
+
 			WeakPointer<AnimationInstance> instance = animationManager->createAnimationInstance(target, animation);
 		
 			Bool initSuccess = instance->init();
@@ -19,7 +19,9 @@
 #include "../base/CoreObject.h"
 #include "../geometry/Vector3.h"
 #include "../math/Quaternion.h"
+#include "../math/Matrix4x4.h"
 #include "KeyFrameSet.h"
+#include "Pose.h"
 
 namespace Core {
 	//forward declarations
@@ -77,6 +79,14 @@ namespace Core {
 		std::vector<Bool> crossFadeTargets;
 		// number of animations currently playing
 		Int32 playingAnimationsCount;
+		// per-node transformations of the active animation currently being sampled
+		Pose sampledPose;
+		// weighted combination of the transformations of all active animations
+		Pose blendedPose;
+		// local transform calculated for each node in [target] during the last update
+		std::vector<Matrix4x4> poseTransforms;
+		// flags that indicate which entries in [poseTransforms] should be applied to [target]
+		std::vector<Bool> nodePosed;
 
 		AnimationPlayer(WeakPointer<Skeleton> target);
 
@@ -85,17 +95,21 @@ namespace Core {
 		void clearBlendOpQueue();
 
 		void update();
+		void beginUpdate();
+		void evaluate();
+		void commitPose();
 		void updateBlendingOperations();
 		void checkWeights();
-		void applyActiveAnimations();
+		void calculatePose();
 		void updateAnimationsProgress();
 		void updateAnimationInstanceProgress(WeakPointer<AnimationInstance> instance) const;
-		void calculateInterpolatedValues(WeakPointer<AnimationInstance> instance, UInt32 channel, Vector3r& translation, Quaternion& rotation, Vector3r& scale) const;
-		void calculateInterpolatedTranslation(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, Vector3r& vector) const;
-		void calculateInterpolatedScale(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, Vector3r& vector) const;
-		void calculateInterpolatedRotation(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, Quaternion& rotation) const;
-		Bool calculateInterpolation(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, UInt32& lastIndex, UInt32& nextIndex, Real& interFrameProgress, TransformationCompnent component) const;
-		Real getKeyFrameTime(TransformationCompnent transformationComponent, Int32 frameIndex, const KeyFrameSet& keyFrameSet) const;
+		void calculateInterpolatedValues(WeakPointer<AnimationInstance> instance, UInt32 node, UInt32 channel, Vector3r& translation, Quaternion& rotation, Vector3r& scale) const;
+		void calculateInterpolatedTranslation(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, UInt32& keyIndexCursor, Vector3r& vector) const;
+		void calculateInterpolatedScale(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, UInt32& keyIndexCursor, Vector3r& vector) const;
+		void calculateInterpolatedRotation(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, UInt32& keyIndexCursor, Quaternion& rotation) const;
+		Bool calculateInterpolation(WeakPointer<AnimationInstance> instance, const KeyFrameSet& keyFrameSet, UInt32& keyIndexCursor, UInt32& lastIndex, UInt32& nextIndex, Real& interFrameProgress, TransformationCompnent component) const;
+		UInt32 findKeyFrame(const KeyFrameSet::KeyFrameTimes& keyFrameTimes, Real progress, UInt32 cursor) const;
+		const KeyFrameSet::KeyFrameTimes * getKeyFrameTimes(TransformationCompnent transformationComponent, const KeyFrameSet& keyFrameSet) const;
 
 		void setSpeed(UInt32 animationIndex, Real speedFactor);
 		void play(UInt32 animationIndex);
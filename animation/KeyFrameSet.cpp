@@ -1,3 +1,5 @@
+#include <cmath>
+
 #include "KeyFrameSet.h"
 
 namespace Core {
@@ -14,4 +16,52 @@ namespace Core {
 	 */
 	KeyFrameSet::~KeyFrameSet(){
 	}
+
+	/*
+	 * Rebuild [TranslationTimes], [ScaleTimes] and [RotationTimes] from the key frames. This must be
+	 * called whenever key frames are added, removed or re-timed.
+	 */
+	void KeyFrameSet::updateKeyFrameTimes() {
+		buildKeyFrameTimes(TranslationKeyFrames, TranslationTimes);
+		buildKeyFrameTimes(ScaleKeyFrames, ScaleTimes);
+		buildKeyFrameTimes(RotationKeyFrames, RotationTimes);
+	}
+
+	/*
+	 * Check that the lookup data built by updateKeyFrameTimes() still matches the key frames.
+	 */
+	Bool KeyFrameSet::keyFrameTimesUpToDate() const {
+		return TranslationTimes.RealTimes.size() == TranslationKeyFrames.size() &&
+			   ScaleTimes.RealTimes.size() == ScaleKeyFrames.size() &&
+			   RotationTimes.RealTimes.size() == RotationKeyFrames.size();
+	}
+
+	/*
+	 * Copy the RealTime of each frame in [keyFrames] into [times] and determine whether the frames
+	 * are evenly spaced (within a small tolerance of the average spacing).
+	 */
+	template <typename T> void KeyFrameSet::buildKeyFrameTimes(const std::vector<T>& keyFrames, KeyFrameTimes& times) {
+		UInt32 frameCount = (UInt32)keyFrames.size();
+		times.RealTimes.resize(frameCount);
+		for (UInt32 f = 0; f < frameCount; f++) {
+			times.RealTimes[f] = keyFrames[f].RealTime;
+		}
+
+		times.Uniform = false;
+		times.Start = frameCount > 0 ? times.RealTimes[0] : 0;
+		times.Interval = 0;
+		if (frameCount < 2) return;
+
+		Real interval = (times.RealTimes[frameCount - 1] - times.Start) / (Real)(frameCount - 1);
+		if (interval <= 0) return;
+
+		Real tolerance = interval * 0.001f;
+		for (UInt32 f = 1; f < frameCount; f++) {
+			Real expected = times.Start + interval * (Real)f;
+			if (std::fabs(times.RealTimes[f] - expected) > tolerance) return;
+		}
+
+		times.Uniform = true;
+		times.Interval = interval;
+	}
 }
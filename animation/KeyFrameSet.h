@@ -23,6 +23,31 @@ namespace Core {
 	class KeyFrameSet final {
 	public:
 
+		/*
+		 * The times of one component's key frames, stored contiguously so key frame lookup
+		 * doesn't have to walk the key frame objects themselves. When the key frames are
+		 * evenly spaced [Uniform] is true and the key frame for a given time can be computed
+		 * directly from [Start] and [Interval].
+		 */
+		class KeyFrameTimes {
+		public:
+
+			// RealTime of each key frame, in key frame order
+			std::vector<Real> RealTimes;
+			// are the key frames evenly spaced?
+			Bool Uniform;
+			// time of the first key frame
+			Real Start;
+			// time between consecutive key frames when [Uniform] is true
+			Real Interval;
+
+			KeyFrameTimes() {
+				Uniform = false;
+				Start = 0;
+				Interval = 0;
+			}
+		};
+
 		// is this key frame set active?
 		Bool Used;
 		// key frames with translation transformations
@@ -32,7 +57,19 @@ namespace Core {
 		// key frames with rotation transformations
 		std::vector<RotationKeyFrame> RotationKeyFrames;
 
+		// lookup data for [TranslationKeyFrames], [ScaleKeyFrames] and [RotationKeyFrames]
+		KeyFrameTimes TranslationTimes;
+		KeyFrameTimes ScaleTimes;
+		KeyFrameTimes RotationTimes;
+
 		KeyFrameSet();
 		~KeyFrameSet();
+
+		void updateKeyFrameTimes();
+		Bool keyFrameTimesUpToDate() const;
+
+	private:
+
+		template <typename T> static void buildKeyFrameTimes(const std::vector<T>& keyFrames, KeyFrameTimes& times);
 	};
 }
@@ -0,0 +1,132 @@
+#include "Pose.h"
+#include "../common/Exception.h"
+
+namespace Core {
+
+	/*
+	 * Default constructor.
+	 */
+	Pose::Pose() {
+		this->nodeCount = 0;
+	}
+
+	/*
+	 * Resize this pose to hold [nodeCount] nodes. Existing values are not preserved.
+	 */
+	void Pose::setNodeCount(UInt32 nodeCount) {
+		if (this->nodeCount == nodeCount) return;
+		this->nodeCount = nodeCount;
+		this->translations.resize(nodeCount * TranslationStride);
+		this->rotations.resize(nodeCount * RotationStride);
+		this->scales.resize(nodeCount * ScaleStride);
+	}
+
+	UInt32 Pose::getNodeCount() const {
+		return this->nodeCount;
+	}
+
+	void Pose::setNode(UInt32 node, const Vector3r& translation, const Quaternion& rotation, const Vector3r& scale) {
+		Real * t = this->translations.data() + node * TranslationStride;
+		t[0] = translation.x;
+		t[1] = translation.y;
+		t[2] = translation.z;
+
+		Real * r = this->rotations.data() + node * RotationStride;
+		r[0] = rotation.x();
+		r[1] = rotation.y();
+		r[2] = rotation.z();
+		r[3] = rotation.w();
+
+		Real * s = this->scales.data() + node * ScaleStride;
+		s[0] = scale.x;
+		s[1] = scale.y;
+		s[2] = scale.z;
+	}
+
+	/*
+	 * Start a weighted blend: set the translation and scale of every node to those of [source]
+	 * multiplied by [weight], and copy the rotations of [source] as they are.
+	 */
+	void Pose::setWeighted(const Pose& source, Real weight) {
+		this->setNodeCount(source.nodeCount);
+
+		const Real * srcT = source.translations.data();
+		const Real * srcS = source.scales.data();
+		Real * t = this->translations.data();
+		Real * s = this->scales.data();
+		for (UInt32 i = 0; i < this->nodeCount * TranslationStride; i++) t[i] = srcT[i] * weight;
+		for (UInt32 i = 0; i < this->nodeCount * ScaleStride; i++) s[i] = srcS[i] * weight;
+
+		this->rotations = source.rotations;
+	}
+
+	/*
+	 * Add the translation and scale of every node in [source], multiplied by [weight], to this pose, and move the
+	 * rotation of every node towards the rotation in [source] by [rotationFactor] using normalized linear
+	 * interpolation. The rotations are left unnormalized, getTransform() takes care of that.
+	 */
+	void Pose::blend(const Pose& source, Real weight, Real rotationFactor) {
+		if (source.nodeCount != this->nodeCount) {
+			throw InvalidArgumentException("Pose::blend -> Node count mismatch.");
+		}
+
+		const Real * srcT = source.translations.data();
+		const Real * srcS = source.scales.data();
+		Real * t = this->translations.data();
+		Real * s = this->scales.data();
+		for (UInt32 i = 0; i < this->nodeCount * TranslationStride; i++) t[i] += srcT[i] * weight;
+		for (UInt32 i = 0; i < this->nodeCount * ScaleStride; i++) s[i] += srcS[i] * weight;
+
+		const Real * srcR = source.rotations.data();
+		Real * r = this->rotations.data();
+		Real keep = 1.0f - rotationFactor;
+		for (UInt32 n = 0; n < this->nodeCount; n++) {
+			const Real * a = srcR + n * RotationStride;
+			Real * b = r + n * RotationStride;
+
+			// take the shortest path between the two rotations
+			Real dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+			Real factor = dot < 0.0f ? -rotationFactor : rotationFactor;
+
+			b[0] = b[0] * keep + a[0] * factor;
+			b[1] = b[1] * keep + a[1] * factor;
+			b[2] = b[2] * keep + a[2] * factor;
+			b[3] = b[3] * keep + a[3] * factor;
+		}
+	}
+
+	/*
+	 * Build the local transformation matrix (translation * rotation * scale) for [node].
+	 */
+	void Pose::getTransform(UInt32 node, Matrix4x4& out) const {
+		const Real * t = this->translations.data() + node * TranslationStride;
+		const Real * r = this->rotations.data() + node * RotationStride;
+		const Real * s = this->scales.data() + node * ScaleStride;
+
+		Quaternion rotation(r[0], r[1], r[2], r[3]);
+		rotation.normalize();
+
+		Real * data = out.getData();
+		rotation.setRotationMatrix(data);
+		for (UInt32 i = 0; i < 3; i++) {
+			data[i] *= s[0];
+			data[4 + i] *= s[1];
+			data[8 + i] *= s[2];
+		}
+		data[12] = t[0];
+		data[13] = t[1];
+		data[14] = t[2];
+	}
+
+	Real * Pose::getTranslations() {
+		return this->translations.data();
+	}
+
+	Real * Pose::getRotations() {
+		return this->rotations.data();
+	}
+
+	Real * Pose::getScales() {
+		return this->scales.data();
+	}
+}
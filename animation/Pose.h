@@ -0,0 +1,50 @@
+/*********************************************
+*
+* class: Pose
+*
+* The local translation, rotation, and scale of every node in a
+* Skeleton, stored as flat component arrays (xyz, xyzw, xyz per node)
+* so that blending operates on all nodes in tight loops.
+*
+***********************************************/
+
+#pragma once
+
+#include <vector>
+
+#include "../common/types.h"
+#include "../geometry/Vector3.h"
+#include "../math/Quaternion.h"
+#include "../math/Matrix4x4.h"
+
+namespace Core {
+
+	class Pose final {
+	public:
+
+		static const UInt32 TranslationStride = 3;
+		static const UInt32 RotationStride = 4;
+		static const UInt32 ScaleStride = 3;
+
+		Pose();
+
+		void setNodeCount(UInt32 nodeCount);
+		UInt32 getNodeCount() const;
+
+		void setNode(UInt32 node, const Vector3r& translation, const Quaternion& rotation, const Vector3r& scale);
+		void setWeighted(const Pose& source, Real weight);
+		void blend(const Pose& source, Real weight, Real rotationFactor);
+		void getTransform(UInt32 node, Matrix4x4& out) const;
+
+		Real * getTranslations();
+		Real * getRotations();
+		Real * getScales();
+
+	private:
+
+		UInt32 nodeCount;
+		std::vector<Real> translations;
+		std::vector<Real> rotations;
+		std::vector<Real> scales;
+	};
+}
@@ -1233,6 +1233,8 @@ namespace Core {
                     keyFrame.Rotation.set(quatKey.mValue.x, quatKey.mValue.y, quatKey.mValue.z, quatKey.mValue.w);
                     keyFrameSet->RotationKeyFrames.push_back(keyFrame);
                 }
+
+                keyFrameSet->updateKeyFrameTimes();
             }
         }
 
@@ -5,7 +5,7 @@ static std::atomic<Core::UInt64> _cur_id;
 
 namespace Core {
 
-    CoreObject::CoreObject() {
+    CoreObject::CoreObject(): referenceSlot(nullptr) {
         this->objectID = _cur_id++;
     }
 
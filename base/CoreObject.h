@@ -6,11 +6,14 @@ namespace Core {
 
     // forward declarations
     class Engine;
+    class CoreObjectReferenceManager;
+    class CoreObjectSlot;
 
     class CoreObject {
 
         friend class Engine;
-        
+        friend class CoreObjectReferenceManager;
+
     public:
         UInt64 getObjectID() const;
         virtual ~CoreObject();
@@ -18,6 +21,10 @@ namespace Core {
     protected:
         CoreObject();
         UInt64 objectID;
+
+    private:
+        // slot occupied in the owning CoreObjectReferenceManager
+        CoreObjectSlot* referenceSlot;
     };
 
 }
\ No newline at end of file
@@ -2,57 +2,201 @@
 
 namespace Core {
 
-    CoreObjectReferenceManager::CoreObjectReferenceManager() {
+    const UInt32 CoreObjectReferenceManager::NoSlot;
+    const UInt32 CoreObjectReferenceManager::SlotBlockSize;
+
+    CoreObjectReferenceManager::CoreObjectReferenceManager(): slotCount(0), freeListHead(NoSlot), liveObjectCount(0) {
     }
 
     CoreObjectReferenceManager::~CoreObjectReferenceManager() {
     }
 
-    void CoreObjectReferenceManager::addReference(std::shared_ptr<CoreObject> object, OwnerType ownerType) {
-        const UInt64 objectID = object->getObjectID();
+    CoreObjectReferenceManager::Handle CoreObjectReferenceManager::addReference(std::shared_ptr<CoreObject> object, OwnerType ownerType) {
+        if (!object) {
+            throw NullPointerException("CoreObjectReferenceManager::addReference() -> 'object' is null.");
+        }
+        if (this->findSlot(object.get()) != nullptr) {
+            throw Exception("CoreObjectReferenceManager::addReference() -> 'object' is already present.");
+        }
+
+        UInt32 index = this->freeListHead;
+        if (index != NoSlot) {
+            this->freeListHead = this->getSlotAt(index).nextFree;
+        } else {
+            index = this->slotCount++;
+            if (index / SlotBlockSize >= this->slotBlocks.size()) {
+                this->slotBlocks.push_back(std::unique_ptr<CoreObjectSlot[]>(new CoreObjectSlot[SlotBlockSize]));
+            }
+        }
+
+        CoreObjectSlot& slot = this->getSlotAt(index);
+        slot.manager = this;
+        slot.index = index;
+        slot.typeIndex = this->getTypeIndex(typeid(*object));
+        slot.object = object;
+        slot.ownerType = (UInt32)ownerType;
+        slot.released = false;
+        slot.referenceCount = ownerType == CoreObjectReferenceManager::OwnerType::Single ? 1 : 0;
+        object->referenceSlot = &slot;
 
-        const UInt32 initialReferenceCount = ownerType == CoreObjectReferenceManager::OwnerType::Single ? 1 : 0;
-        this->referenceCounts[objectID] = initialReferenceCount;
+        this->liveObjectCount++;
+        this->typeLiveCounts[slot.typeIndex]++;
 
-        this->referenceOwnerTypes[objectID] = ownerType;
-        this->referenceIndex[objectID] = this->references.size();
-        this->references.push_back(object);
+        Handle handle;
+        handle.index = index;
+        handle.generation = slot.generation;
+        return handle;
     }
 
     void CoreObjectReferenceManager::removeReference(WeakPointer<CoreObject> object) {
-        const UInt32 objectID = object->getObjectID();
-        std::unordered_map<UInt64, UInt32>::const_iterator loc = this->referenceCounts.find(objectID);
-        if (loc != this->referenceCounts.end()) {
-            UInt32& referenceCount = this->referenceCounts[objectID];
-            if (referenceCount == 0) {
-                throw Exception("CoreObjectReferenceManager::removeReference() -> Reference count is already zero.");
-            }
-            referenceCount--;
-            if (referenceCount == 0) {
-                this->references.erase(this->references.begin() + this->referenceIndex[objectID]);
-            }
-        } else {
+        CoreObjectSlot* slot = this->findSlot(object.get());
+        if (slot == nullptr) {
             throw Exception("CoreObjectReferenceManager::removeReference() -> 'object' not present.");
         }
+        if (slot->referenceCount == 0) {
+            throw Exception("CoreObjectReferenceManager::removeReference() -> Reference count is already zero.");
+        }
+        slot->referenceCount--;
+        if (slot->referenceCount == 0) {
+            this->releaseSlot(*slot);
+        }
     }
 
     void CoreObjectReferenceManager::addReferenceOwner(WeakPointer<CoreObject> object) {
-        addReferenceOwner(object->getObjectID());
+        CoreObjectSlot* slot = this->findSlot(object.get());
+        if (slot == nullptr) {
+            throw Exception("CoreObjectReferenceManager::addReferenceOwner() -> 'object' not present.");
+        }
+        slot->referenceCount++;
     }
 
-    void CoreObjectReferenceManager::addReferenceOwner(UInt64 id) {
-        this->referenceCounts[id]++;
+    void CoreObjectReferenceManager::addReferenceOwner(Handle handle) {
+        if (!this->isValid(handle) || this->getSlotAt(handle.index).released) {
+            throw Exception("CoreObjectReferenceManager::addReferenceOwner() -> 'handle' is not valid.");
+        }
+        this->getSlotAt(handle.index).referenceCount++;
     }
 
     UInt32 CoreObjectReferenceManager::getReferenceCount(WeakPointer<CoreObject> object) const {
-        return getReferenceCount(object->getObjectID());
+        const CoreObjectSlot* slot = this->findSlot(object.get());
+        return slot != nullptr ? slot->referenceCount : 0;
+    }
+
+    UInt32 CoreObjectReferenceManager::getReferenceCount(Handle handle) const {
+        return this->isValid(handle) ? this->getSlotAt(handle.index).referenceCount : 0;
+    }
+
+    Bool CoreObjectReferenceManager::isValid(Handle handle) const {
+        return handle.index < this->slotCount && this->getSlotAt(handle.index).generation == handle.generation;
+    }
+
+    /*
+     * Get the object referenced by [handle], or nullptr if it has been destroyed.
+     */
+    CoreObject* CoreObjectReferenceManager::get(Handle handle) const {
+        return this->isValid(handle) ? this->getSlotAt(handle.index).object.get() : nullptr;
+    }
+
+    CoreObjectReferenceManager::Handle CoreObjectReferenceManager::getHandle(WeakPointer<CoreObject> object) const {
+        Handle handle;
+        const CoreObjectSlot* slot = this->findSlot(object.get());
+        if (slot != nullptr) {
+            handle.index = slot->index;
+            handle.generation = slot->generation;
+        }
+        return handle;
+    }
+
+    /*
+     * Get the slot [object] is registered in, whichever manager it belongs to, or nullptr if it isn't registered.
+     * Released objects keep their slot until they are destroyed.
+     */
+    const CoreObjectSlot* CoreObjectReferenceManager::getSlot(const CoreObject* object) {
+        if (object == nullptr) return nullptr;
+        const CoreObjectSlot* slot = object->referenceSlot;
+        if (slot == nullptr || slot->object.get() != object) return nullptr;
+        return slot;
     }
 
-    UInt32 CoreObjectReferenceManager::getReferenceCount(UInt64 id) const {
-        std::unordered_map<UInt64, UInt32>::const_iterator loc = this->referenceCounts.find(id);
-        if (loc != this->referenceCounts.end()) {
-            return (*loc).second;
+    /*
+     * Destroy every object released since the last call. Destructors commonly release the objects they own, so this
+     * keeps going until nothing is left pending. Returns the number of objects destroyed.
+     */
+    UInt32 CoreObjectReferenceManager::destroyReleasedObjects() {
+        UInt32 destroyedCount = 0;
+        while (this->releasedSlots.size() > 0) {
+            this->destroyingSlots.swap(this->releasedSlots);
+            for (UInt32 index : this->destroyingSlots) {
+                CoreObjectSlot& slot = this->getSlotAt(index);
+                this->destroyingObjects.push_back(std::move(slot.object));
+                slot.released = false;
+                slot.generation++;
+                slot.nextFree = this->freeListHead;
+                this->freeListHead = slot.index;
+            }
+            destroyedCount += (UInt32)this->destroyingSlots.size();
+            this->destroyingSlots.clear();
+            this->destroyingObjects.clear();
         }
-        return 0;
+        return destroyedCount;
+    }
+
+    UInt32 CoreObjectReferenceManager::getReleasedObjectCount() const {
+        return (UInt32)this->releasedSlots.size();
+    }
+
+    UInt32 CoreObjectReferenceManager::getLiveObjectCount() const {
+        return this->liveObjectCount;
+    }
+
+    /*
+     * Number of live objects whose dynamic type is exactly [type] (objects of derived types are not included).
+     */
+    UInt32 CoreObjectReferenceManager::getLiveObjectCount(const std::type_info& type) const {
+        auto result = this->typeIndices.find(std::type_index(type));
+        if (result == this->typeIndices.end()) return 0;
+        return this->typeLiveCounts[result->second];
+    }
+
+    void CoreObjectReferenceManager::getLiveObjectCounts(std::vector<TypeCount>& counts) const {
+        counts.clear();
+        for (UInt32 i = 0; i < this->typeNames.size(); i++) {
+            if (this->typeLiveCounts[i] == 0) continue;
+            counts.push_back({this->typeNames[i], this->typeLiveCounts[i]});
+        }
+    }
+
+    CoreObjectSlot& CoreObjectReferenceManager::getSlotAt(UInt32 index) const {
+        return this->slotBlocks[index / SlotBlockSize][index % SlotBlockSize];
+    }
+
+    /*
+     * The slot stored on [object] is only trusted if it belongs to this manager and actually holds [object],
+     * since the engine and the graphics system each have a manager of their own. Released objects are not found.
+     */
+    CoreObjectSlot* CoreObjectReferenceManager::findSlot(const CoreObject* object) const {
+        if (object == nullptr) return nullptr;
+        CoreObjectSlot* slot = object->referenceSlot;
+        if (slot == nullptr || slot->manager != this || slot->object.get() != object || slot->released) return nullptr;
+        return slot;
+    }
+
+    UInt32 CoreObjectReferenceManager::getTypeIndex(const std::type_info& type) {
+        auto result = this->typeIndices.find(std::type_index(type));
+        if (result != this->typeIndices.end()) return result->second;
+
+        UInt32 typeIndex = (UInt32)this->typeNames.size();
+        this->typeIndices[std::type_index(type)] = typeIndex;
+        this->typeNames.push_back(type.name());
+        this->typeLiveCounts.push_back(0);
+        return typeIndex;
+    }
+
+    void CoreObjectReferenceManager::releaseSlot(CoreObjectSlot& slot) {
+        slot.released = true;
+        this->releasedSlots.push_back(slot.index);
+
+        this->liveObjectCount--;
+        this->typeLiveCounts[slot.typeIndex]--;
     }
-}
\ No newline at end of file
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
 #include <unordered_map>
 #include <vector>
 
@@ -10,6 +13,39 @@
 
 namespace Core {
 
+    // forward declarations
+    class CoreObjectReferenceManager;
+
+    /*
+     * Registration record of a single object. Slots are never moved or deallocated while their manager exists,
+     * so ObjectHandle can point at one directly.
+     */
+    class CoreObjectSlot {
+    public:
+        std::shared_ptr<CoreObject> object;
+        const CoreObjectReferenceManager* manager = nullptr;
+        UInt32 generation = 1;
+        UInt32 index = 0;
+        UInt32 referenceCount = 0;
+        UInt32 typeIndex = 0;
+        UInt32 nextFree = 0;
+        UInt32 ownerType = 0;
+        // the object has lost its last owner and waits for destroyReleasedObjects()
+        Bool released = false;
+    };
+
+    /*
+     * Owns the engine's CoreObjects and counts their owners. Objects live in a slot map: each registered object
+     * occupies a slot (which is stored on the object), freed slots are chained into a free list, and every
+     * time a slot is freed its generation is bumped, so a Handle (slot index + generation) can be validated with
+     * a single compare. Registration and release are O(1).
+     *
+     * An object whose owner count drops to zero is released: the manager no longer accepts it (owners can't be
+     * added or removed), but it is only destroyed by the next call to destroyReleasedObjects() (the engine calls it
+     * once per frame), so releasing many transient objects doesn't cascade into destructors in the middle of a
+     * frame. Until then both WeakPointers and Handles to it stay valid; its slot is freed, and its Handles
+     * invalidated, when it is destroyed, which is also when its WeakPointers expire.
+     */
     class CoreObjectReferenceManager final {
     public:
 
@@ -18,23 +54,64 @@ namespace Core {
             Multiple = 1
         };
 
+        class Handle {
+        public:
+            UInt32 index = 0;
+            UInt32 generation = 0;
+        };
+
+        class TypeCount {
+        public:
+            std::string typeName;
+            UInt32 liveObjects;
+        };
+
         CoreObjectReferenceManager();
         ~CoreObjectReferenceManager();
 
-        void addReference(std::shared_ptr<CoreObject> object, OwnerType ownerType);
+        Handle addReference(std::shared_ptr<CoreObject> object, OwnerType ownerType);
         void removeReference(WeakPointer<CoreObject> object);
         void addReferenceOwner(WeakPointer<CoreObject> object);
-        void addReferenceOwner(UInt64 id);
+        void addReferenceOwner(Handle handle);
         UInt32 getReferenceCount(WeakPointer<CoreObject> object) const;
-        UInt32 getReferenceCount(UInt64 id) const;
+        UInt32 getReferenceCount(Handle handle) const;
+        Bool isValid(Handle handle) const;
+        CoreObject* get(Handle handle) const;
+        Handle getHandle(WeakPointer<CoreObject> object) const;
+        static const CoreObjectSlot* getSlot(const CoreObject* object);
+
+        UInt32 destroyReleasedObjects();
+        UInt32 getReleasedObjectCount() const;
+        UInt32 getLiveObjectCount() const;
+        UInt32 getLiveObjectCount(const std::type_info& type) const;
+        void getLiveObjectCounts(std::vector<TypeCount>& counts) const;
+
+        template <typename T>
+        UInt32 getLiveObjectCount() const {
+            return this->getLiveObjectCount(typeid(T));
+        }
 
     private:
-    
-        std::unordered_map<UInt64, UInt32> referenceCounts;
-        std::unordered_map<UInt64, UInt32> referenceIndex;
-        std::unordered_map<UInt64, OwnerType> referenceOwnerTypes;
-        std::vector<std::shared_ptr<CoreObject>> references;
 
+        static const UInt32 NoSlot = 0xFFFFFFFF;
+        static const UInt32 SlotBlockSize = 1024;
+
+        CoreObjectSlot& getSlotAt(UInt32 index) const;
+        CoreObjectSlot* findSlot(const CoreObject* object) const;
+        UInt32 getTypeIndex(const std::type_info& type);
+        void releaseSlot(CoreObjectSlot& slot);
+
+        // fixed-size blocks rather than one vector, so slots keep their address as the map grows
+        std::vector<std::unique_ptr<CoreObjectSlot[]>> slotBlocks;
+        UInt32 slotCount;
+        UInt32 freeListHead;
+        UInt32 liveObjectCount;
+        std::vector<UInt32> releasedSlots;
+        std::vector<UInt32> destroyingSlots;
+        std::vector<std::shared_ptr<CoreObject>> destroyingObjects;
+        std::unordered_map<std::type_index, UInt32> typeIndices;
+        std::vector<std::string> typeNames;
+        std::vector<UInt32> typeLiveCounts;
     };
 
 }
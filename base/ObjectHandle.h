@@ -0,0 +1,88 @@
+#pragma once
+
+#include <memory>
+
+#include "../common/types.h"
+#include "../common/Exception.h"
+#include "../util/WeakPointer.h"
+#include "CoreObjectReferenceManager.h"
+
+namespace Core {
+
+    /*
+     * Lightweight reference to a CoreObject registered with a CoreObjectReferenceManager: the object's address,
+     * its registration slot and the slot's generation at the time the handle was made. The handle follows the same
+     * rule as a WeakPointer to the object: it stays valid after the last owner releases the object and until the
+     * manager's destroyReleasedObjects() destroys it. Checking that is a single compare against the slot's
+     * generation, with no atomic reference count traffic. Use it in place of WeakPointer where an object is
+     * dereferenced or checked often; toWeakPointer() converts back for APIs that need one.
+     *
+     * Handles are not thread-safe against objects being destroyed concurrently.
+     */
+    template <typename T>
+    class ObjectHandle {
+    public:
+
+        template<typename U>
+        friend class ObjectHandle;
+
+        ObjectHandle(): object(nullptr), slot(nullptr), generation(0) {
+        }
+
+        template <typename U>
+        ObjectHandle(const ObjectHandle<U>& other): object(other.object), slot(other.slot), generation(other.generation) {
+        }
+
+        /*
+         * A null [pointer] gives a null handle. A valid object must be registered with a reference manager.
+         */
+        template <typename U>
+        ObjectHandle(const WeakPointer<U>& pointer): object(nullptr), slot(nullptr), generation(0) {
+            if (!pointer.isValid()) return;
+            U* target = const_cast<U*>(pointer.get());
+            this->slot = CoreObjectReferenceManager::getSlot(target);
+            if (this->slot == nullptr) {
+                throw InvalidArgumentException("ObjectHandle::ObjectHandle() -> Object is not registered with a reference manager.");
+            }
+            this->object = target;
+            this->generation = this->slot->generation;
+        }
+
+        Bool isValid() const {
+            return this->slot != nullptr && this->slot->generation == this->generation;
+        }
+
+        T* get() const {
+            if (!this->isValid()) {
+                throw NullPointerException("ObjectHandle::get() -> Handle is null or its object has been destroyed.");
+            }
+            return this->object;
+        }
+
+        T* operator ->() const {
+            return this->get();
+        }
+
+        WeakPointer<T> toWeakPointer() const {
+            if (!this->isValid()) return WeakPointer<T>::nullPtr();
+            return WeakPointer<T>(std::shared_ptr<T>(this->slot->object, this->object));
+        }
+
+        Bool operator ==(const ObjectHandle<T>& other) const {
+            return this->object == other.object && this->slot == other.slot && this->generation == other.generation;
+        }
+
+        Bool operator !=(const ObjectHandle<T>& other) const {
+            return !(*this == other);
+        }
+
+        static ObjectHandle nullHandle() {
+            return ObjectHandle();
+        }
+
+    private:
+        T* object;
+        const CoreObjectSlot* slot;
+        UInt32 generation;
+    };
+}
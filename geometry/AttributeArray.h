@@ -16,7 +16,7 @@ namespace Core {
 
     class AttributeArrayBase {
     public:
-        AttributeArrayBase(UInt32 attributeCount,  UInt32 componentCount): attributeCount(attributeCount), componentCount(componentCount) {
+        AttributeArrayBase(UInt32 attributeCount,  UInt32 componentCount): attributeCount(attributeCount), componentCount(componentCount), version(0) {
         }
 
         virtual ~AttributeArrayBase() {
@@ -35,9 +35,16 @@ namespace Core {
             return this->gpuStorage;
         }
 
+        // incremented every time the array's contents are pushed to GPU storage, so
+        // CPU-side caches derived from the data can detect that they are stale
+        UInt32 getVersion() const {
+            return this->version;
+        }
+
     protected:
         UInt32 attributeCount;
         UInt32 componentCount;
+        UInt32 version;
         PersistentWeakPointer<AttributeArrayGPUStorage> gpuStorage;
     };
 
@@ -107,11 +114,24 @@ namespace Core {
         }
 
         void updateGPUStorageData() {
+            this->version++;
             if (this->gpuStorage) {
                 this->gpuStorage->updateBufferData((void *)this->storage);
             }
         }
 
+        /*
+         * Upload only the first [attributeCount] attributes, for arrays whose live elements are packed at the front.
+         * The GPU copy of the attributes past them is left undefined.
+         */
+        void updateGPUStorageData(UInt32 attributeCount) {
+            this->version++;
+            if (this->gpuStorage) {
+                if (attributeCount > this->attributeCount) attributeCount = this->attributeCount;
+                this->gpuStorage->updateBufferRange(this->storage, 0, attributeCount * T::ComponentCount * sizeof(typename T::ComponentType));
+            }
+        }
+
         class iterator {
             AttributeArray<T>* array;
             UInt32 index;
@@ -278,11 +298,24 @@ namespace Core {
         }
 
         void updateGPUStorageData() {
+            this->version++;
             if (this->gpuStorage) {
                 this->gpuStorage->updateBufferData((void *)this->attributes);
             }
         }
 
+        /*
+         * Upload only the first [attributeCount] attributes, for arrays whose live elements are packed at the front.
+         * The GPU copy of the attributes past them is left undefined.
+         */
+        void updateGPUStorageData(UInt32 attributeCount) {
+            this->version++;
+            if (this->gpuStorage) {
+                if (attributeCount > this->attributeCount) attributeCount = this->attributeCount;
+                this->gpuStorage->updateBufferRange(this->attributes, 0, attributeCount * sizeof(T));
+            }
+        }
+
         class iterator {
             ScalarAttributeArray<T>* array;
             UInt32 index;
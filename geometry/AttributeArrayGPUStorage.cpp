@@ -2,8 +2,31 @@
 
 namespace Core {
 
+    const UInt32 AttributeArrayGPUStorage::RingBufferCount;
+
     AttributeArrayGPUStorage::~AttributeArrayGPUStorage() {
 
     }   
+
+    void AttributeArrayGPUStorage::setRingBuffered(Bool ringBuffered) {
+        this->ringBuffered = ringBuffered;
+    }
+
+    Bool AttributeArrayGPUStorage::isRingBuffered() const {
+        return this->ringBuffered;
+    }
+
+    const AttributeArrayGPUStorage::UploadStats& AttributeArrayGPUStorage::getUploadStats() const {
+        return this->uploadStats;
+    }
+
+    void AttributeArrayGPUStorage::resetUploadStats() {
+        this->uploadStats = UploadStats();
+    }
+
+    void AttributeArrayGPUStorage::recordUpload(UInt32 byteCount) {
+        this->uploadStats.uploads++;
+        this->uploadStats.bytesUploaded += byteCount;
+    }
     
-}
\ No newline at end of file
+}
@@ -8,10 +8,34 @@ namespace Core {
     class AttributeArrayGPUStorage : public CoreObject {
     public:
 
+        class UploadStats {
+        public:
+            UInt64 uploads = 0;
+            UInt64 bytesUploaded = 0;
+        };
+
+        // number of buffers a ring-buffered storage cycles through
+        static const UInt32 RingBufferCount = 3;
+
         virtual ~AttributeArrayGPUStorage() = 0;
         virtual Int32 getBufferID() const = 0;
         virtual void enableAndSendToActiveShader(UInt32 location) = 0;
+        virtual void enableAndSendToActiveShader(UInt32 location, UInt32 componentCount, UInt32 byteStride, UInt32 byteOffset) = 0;
         virtual void disable(UInt32 location) = 0;
         virtual void updateBufferData(void * data) = 0;
+        virtual void updateBufferRange(const void * data, UInt32 byteOffset, UInt32 byteCount) = 0;
+
+        void setRingBuffered(Bool ringBuffered);
+        Bool isRingBuffered() const;
+        const UploadStats& getUploadStats() const;
+        void resetUploadStats();
+
+    protected:
+        void recordUpload(UInt32 byteCount);
+
+        // when set, each upload goes to the next of 'RingBufferCount' buffers, and only the most recently
+        // uploaded range is valid for drawing
+        Bool ringBuffered = false;
+        UploadStats uploadStats;
     };
 }
@@ -1,4 +1,5 @@
 #include "Box3.h"
+#include "../math/Math.h"
 
 namespace Core {
 
@@ -60,4 +61,55 @@ namespace Core {
         return box.min.x >= this->min.x && box.min.y >= this->min.y && box.min.z >= this->min.z && box.max.x <= this->max.x && box.max.y <= this->max.y &&
                box.max.z <= this->max.z;
     }
+
+    Bool Box3::intersectsBox(const Box3& box) const {
+        return box.max.x >= this->min.x && box.min.x <= this->max.x &&
+               box.max.y >= this->min.y && box.min.y <= this->max.y &&
+               box.max.z >= this->min.z && box.min.z <= this->max.z;
+    }
+
+    Bool Box3::intersectsSphere(const Point3r& center, Real radius) const {
+        Real dx = center.x < this->min.x ? this->min.x - center.x : center.x > this->max.x ? center.x - this->max.x : 0.0f;
+        Real dy = center.y < this->min.y ? this->min.y - center.y : center.y > this->max.y ? center.y - this->max.y : 0.0f;
+        Real dz = center.z < this->min.z ? this->min.z - center.z : center.z > this->max.z ? center.z - this->max.z : 0.0f;
+        return dx * dx + dy * dy + dz * dz <= radius * radius;
+    }
+
+    void Box3::expandByPoint(const Point3r& point) {
+        this->min.set(Math::min(this->min.x, point.x), Math::min(this->min.y, point.y), Math::min(this->min.z, point.z));
+        this->max.set(Math::max(this->max.x, point.x), Math::max(this->max.y, point.y), Math::max(this->max.z, point.z));
+    }
+
+    void Box3::expandByBox(const Box3& box) {
+        this->min.set(Math::min(this->min.x, box.min.x), Math::min(this->min.y, box.min.y), Math::min(this->min.z, box.min.z));
+        this->max.set(Math::max(this->max.x, box.max.x), Math::max(this->max.y, box.max.y), Math::max(this->max.z, box.max.z));
+    }
+
+    /*
+     * Compute the axis-aligned box that encloses this box after it has been transformed by [matrix]
+     * and store it in [out]. Rather than transforming all eight corners, each output extent is built
+     * from the per-axis minimum and maximum contributions of the matrix columns (Arvo's method).
+     */
+    void Box3::transform(const Matrix4x4& matrix, Box3& out) const {
+        const Real* m = matrix.getConstData();
+        Real srcMin[] = {this->min.x, this->min.y, this->min.z};
+        Real srcMax[] = {this->max.x, this->max.y, this->max.z};
+        Real dstMin[] = {m[12], m[13], m[14]};
+        Real dstMax[] = {m[12], m[13], m[14]};
+        for (UInt32 row = 0; row < 3; row++) {
+            for (UInt32 col = 0; col < 3; col++) {
+                Real a = m[col * 4 + row] * srcMin[col];
+                Real b = m[col * 4 + row] * srcMax[col];
+                if (a < b) {
+                    dstMin[row] += a;
+                    dstMax[row] += b;
+                } else {
+                    dstMin[row] += b;
+                    dstMax[row] += a;
+                }
+            }
+        }
+        out.setMin(dstMin[0], dstMin[1], dstMin[2]);
+        out.setMax(dstMax[0], dstMax[1], dstMax[2]);
+    }
 }
@@ -2,6 +2,7 @@
 
 #include "../common/types.h"
 #include "Vector3.h"
+#include "../math/Matrix4x4.h"
 
 namespace Core {
 
@@ -24,6 +25,12 @@ namespace Core {
         Bool containsPoint(const Point3r& point, Real epsilon = 0.0f) const;
         Bool containsPoint(Real x, Real y, Real z, Real epsilon = 0.0f) const;
         Bool containsBox(const Box3& box) const;
+        Bool intersectsBox(const Box3& box) const;
+        Bool intersectsSphere(const Point3r& center, Real radius) const;
+
+        void expandByPoint(const Point3r& point);
+        void expandByBox(const Box3& box);
+        void transform(const Matrix4x4& matrix, Box3& out) const;
 
     private:
         Vector3r min;
@@ -0,0 +1,77 @@
+#include "Frustum.h"
+#include "../math/Math.h"
+
+namespace Core {
+
+    Frustum::Frustum() {
+        for (UInt32 i = 0; i < PlaneCount; i++) {
+            this->setPlane((FrustumPlane)i, 0.0f, 0.0f, 0.0f, 0.0f);
+        }
+    }
+
+    /*
+     * Extract the six clipping planes from [viewProjection] (projection * inverse camera transformation).
+     * The matrix is stored in column-major order, so row [r] of the matrix is composed of
+     * elements [r], [r + 4], [r + 8] and [r + 12].
+     */
+    void Frustum::setFromMatrix(const Matrix4x4& viewProjection) {
+        const Real* m = viewProjection.getConstData();
+        this->setPlane(FrustumPlane::Left, m[3] + m[0], m[7] + m[4], m[11] + m[8], m[15] + m[12]);
+        this->setPlane(FrustumPlane::Right, m[3] - m[0], m[7] - m[4], m[11] - m[8], m[15] - m[12]);
+        this->setPlane(FrustumPlane::Bottom, m[3] + m[1], m[7] + m[5], m[11] + m[9], m[15] + m[13]);
+        this->setPlane(FrustumPlane::Top, m[3] - m[1], m[7] - m[5], m[11] - m[9], m[15] - m[13]);
+        this->setPlane(FrustumPlane::Near, m[3] + m[2], m[7] + m[6], m[11] + m[10], m[15] + m[14]);
+        this->setPlane(FrustumPlane::Far, m[3] - m[2], m[7] - m[6], m[11] - m[10], m[15] - m[14]);
+    }
+
+    void Frustum::setPlane(FrustumPlane plane, Real x, Real y, Real z, Real d) {
+        Real mag = Math::squareRoot(x * x + y * y + z * z);
+        if (mag > 0.0f) {
+            x /= mag;
+            y /= mag;
+            z /= mag;
+            d /= mag;
+        }
+        Real* eq = this->planes[(UInt32)plane];
+        eq[0] = x;
+        eq[1] = y;
+        eq[2] = z;
+        eq[3] = d;
+    }
+
+    Vector4r Frustum::getPlane(FrustumPlane plane) const {
+        const Real* eq = this->planes[(UInt32)plane];
+        return Vector4r(eq[0], eq[1], eq[2], eq[3]);
+    }
+
+    Bool Frustum::containsPoint(const Point3r& point) const {
+        return this->intersectsSphere(point, 0.0f);
+    }
+
+    Bool Frustum::intersectsSphere(const Point3r& center, Real radius) const {
+        for (UInt32 i = 0; i < PlaneCount; i++) {
+            const Real* eq = this->planes[i];
+            Real distance = eq[0] * center.x + eq[1] * center.y + eq[2] * center.z + eq[3];
+            if (distance < -radius) return false;
+        }
+        return true;
+    }
+
+    /*
+     * Conservative box test: for each plane, test the corner of [box] that lies furthest along the
+     * plane's normal. If that corner is behind any plane, the box is entirely outside the frustum.
+     */
+    Bool Frustum::intersectsBox(const Box3& box) const {
+        const Vector3r& min = box.getMin();
+        const Vector3r& max = box.getMax();
+        for (UInt32 i = 0; i < PlaneCount; i++) {
+            const Real* eq = this->planes[i];
+            Real px = eq[0] >= 0.0f ? max.x : min.x;
+            Real py = eq[1] >= 0.0f ? max.y : min.y;
+            Real pz = eq[2] >= 0.0f ? max.z : min.z;
+            if (eq[0] * px + eq[1] * py + eq[2] * pz + eq[3] < 0.0f) return false;
+        }
+        return true;
+    }
+
+}
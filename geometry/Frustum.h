@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../common/types.h"
+#include "../math/Matrix4x4.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Box3.h"
+
+namespace Core {
+
+    class Frustum {
+    public:
+
+        enum class FrustumPlane {
+            Left = 0,
+            Right = 1,
+            Bottom = 2,
+            Top = 3,
+            Near = 4,
+            Far = 5
+        };
+
+        static const UInt32 PlaneCount = 6;
+
+        Frustum();
+
+        void setFromMatrix(const Matrix4x4& viewProjection);
+        void setPlane(FrustumPlane plane, Real x, Real y, Real z, Real d);
+        Vector4r getPlane(FrustumPlane plane) const;
+
+        Bool containsPoint(const Point3r& point) const;
+        Bool intersectsSphere(const Point3r& center, Real radius) const;
+        Bool intersectsBox(const Box3& box) const;
+
+    private:
+        // planes are stored as raw (normalized) plane equations so the containment
+        // tests stay as tight as possible, normals point towards the inside of the frustum
+        Real planes[PlaneCount][4];
+    };
+
+}
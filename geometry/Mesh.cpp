@@ -5,6 +5,7 @@
 #include "Vector3.h"
 #include "IndexBuffer.h"
 #include "IndexBuffer.h"
+#include "MeshBVH.h"
 #include "../math/Math.h"
 #include "../common/Constants.h"
 
@@ -19,6 +20,9 @@ namespace Core {
         this->shouldCalculateNormals = false;
         this->shouldCalculateTangents = false;
         this->shouldCalculateBounds = false;
+        this->boundingBoxCalculated = false;
+        this->bvhValid = false;
+        this->bvhPositionsVersion = 0;
         initAttributes();
     }
 
@@ -100,12 +104,17 @@ namespace Core {
 
         this->boundingBox.setMin(min);
         this->boundingBox.setMax(max);
+        this->boundingBoxCalculated = true;
     }
 
     const Box3& Mesh::getBoundingBox() const {
         return this->boundingBox;
     }
 
+    Bool Mesh::hasBoundingBox() const {
+        return this->boundingBoxCalculated;
+    }
+
     void Mesh::calculateBoundingSphere() {
         Point3r center;
         Vector3r centerToNewPoint;
@@ -141,6 +150,27 @@ namespace Core {
         return this->boundingSphere;
     }
 
+    /*
+     * Get the triangle BVH for this mesh, building it on first use. The tree is rebuilt lazily
+     * whenever the vertex positions have been re-uploaded since the last build or invalidateBVH() was called.
+     */
+    WeakPointer<MeshBVH> Mesh::getBVH() {
+        UInt32 positionsVersion = this->vertexPositions ? this->vertexPositions->getVersion() : 0;
+        if (!this->bvh) {
+            this->bvh = std::make_shared<MeshBVH>();
+        }
+        if (!this->bvhValid || this->bvhPositionsVersion != positionsVersion) {
+            this->bvh->build(*this);
+            this->bvhPositionsVersion = positionsVersion;
+            this->bvhValid = true;
+        }
+        return this->bvh;
+    }
+
+    void Mesh::invalidateBVH() {
+        this->bvhValid = false;
+    }
+
     WeakPointer<AttributeArray<Point3rs>> Mesh::getVertexPositions() {
         return this->vertexPositions;
     }
@@ -214,6 +244,7 @@ namespace Core {
     }
 
     void Mesh::update() {
+        this->invalidateBVH();
         if (this->shouldCalculateBounds) {
             this->calculateBoundingBox();
             this->calculateBoundingSphere();
@@ -229,6 +260,7 @@ namespace Core {
     }
 
     void Mesh::reverseVertexAttributeWindingOrder() {
+        this->invalidateBVH();
         UInt32 realVertexCount = this->vertexCount;
         WeakPointer<IndexBuffer> indices;
         if (this->indexed) {
@@ -22,6 +22,7 @@ namespace Core {
     class Engine;
     class Object3D;
     class IndexBuffer;
+    class MeshBVH;
 
     class Mesh : public BaseRenderable {
         friend class Engine;
@@ -58,10 +59,14 @@ namespace Core {
 
         void calculateBoundingBox();
         const Box3& getBoundingBox() const;
+        Bool hasBoundingBox() const;
 
         void calculateBoundingSphere();
         const Vector4r& getBoundingSphere() const;
 
+        WeakPointer<MeshBVH> getBVH();
+        void invalidateBVH();
+
         void setNormalsSmoothingThreshold(Real threshold);
         void setCalculateNormals(Bool calculateNormals);
         void setCalculateTangents(Bool calculateTangents);
@@ -102,7 +107,11 @@ namespace Core {
         Bool indexed;
         UInt32 indexCount;
         Box3 boundingBox;
+        Bool boundingBoxCalculated;
         Vector4r boundingSphere;
+        std::shared_ptr<MeshBVH> bvh;
+        Bool bvhValid;
+        UInt32 bvhPositionsVersion;
 
         std::shared_ptr<AttributeArray<Point3rs>> vertexPositions;
         std::shared_ptr<AttributeArray<Vector3rs>> vertexNormals;
@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <limits>
+
+#include "MeshBVH.h"
+#include "Mesh.h"
+#include "Ray.h"
+#include "IndexBuffer.h"
+
+namespace Core {
+
+    MeshBVH::MeshBVH() {
+    }
+
+    /*
+     * (Re)build the hierarchy from the current vertex positions of [mesh]. Triangles are split at the
+     * median centroid along the longest axis of their centroid bounds until a node holds at most
+     * MaxTrianglesPerLeaf triangles, which keeps the tree balanced regardless of triangle distribution.
+     */
+    void MeshBVH::build(Mesh& mesh) {
+        this->clear();
+
+        WeakPointer<AttributeArray<Point3rs>> vertexPositions = mesh.getVertexPositions();
+        if (!vertexPositions.isValid()) return;
+        Point3rs * vertices = vertexPositions->getAttributes();
+
+        UInt32 vertexReferenceCount = vertexPositions->getAttributeCount();
+        WeakPointer<IndexBuffer> indices;
+        if (mesh.isIndexed()) {
+            indices = mesh.getIndexBuffer();
+            vertexReferenceCount = indices->getSize();
+        }
+
+        UInt32 triangleCount = vertexReferenceCount / 3;
+        if (triangleCount == 0) return;
+
+        std::vector<Real> sourceTriangles(triangleCount * 9);
+        std::vector<Real> centroids(triangleCount * 3);
+        std::vector<UInt32> order(triangleCount);
+        for (UInt32 t = 0; t < triangleCount; t++) {
+            Real* triangle = sourceTriangles.data() + t * 9;
+            for (UInt32 v = 0; v < 3; v++) {
+                UInt32 vertexIndex = mesh.isIndexed() ? indices->getIndex(t * 3 + v) : t * 3 + v;
+                Point3rs& vertex = *(vertices + vertexIndex);
+                triangle[v * 3] = vertex.x;
+                triangle[v * 3 + 1] = vertex.y;
+                triangle[v * 3 + 2] = vertex.z;
+            }
+            for (UInt32 axis = 0; axis < 3; axis++) {
+                centroids[t * 3 + axis] = (triangle[axis] + triangle[3 + axis] + triangle[6 + axis]) / 3.0f;
+            }
+            order[t] = t;
+        }
+
+        this->nodes.reserve(triangleCount / MaxTrianglesPerLeaf * 2 + 1);
+        this->buildNode(0, triangleCount, sourceTriangles, centroids, order);
+
+        this->triangles.resize(triangleCount * 9);
+        for (UInt32 t = 0; t < triangleCount; t++) {
+            std::copy(sourceTriangles.begin() + order[t] * 9, sourceTriangles.begin() + order[t] * 9 + 9, this->triangles.begin() + t * 9);
+        }
+
+        const Node& root = this->nodes[0];
+        this->bounds.setMin(root.min[0], root.min[1], root.min[2]);
+        this->bounds.setMax(root.max[0], root.max[1], root.max[2]);
+    }
+
+    void MeshBVH::clear() {
+        this->nodes.clear();
+        this->triangles.clear();
+        this->bounds.setMin(0.0f, 0.0f, 0.0f);
+        this->bounds.setMax(0.0f, 0.0f, 0.0f);
+    }
+
+    Bool MeshBVH::isEmpty() const {
+        return this->nodes.size() == 0;
+    }
+
+    UInt32 MeshBVH::getTriangleCount() const {
+        return (UInt32)this->triangles.size() / 9;
+    }
+
+    UInt32 MeshBVH::getNodeCount() const {
+        return (UInt32)this->nodes.size();
+    }
+
+    const Box3& MeshBVH::getBounds() const {
+        return this->bounds;
+    }
+
+    /*
+     * Intersect [ray] (in the mesh's local space) with the hierarchy. Hit distances are expressed in units
+     * of the ray's direction vector, and only hits closer than [maxDistance] are reported. Back-facing
+     * triangles are ignored, matching Ray::intersectTriangle(). In closest-hit mode a single hit is appended
+     * and subtrees farther away than the best hit found so far are skipped.
+     */
+    Bool MeshBVH::intersectRay(const Ray& ray, Bool closestHitOnly, Real maxDistance, std::vector<Hit>& hits) const {
+        if (this->nodes.size() == 0) return false;
+
+        Real origin[] = {ray.Origin.x, ray.Origin.y, ray.Origin.z};
+        Real direction[] = {ray.Direction.x, ray.Direction.y, ray.Direction.z};
+        Real inverseDirection[3];
+        for (UInt32 i = 0; i < 3; i++) {
+            inverseDirection[i] = direction[i] != 0.0f ? 1.0f / direction[i] :
+                                  (direction[i] < 0.0f ? -std::numeric_limits<Real>::max() : std::numeric_limits<Real>::max());
+        }
+
+        Real closestDistance = maxDistance;
+        Bool hitFound = false;
+        Real closestTriangle[9];
+
+        UInt32 nodeStack[MaxTraversalDepth];
+        UInt32 stackSize = 0;
+        Real tNear;
+        if (!intersectNode(this->nodes[0], origin, inverseDirection, closestDistance, tNear)) return false;
+        nodeStack[stackSize++] = 0;
+
+        while (stackSize > 0) {
+            UInt32 nodeIndex = nodeStack[--stackSize];
+            const Node& node = this->nodes[nodeIndex];
+            if (closestHitOnly && !intersectNode(node, origin, inverseDirection, closestDistance, tNear)) continue;
+
+            if (node.triangleCount > 0) {
+                const Real* triangle = this->triangles.data() + node.firstTriangle * 9;
+                for (UInt32 i = 0; i < node.triangleCount; i++, triangle += 9) {
+                    // Moller-Trumbore; [det] equals dot(direction, faceNormal) so its sign gives the facing
+                    Real e1[] = {triangle[3] - triangle[0], triangle[4] - triangle[1], triangle[5] - triangle[2]};
+                    Real e2[] = {triangle[6] - triangle[0], triangle[7] - triangle[1], triangle[8] - triangle[2]};
+                    Real p[] = {direction[1] * e2[2] - direction[2] * e2[1],
+                                direction[2] * e2[0] - direction[0] * e2[2],
+                                direction[0] * e2[1] - direction[1] * e2[0]};
+                    Real det = e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2];
+                    if (det >= 0.0f) continue;
+
+                    Real invDet = 1.0f / det;
+                    Real s[] = {origin[0] - triangle[0], origin[1] - triangle[1], origin[2] - triangle[2]};
+                    Real u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * invDet;
+                    if (u < 0.0f || u > 1.0f) continue;
+
+                    Real q[] = {s[1] * e1[2] - s[2] * e1[1],
+                                s[2] * e1[0] - s[0] * e1[2],
+                                s[0] * e1[1] - s[1] * e1[0]};
+                    Real v = (direction[0] * q[0] + direction[1] * q[1] + direction[2] * q[2]) * invDet;
+                    if (v < 0.0f || u + v > 1.0f) continue;
+
+                    Real t = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * invDet;
+                    if (t < 0.0f || t > closestDistance) continue;
+
+                    if (closestHitOnly) {
+                        closestDistance = t;
+                        std::copy(triangle, triangle + 9, closestTriangle);
+                    } else {
+                        hits.emplace_back();
+                        Hit& hit = hits.back();
+                        hit.Origin.set(origin[0] + direction[0] * t, origin[1] + direction[1] * t, origin[2] + direction[2] * t);
+                        hit.Normal.set(e2[1] * e1[2] - e2[2] * e1[1], e2[2] * e1[0] - e2[0] * e1[2], e2[0] * e1[1] - e2[1] * e1[0]);
+                        hit.Distance = t;
+                    }
+                    hitFound = true;
+                }
+                continue;
+            }
+
+            UInt32 leftChild = nodeIndex + 1;
+            UInt32 rightChild = node.rightChild;
+            Real leftNear, rightNear;
+            Bool hitLeft = intersectNode(this->nodes[leftChild], origin, inverseDirection, closestDistance, leftNear);
+            Bool hitRight = intersectNode(this->nodes[rightChild], origin, inverseDirection, closestDistance, rightNear);
+
+            // push the farther child first so the nearer one is visited next
+            if (hitLeft && hitRight) {
+                if (leftNear <= rightNear) {
+                    nodeStack[stackSize++] = rightChild;
+                    nodeStack[stackSize++] = leftChild;
+                } else {
+                    nodeStack[stackSize++] = leftChild;
+                    nodeStack[stackSize++] = rightChild;
+                }
+            }
+            else if (hitLeft) nodeStack[stackSize++] = leftChild;
+            else if (hitRight) nodeStack[stackSize++] = rightChild;
+        }
+
+        if (closestHitOnly && hitFound) {
+            const Real* triangle = closestTriangle;
+            Real e1[] = {triangle[3] - triangle[0], triangle[4] - triangle[1], triangle[5] - triangle[2]};
+            Real e2[] = {triangle[6] - triangle[0], triangle[7] - triangle[1], triangle[8] - triangle[2]};
+            hits.emplace_back();
+            Hit& hit = hits.back();
+            hit.Origin.set(origin[0] + direction[0] * closestDistance, origin[1] + direction[1] * closestDistance,
+                           origin[2] + direction[2] * closestDistance);
+            hit.Normal.set(e2[1] * e1[2] - e2[2] * e1[1], e2[2] * e1[0] - e2[0] * e1[2], e2[0] * e1[1] - e2[1] * e1[0]);
+            hit.Distance = closestDistance;
+        }
+
+        return hitFound;
+    }
+
+    UInt32 MeshBVH::buildNode(UInt32 start, UInt32 count, const std::vector<Real>& sourceTriangles,
+                              const std::vector<Real>& centroids, std::vector<UInt32>& order) {
+        UInt32 nodeIndex = (UInt32)this->nodes.size();
+        this->nodes.emplace_back();
+
+        Real boundsMin[] = {std::numeric_limits<Real>::max(), std::numeric_limits<Real>::max(), std::numeric_limits<Real>::max()};
+        Real boundsMax[] = {-std::numeric_limits<Real>::max(), -std::numeric_limits<Real>::max(), -std::numeric_limits<Real>::max()};
+        Real centroidMin[] = {boundsMin[0], boundsMin[1], boundsMin[2]};
+        Real centroidMax[] = {boundsMax[0], boundsMax[1], boundsMax[2]};
+        for (UInt32 i = start; i < start + count; i++) {
+            const Real* triangle = sourceTriangles.data() + order[i] * 9;
+            const Real* centroid = centroids.data() + order[i] * 3;
+            for (UInt32 axis = 0; axis < 3; axis++) {
+                for (UInt32 v = 0; v < 3; v++) {
+                    boundsMin[axis] = std::min(boundsMin[axis], triangle[v * 3 + axis]);
+                    boundsMax[axis] = std::max(boundsMax[axis], triangle[v * 3 + axis]);
+                }
+                centroidMin[axis] = std::min(centroidMin[axis], centroid[axis]);
+                centroidMax[axis] = std::max(centroidMax[axis], centroid[axis]);
+            }
+        }
+
+        Node& node = this->nodes[nodeIndex];
+        for (UInt32 axis = 0; axis < 3; axis++) {
+            node.min[axis] = boundsMin[axis];
+            node.max[axis] = boundsMax[axis];
+        }
+        node.firstTriangle = start;
+        node.triangleCount = count;
+        node.rightChild = 0;
+
+        UInt32 splitAxis = 0;
+        for (UInt32 axis = 1; axis < 3; axis++) {
+            if (centroidMax[axis] - centroidMin[axis] > centroidMax[splitAxis] - centroidMin[splitAxis]) splitAxis = axis;
+        }
+        if (count <= MaxTrianglesPerLeaf || centroidMax[splitAxis] - centroidMin[splitAxis] <= 0.0f) return nodeIndex;
+
+        UInt32 middle = start + count / 2;
+        std::nth_element(order.begin() + start, order.begin() + middle, order.begin() + start + count, [&centroids, splitAxis](UInt32 a, UInt32 b) {
+            return centroids[a * 3 + splitAxis] < centroids[b * 3 + splitAxis];
+        });
+
+        this->buildNode(start, middle - start, sourceTriangles, centroids, order);
+        UInt32 rightChild = this->buildNode(middle, start + count - middle, sourceTriangles, centroids, order);
+
+        // [node] may have been invalidated by the recursive calls growing [nodes]
+        this->nodes[nodeIndex].triangleCount = 0;
+        this->nodes[nodeIndex].rightChild = rightChild;
+        return nodeIndex;
+    }
+
+    Bool MeshBVH::intersectNode(const Node& node, const Real* origin, const Real* inverseDirection, Real maxDistance, Real& tNear) {
+        Real tMin = 0.0f;
+        Real tMax = maxDistance;
+        for (UInt32 axis = 0; axis < 3; axis++) {
+            Real t0 = (node.min[axis] - origin[axis]) * inverseDirection[axis];
+            Real t1 = (node.max[axis] - origin[axis]) * inverseDirection[axis];
+            if (t0 > t1) std::swap(t0, t1);
+            tMin = t0 > tMin ? t0 : tMin;
+            tMax = t1 < tMax ? t1 : tMax;
+            if (tMin > tMax) return false;
+        }
+        tNear = tMin;
+        return true;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+
+#include "../common/types.h"
+#include "Box3.h"
+#include "Hit.h"
+
+namespace Core {
+
+    // forward declarations
+    class Mesh;
+    class Ray;
+
+    /*
+     * Bounding volume hierarchy over the triangles of a single mesh, expressed in the mesh's local space.
+     * Nodes are stored depth-first so a node's left child always immediately follows it; triangle
+     * vertices are copied into leaf order so traversal never touches the mesh's attribute arrays.
+     */
+    class MeshBVH {
+    public:
+        static const UInt32 MaxTrianglesPerLeaf = 4;
+
+        MeshBVH();
+
+        void build(Mesh& mesh);
+        void clear();
+        Bool isEmpty() const;
+        UInt32 getTriangleCount() const;
+        UInt32 getNodeCount() const;
+        const Box3& getBounds() const;
+
+        Bool intersectRay(const Ray& ray, Bool closestHitOnly, Real maxDistance, std::vector<Hit>& hits) const;
+
+    private:
+        static const UInt32 MaxTraversalDepth = 64;
+
+        class Node {
+        public:
+            Real min[3];
+            Real max[3];
+            UInt32 firstTriangle;
+            UInt32 triangleCount;
+            UInt32 rightChild;
+        };
+
+        UInt32 buildNode(UInt32 start, UInt32 count, const std::vector<Real>& sourceTriangles,
+                         const std::vector<Real>& centroids, std::vector<UInt32>& order);
+        static Bool intersectNode(const Node& node, const Real* origin, const Real* inverseDirection, Real maxDistance, Real& tNear);
+
+        std::vector<Node> nodes;
+        std::vector<Real> triangles;
+        Box3 bounds;
+    };
+}
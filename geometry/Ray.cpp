@@ -1,3 +1,5 @@
+#include <limits>
+
 #include "Ray.h"
 #include "Mesh.h"
 #include "AttributeArray.h"
@@ -66,6 +68,40 @@ namespace Core {
         return false;
     }
 
+    /*
+     * Slab test of this ray against [box]. On success [tNear] and [tFar] hold the parametric
+     * entry and exit distances along Direction; [tNear] is clamped to zero when the origin is inside the box.
+     */
+    Bool Ray::intersectBox(const Box3& box, Real& tNear, Real& tFar) const {
+        const Vector3r& min = box.getMin();
+        const Vector3r& max = box.getMax();
+        Real origin[] = {this->Origin.x, this->Origin.y, this->Origin.z};
+        Real dir[] = {this->Direction.x, this->Direction.y, this->Direction.z};
+        Real bMin[] = {min.x, min.y, min.z};
+        Real bMax[] = {max.x, max.y, max.z};
+
+        tNear = 0.0f;
+        tFar = std::numeric_limits<Real>::max();
+        for (UInt32 i = 0; i < 3; i++) {
+            if (dir[i] == 0.0f) {
+                if (origin[i] < bMin[i] || origin[i] > bMax[i]) return false;
+                continue;
+            }
+            Real invDir = 1.0f / dir[i];
+            Real t0 = (bMin[i] - origin[i]) * invDir;
+            Real t1 = (bMax[i] - origin[i]) * invDir;
+            if (t0 > t1) {
+                Real temp = t0;
+                t0 = t1;
+                t1 = temp;
+            }
+            if (t0 > tNear) tNear = t0;
+            if (t1 < tFar) tFar = t1;
+            if (tNear > tFar) return false;
+        }
+        return true;
+    }
+
     Bool Ray::intersectTriangle(const Point3r& p0, const Point3r& p1,
                                 const Point3r& p2, Hit& hit) const {
         Vector3r q1 = p2 - p0;
@@ -23,6 +23,7 @@ namespace Core {
         }
         Bool intersectMesh(WeakPointer<Mesh> mesh, std::vector<Hit>& hits) const;
         Bool intersectBox(const Box3& box, Hit& hit) const;
+        Bool intersectBox(const Box3& box, Real& tNear, Real& tFar) const;
         
         Bool intersectTriangle(const Point3r& p0, const Point3r& p1,
                                const Point3r& p2, Hit& hit) const;
@@ -1,3 +1,5 @@
+#include <limits>
+
 #include "DirectionalLight.h"
 #include "../Engine.h"
 #include "../render/RenderTarget2D.h"
@@ -7,6 +9,7 @@
 #include "../geometry/Vector3.h"
 #include "../geometry/Vector4.h"
 #include "../math/Math.h"
+#include "../geometry/Box3.h"
 
 namespace Core {
 
@@ -18,6 +21,7 @@ namespace Core {
             this->projections.push_back(DirectionalLight::OrthoProjection());
             this->viewProjectionMatrices.push_back(Matrix4x4());
             this->cascadeBoundaries.push_back(0.0f);
+            this->shadowCasterCounts.push_back(0);
         }
         // [cascadeBoundaries] gets 1 extra
         this->cascadeBoundaries.push_back(0.0f);
@@ -175,6 +179,28 @@ namespace Core {
         return this->viewProjectionMatrices[cascadeIndex];
     }
 
+    /*
+     * The light space box that contains every caster that can cast a shadow into the cascade: the cascade's
+     * orthographic projection, extruded toward the light without limit so casters outside the projection's
+     * depth range, between the light and the view, are kept.
+     */
+    void DirectionalLight::getShadowCasterVolume(UInt32 cascadeIndex, Box3& outLightSpaceVolume) const {
+        if (cascadeIndex >= this->cascadeCount) {
+            throw OutOfRangeException("DirectionalLight::getShadowCasterVolume() -> 'cascadeIndex' is out of range.");
+        }
+        const OrthoProjection& projection = this->projections[cascadeIndex];
+        // the light looks down its -Z axis
+        outLightSpaceVolume.setMin(projection.left, projection.bottom, -projection.far);
+        outLightSpaceVolume.setMax(projection.right, projection.top, std::numeric_limits<Real>::max());
+    }
+
+    UInt32 DirectionalLight::getShadowCasterCount(UInt32 cascadeIndex) const {
+        if (cascadeIndex >= this->cascadeCount) {
+            throw OutOfRangeException("DirectionalLight::getShadowCasterCount() -> 'cascadeIndex' is out of range.");
+        }
+        return this->shadowCasterCounts[cascadeIndex];
+    }
+
     Real DirectionalLight::getCascadeBoundary(UInt32 boundaryIndex) {
         if (boundaryIndex >= this->cascadeBoundaries.size()) {
             throw OutOfRangeException("DirectionalLight::getCascadeBoundary() -> 'boundaryIndex' is out of range.");
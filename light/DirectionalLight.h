@@ -15,9 +15,12 @@ namespace Core {
     class Engine;
     class RenderTarget2D;
     class Camera;
+    class Renderer;
+    class Box3;
 
     class DirectionalLight final : public ShadowLight {
         friend class Engine;
+        friend class Renderer;
 
     public:
         class OrthoProjection {
@@ -41,6 +44,8 @@ namespace Core {
         std::vector<OrthoProjection>& buildProjections(WeakPointer<Camera> targetCamera);
         OrthoProjection& getProjection(UInt32 cascadeIndex);
         Matrix4x4& getViewProjectionMatrix(UInt32 cascadeIndex);
+        void getShadowCasterVolume(UInt32 cascadeIndex, Box3& outLightSpaceVolume) const;
+        UInt32 getShadowCasterCount(UInt32 cascadeIndex) const;
 
         Real getCascadeBoundary(UInt32 boundaryIndex);
 
@@ -53,6 +58,8 @@ namespace Core {
         std::vector<OrthoProjection> projections;
         std::vector<Matrix4x4> viewProjectionMatrices;
         std::vector<Real> cascadeBoundaries;
+        // shadow casters drawn into each cascade the last time its shadow map was rendered
+        std::vector<UInt32> shadowCasterCounts;
         UInt32 cascadeCount;
         Real shadowMapBoundaryPadding;
         Real shadowMapBoundaryHorizontalPadding;
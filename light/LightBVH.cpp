@@ -0,0 +1,117 @@
+#include <algorithm>
+
+#include "LightBVH.h"
+#include "PointLight.h"
+#include "../scene/Object3D.h"
+#include "../math/Math.h"
+#include "../common/Exception.h"
+
+namespace Core {
+
+    const UInt32 LightBVH::MaxLeafSize;
+
+    void LightBVH::build(const std::vector<WeakPointer<PointLight>>& lights) {
+        this->clear();
+        UInt32 lightCount = lights.size();
+        this->lightBounds.resize(lightCount);
+        this->lightPositions.resize(lightCount);
+        for (UInt32 i = 0; i < lightCount; i++) {
+            WeakPointer<PointLight> light = lights[i];
+            // the translation of the light's world matrix, which the scene traversal has already computed
+            const Real* worldMatrix = light->getOwner()->getTransform().getConstWorldMatrix().getConstData();
+            Point3r position(worldMatrix[12], worldMatrix[13], worldMatrix[14]);
+            LightBounds& bounds = this->lightBounds[i];
+            bounds.center = position;
+            bounds.radius = light->getRadius();
+            bounds.lightIndex = i;
+            this->lightPositions[i] = position;
+        }
+        if (lightCount > 0) {
+            this->nodes.reserve(2 * (lightCount / MaxLeafSize + 1));
+            this->buildNode(0, lightCount);
+        }
+    }
+
+    void LightBVH::clear() {
+        this->lightBounds.resize(0);
+        this->lightPositions.resize(0);
+        this->nodes.resize(0);
+    }
+
+    void LightBVH::queryLightsInRange(const Point3r& center, Real radius, std::vector<UInt32>& outLightIndices) const {
+        if (this->nodes.size() == 0) return;
+        // the tree is balanced, so its depth is logarithmic in the light count
+        UInt32 stack[64];
+        UInt32 stackSize = 0;
+        stack[stackSize++] = 0;
+        while (stackSize > 0) {
+            const Node& node = this->nodes[stack[--stackSize]];
+            if (!node.bounds.intersectsSphere(center, radius)) continue;
+            if (node.secondChild == 0) {
+                for (UInt32 i = node.start; i < node.start + node.count; i++) {
+                    const LightBounds& bounds = this->lightBounds[i];
+                    Vector3r toLight = bounds.center - center;
+                    Real range = bounds.radius + radius;
+                    if (toLight.x * toLight.x + toLight.y * toLight.y + toLight.z * toLight.z <= range * range) {
+                        outLightIndices.push_back(bounds.lightIndex);
+                    }
+                }
+            } else {
+                stack[stackSize++] = node.secondChild;
+                stack[stackSize++] = (UInt32)(&node - &this->nodes[0]) + 1;
+            }
+        }
+    }
+
+    const Point3r& LightBVH::getLightPosition(UInt32 lightIndex) const {
+        if (lightIndex >= this->lightPositions.size()) {
+            throw OutOfRangeException("LightBVH::getLightPosition() -> 'lightIndex' is out of range.");
+        }
+        return this->lightPositions[lightIndex];
+    }
+
+    UInt32 LightBVH::getLightCount() const {
+        return this->lightBounds.size();
+    }
+
+    UInt32 LightBVH::getNodeCount() const {
+        return this->nodes.size();
+    }
+
+    UInt32 LightBVH::buildNode(UInt32 start, UInt32 count) {
+        UInt32 nodeIndex = this->nodes.size();
+        this->nodes.emplace_back();
+
+        const LightBounds& first = this->lightBounds[start];
+        Box3 bounds(first.center.x - first.radius, first.center.y - first.radius, first.center.z - first.radius,
+                    first.center.x + first.radius, first.center.y + first.radius, first.center.z + first.radius);
+        Box3 centerBounds(first.center.x, first.center.y, first.center.z, first.center.x, first.center.y, first.center.z);
+        for (UInt32 i = start + 1; i < start + count; i++) {
+            const LightBounds& light = this->lightBounds[i];
+            bounds.expandByPoint(Point3r(light.center.x - light.radius, light.center.y - light.radius, light.center.z - light.radius));
+            bounds.expandByPoint(Point3r(light.center.x + light.radius, light.center.y + light.radius, light.center.z + light.radius));
+            centerBounds.expandByPoint(light.center);
+        }
+
+        UInt32 secondChild = 0;
+        if (count > MaxLeafSize) {
+            Vector3r extent = centerBounds.getMax() - centerBounds.getMin();
+            UInt32 axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+            UInt32 half = count / 2;
+            std::nth_element(this->lightBounds.begin() + start, this->lightBounds.begin() + start + half,
+                             this->lightBounds.begin() + start + count, [axis](const LightBounds& a, const LightBounds& b) {
+                return axis == 0 ? a.center.x < b.center.x : (axis == 1 ? a.center.y < b.center.y : a.center.z < b.center.z);
+            });
+            this->buildNode(start, half);
+            secondChild = this->buildNode(start + half, count - half);
+        }
+
+        // 'nodes' may have grown while building the children
+        Node& node = this->nodes[nodeIndex];
+        node.bounds = bounds;
+        node.start = start;
+        node.count = count;
+        node.secondChild = secondChild;
+        return nodeIndex;
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include "../common/types.h"
+#include "../util/WeakPointer.h"
+#include "../geometry/Vector3.h"
+#include "../geometry/Box3.h"
+
+namespace Core {
+
+    // forward declarations
+    class PointLight;
+
+    /*
+     * Bounding volume hierarchy over the bounding spheres (world position and radius) of a list of point lights.
+     * It is rebuilt from scratch every frame: each node splits its lights at the median along the longest axis of
+     * their centers, so the tree stays balanced however the lights have moved. Nodes are stored depth-first in a
+     * flat array with the lights of every subtree contiguous, so a query is a stack-based walk that only descends
+     * into nodes whose box touches the query sphere.
+     */
+    class LightBVH {
+    public:
+        static const UInt32 MaxLeafSize = 4;
+
+        void build(const std::vector<WeakPointer<PointLight>>& lights);
+        void clear();
+
+        /*
+         * Append to [outLightIndices] the index (in the list passed to build()) of every light whose sphere
+         * intersects the sphere at [center] with [radius].
+         */
+        void queryLightsInRange(const Point3r& center, Real radius, std::vector<UInt32>& outLightIndices) const;
+
+        const Point3r& getLightPosition(UInt32 lightIndex) const;
+        UInt32 getLightCount() const;
+        UInt32 getNodeCount() const;
+
+    private:
+        class LightBounds {
+        public:
+            Point3r center;
+            Real radius;
+            UInt32 lightIndex;
+        };
+
+        class Node {
+        public:
+            Box3 bounds;
+            UInt32 start;
+            UInt32 count;
+            // index of the second child; the first always directly follows its parent. 0 for leaves.
+            UInt32 secondChild;
+        };
+
+        UInt32 buildNode(UInt32 start, UInt32 count);
+
+        std::vector<LightBounds> lightBounds;
+        std::vector<Node> nodes;
+        // indexed by the light's position in the list passed to build()
+        std::vector<Point3r> lightPositions;
+    };
+}
@@ -28,7 +28,12 @@ namespace Core {
             this->ambientLights.resize(0);
             this->ambientIBLLights.resize(0);
             this->shadowLights.resize(0);
+            this->nonIBLLights.resize(0);
             this->lights.resize(0);
+            this->typedLightIndices.resize(0);
+            this->shadowLightIndices.resize(0);
+            this->pointLightIndices.resize(0);
+            this->lightAssignmentID = 0;
         }
 
         UInt32 lightCount() const {
@@ -46,6 +51,48 @@ namespace Core {
             return this->lights;
         }
 
+        /*
+         * Position of the light at [index] (in getLights()) within the list of lights of its own type.
+         */
+        UInt32 getTypedLightIndex(UInt32 index) const {
+            if (index >= this->typedLightIndices.size()) {
+                throw OutOfRangeException("LightPack::getTypedLightIndex() -> 'index' is out of range.");
+            }
+            return this->typedLightIndices[index];
+        }
+
+        /*
+         * Position of the light at [index] (in getLights()) within the shadow lights, or -1 if it isn't one.
+         */
+        Int32 getShadowLightIndex(UInt32 index) const {
+            if (index >= this->shadowLightIndices.size()) {
+                throw OutOfRangeException("LightPack::getShadowLightIndex() -> 'index' is out of range.");
+            }
+            return this->shadowLightIndices[index];
+        }
+
+        /*
+         * Position of point light [pointLightIndex] in getLights().
+         */
+        UInt32 getLightIndexOfPointLight(UInt32 pointLightIndex) const {
+            if (pointLightIndex >= this->pointLightIndices.size()) {
+                throw OutOfRangeException("LightPack::getLightIndexOfPointLight() -> 'pointLightIndex' is out of range.");
+            }
+            return this->pointLightIndices[pointLightIndex];
+        }
+
+        /*
+         * Nonzero once the renderer has picked lights for the objects drawn with this pack; renderers holding
+         * a light selection made with the same ID may visit only those lights.
+         */
+        void setLightAssignmentID(UInt64 assignmentID) {
+            this->lightAssignmentID = assignmentID;
+        }
+
+        UInt64 getLightAssignmentID() const {
+            return this->lightAssignmentID;
+        }
+
         WeakPointer<ShadowLight> getShadowLight(UInt32 index) const {
             if (index >= this->shadowLights.size()) {
                 throw OutOfRangeException("LightPack::getShadowLight() -> 'index' is out of range.");
@@ -69,6 +116,7 @@ namespace Core {
         }
 
         void addDirectionalLight(WeakPointer<DirectionalLight> light) {
+            this->addLightIndices(this->directionalLights.size(), this->shadowLights.size());
             this->directionalLights.push_back(light);
             this->shadowLights.push_back(light);
             this->lights.push_back(light);
@@ -87,6 +135,8 @@ namespace Core {
         }
 
         void addPointLight(WeakPointer<PointLight> light) {
+            this->pointLightIndices.push_back(this->lights.size());
+            this->addLightIndices(this->pointLights.size(), this->shadowLights.size());
             this->pointLights.push_back(light);
             this->shadowLights.push_back(light);
             this->lights.push_back(light);
@@ -101,6 +151,7 @@ namespace Core {
         }
 
         void addAmbientLight(WeakPointer<AmbientLight> light) {
+            this->addLightIndices(this->ambientLights.size(), -1);
             this->ambientLights.push_back(light);
             this->lights.push_back(light);
             this->nonIBLLights.push_back(light);
@@ -114,11 +165,17 @@ namespace Core {
         }
 
         void addAmbientIBLLight(WeakPointer<AmbientIBLLight> light) {
+            this->addLightIndices(this->ambientIBLLights.size(), -1);
             this->ambientIBLLights.push_back(light);
             this->lights.push_back(light);
         }
 
     private:
+        void addLightIndices(UInt32 typedLightIndex, Int32 shadowLightIndex) {
+            this->typedLightIndices.push_back(typedLightIndex);
+            this->shadowLightIndices.push_back(shadowLightIndex);
+        }
+
         std::vector<WeakPointer<DirectionalLight>> directionalLights;
         std::vector<WeakPointer<PointLight>> pointLights;
         std::vector<WeakPointer<AmbientLight>> ambientLights;
@@ -126,6 +183,12 @@ namespace Core {
         std::vector<WeakPointer<ShadowLight>> shadowLights;
         std::vector<WeakPointer<Light>> nonIBLLights;
         std::vector<WeakPointer<Light>> lights;
+        // parallel to 'lights'
+        std::vector<UInt32> typedLightIndices;
+        std::vector<Int32> shadowLightIndices;
+        // parallel to 'pointLights'
+        std::vector<UInt32> pointLightIndices;
+        UInt64 lightAssignmentID = 0;
     };
 
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "../Engine.h"
 #include "../Graphics.h"
 #include "../render/RenderTargetCube.h"
+#include "../common/Exception.h"
 
 namespace Core {
 
@@ -14,6 +15,8 @@ namespace Core {
         this->attenuationOverride = false;
         this->attenuation = 1.0f;
         this->radius = 1.0f;
+        for (UInt32 i = 0; i < 6; i++) this->shadowCasterCounts[i] = 0;
+        this->clearedShadowFaces = 0;
     }
 
     PointLight::~PointLight() {
@@ -55,6 +58,13 @@ namespace Core {
         this->calcAttentuationForCurrentRadius();
     }
 
+    UInt32 PointLight::getShadowCasterCount(UInt32 faceIndex) const {
+        if (faceIndex >= 6) {
+            throw OutOfRangeException("PointLight::getShadowCasterCount() -> 'faceIndex' is out of range.");
+        }
+        return this->shadowCasterCounts[faceIndex];
+    }
+
     void PointLight::calcAttentuationForCurrentRadius() {
         if (!this->attenuationOverride) {
             // multiplying by 0.95f causes the light to fully attenuate slightly before reaching maximum range
@@ -70,5 +80,6 @@ namespace Core {
         Vector2u renderTargetSize(this->shadowMapSize, this->shadowMapSize);
         this->shadowMap = Engine::instance()->getGraphicsSystem()->createRenderTargetCube(true, true, false, colorTextureAttributes,
                                                                                           depthTextureAttributes, renderTargetSize);
+        this->clearedShadowFaces = 0;
     }
 }
\ No newline at end of file
@@ -12,6 +12,7 @@ namespace Core {
 
     class PointLight final : public ShadowLight {
         friend class Engine;
+        friend class Renderer;
 
     public:
         static const Real NearPlane;
@@ -29,6 +30,8 @@ namespace Core {
 
         Real getRadius() const;
         void setRadius(Real radius);
+
+        UInt32 getShadowCasterCount(UInt32 faceIndex) const;
       
     protected:
         PointLight(WeakPointer<Object3D> owner, Bool shadowsEnabled, 
@@ -42,5 +45,10 @@ namespace Core {
         Real radius;
 
         PersistentWeakPointer<RenderTargetCube> shadowMap;
+        // number of shadow casters drawn into each cube face during the last shadow pass
+        UInt32 shadowCasterCounts[6];
+        // bit i is set while cube face i of the shadow map holds nothing but its clear value, so a face
+        // that stays empty doesn't need to be cleared again
+        Byte clearedShadowFaces;
     };
 }
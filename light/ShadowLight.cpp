@@ -1,4 +1,8 @@
 #include "ShadowLight.h"
+#include "../Engine.h"
+#include "../Graphics.h"
+#include "../render/RenderTarget2D.h"
+#include "../image/TextureAttr.h"
 
 namespace Core {
 
@@ -8,10 +12,11 @@ namespace Core {
             this->shadowSoftness = Softness::Hard;
             this->faceCullingEnabled = true;
             this->cullFace = RenderState::CullFace::Back;
+            this->staticShadowCachingEnabled = false;
     }
 
     ShadowLight::~ShadowLight() {
-
+        this->destroyStaticShadowCache();
     }
 
     void ShadowLight::setShadowsEnabled(Bool enabled) {
@@ -65,4 +70,59 @@ namespace Core {
     void ShadowLight::setCullFace(RenderState::CullFace cullFace) {
         this->cullFace = cullFace;
     }
-}
\ No newline at end of file
+
+    /*
+     * Static shadow caching suits lights whose static casters rarely change. Only the transforms of static casters
+     * are tracked, so call invalidateStaticShadowCache() after changing the geometry of a static caster.
+     */
+    void ShadowLight::setStaticShadowCachingEnabled(Bool enabled) {
+        this->staticShadowCachingEnabled = enabled;
+        if (!enabled) this->destroyStaticShadowCache();
+    }
+
+    Bool ShadowLight::getStaticShadowCachingEnabled() const {
+        return this->staticShadowCachingEnabled;
+    }
+
+    void ShadowLight::invalidateStaticShadowCache() {
+        for (UInt64& signature : this->staticShadowCacheSignatures) signature = 0;
+    }
+
+    WeakPointer<RenderTarget2D> ShadowLight::getStaticShadowCache(UInt32 index, UInt32 cacheCount) {
+        if (index >= cacheCount) {
+            throw OutOfRangeException("ShadowLight::getStaticShadowCache() -> 'index' is out of range.");
+        }
+        if (this->staticShadowCache.size() != cacheCount) {
+            this->destroyStaticShadowCache();
+            this->staticShadowCache.resize(cacheCount);
+            this->staticShadowCacheSignatures.resize(cacheCount, 0);
+        }
+        if (!this->staticShadowCache[index].isValid()) {
+            this->buildStaticShadowCacheTarget(this->staticShadowCache[index]);
+            this->staticShadowCacheSignatures[index] = 0;
+        }
+        return this->staticShadowCache[index];
+    }
+
+    void ShadowLight::destroyStaticShadowCache() {
+        for (UInt32 i = 0; i < this->staticShadowCache.size(); i++) {
+            if (this->staticShadowCache[i].isValid()) Graphics::safeReleaseObject(this->staticShadowCache[i]);
+        }
+        this->staticShadowCache.clear();
+        this->staticShadowCacheSignatures.clear();
+    }
+
+    /*
+     * Cache targets hold the same single-channel depth/distance as the shadow maps, plus a depth buffer so dynamic
+     * casters can be depth tested against the static ones.
+     */
+    void ShadowLight::buildStaticShadowCacheTarget(PersistentWeakPointer<RenderTarget2D>& target) {
+        TextureAttributes colorTextureAttributes;
+        colorTextureAttributes.Format = TextureFormat::R32F;
+        colorTextureAttributes.FilterMode = TextureFilter::Point;
+        TextureAttributes depthTextureAttributes;
+        Vector2u renderTargetSize(this->shadowMapSize, this->shadowMapSize);
+        target = Engine::instance()->getGraphicsSystem()->createRenderTarget2D(true, true, false, colorTextureAttributes,
+                                                                               depthTextureAttributes, renderTargetSize);
+    }
+}
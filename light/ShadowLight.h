@@ -1,16 +1,22 @@
 #pragma once
 
+#include <vector>
+
 #include "Light.h"
 #include "../render/RenderState.h"
+#include "../util/PersistentWeakPointer.h"
 
 namespace Core {
 
     // forward declarations
     class Engine;
     class RenderTarget;
+    class RenderTarget2D;
+    class Renderer;
 
     class ShadowLight : public Light {
         friend class Engine;
+        friend class Renderer;
 
     public:
 
@@ -41,10 +47,18 @@ namespace Core {
         RenderState::CullFace getCullFace();
         void setCullFace(RenderState::CullFace cullFace);
 
+        void setStaticShadowCachingEnabled(Bool enabled);
+        Bool getStaticShadowCachingEnabled() const;
+        void invalidateStaticShadowCache();
+
     protected:
         ShadowLight(WeakPointer<Object3D> owner, LightType type, Bool shadowsEnabled, 
                     UInt32 shadowMapSize,  Real constantShadowBias, Real angularShadowBias);
 
+        WeakPointer<RenderTarget2D> getStaticShadowCache(UInt32 index, UInt32 cacheCount);
+        void destroyStaticShadowCache();
+        void buildStaticShadowCacheTarget(PersistentWeakPointer<RenderTarget2D>& target);
+
         Bool shadowsEnabled;
         UInt32 shadowMapSize;
         Real constantShadowBias;
@@ -54,5 +68,13 @@ namespace Core {
         Bool faceCullingEnabled;
         RenderState::CullFace cullFace;
 
+        // When static shadow caching is enabled the renderer draws static casters into one cache target per shadow
+        // map view (cube face or cascade), only when the signature of what they depend on (the light, the static
+        // casters and the view) changes, and each frame copies the cache into the shadow map before drawing the
+        // dynamic casters over it. A signature of 0 marks a target as stale.
+        Bool staticShadowCachingEnabled;
+        std::vector<PersistentWeakPointer<RenderTarget2D>> staticShadowCache;
+        std::vector<UInt64> staticShadowCacheSignatures;
+
     };
 }
\ No newline at end of file
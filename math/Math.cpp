@@ -102,7 +102,36 @@ namespace Core {
         return (b - a) * t + a;
     }
 
+    static thread_local Math::RandomScope* activeRandomScope = nullptr;
+
+    Math::RandomScope::RandomScope(UInt64 seed) {
+        // splitmix64 scrambles nearby seeds into unrelated starting states; xorshift needs a non-zero state
+        UInt64 z = seed + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z = z ^ (z >> 31);
+        this->state = z != 0 ? z : 0x9E3779B97F4A7C15ULL;
+        this->previousScope = activeRandomScope;
+        activeRandomScope = this;
+    }
+
+    Math::RandomScope::~RandomScope() {
+        activeRandomScope = this->previousScope;
+    }
+
+    /*
+     * xorshift64*, returning a value in [0, 1) built from the top 24 bits of the output.
+     */
+    Real Math::RandomScope::next() {
+        this->state ^= this->state >> 12;
+        this->state ^= this->state << 25;
+        this->state ^= this->state >> 27;
+        UInt64 value = this->state * 0x2545F4914F6CDD1DULL;
+        return (Real)(value >> 40) * (1.0f / 16777216.0f);
+    }
+
     Real Math::random() {
+        if (activeRandomScope != nullptr) return activeRandomScope->next();
         return (Real)rand() / (Real)RAND_MAX;
     }
 
@@ -5,6 +5,21 @@
 namespace Core {
   class Math {
   public:
+
+    // While a RandomScope is alive, random() on the thread that created it draws from the scope's own
+    // generator seeded with [seed] rather than from the shared rand() state, so jobs running on worker
+    // threads neither race on that state nor depend on how they were scheduled. Scopes may be nested.
+    class RandomScope {
+    public:
+        RandomScope(UInt64 seed);
+        ~RandomScope();
+        Real next();
+
+    private:
+        UInt64 state;
+        RandomScope* previousScope;
+    };
+
     static const Real PI;
     static const Real TwoPI;
     static const Real PIOver360;
@@ -211,25 +211,25 @@ namespace Core {
         Real sy = scale.y;
         Real sz = scale.z;
 
-		this->A0 = (1.0f - (yy + zz)) * sx;
-		this->B0 = (xy + wz) * sx;
-		this->C0 = (xz - wy) * sx;
-		this->D0 = 0.0f;
+		this->data[A0] = (1.0f - (yy + zz)) * sx;
+		this->data[B0] = (xy + wz) * sx;
+		this->data[C0] = (xz - wy) * sx;
+		this->data[D0] = 0.0f;
 
-		this->A1 = (xy - wz) * sy;
-		this->B1 = (1.0f - (xx + zz)) * sy;
-		this->C1 = (yz + wx) * sy;
-		this->D1 = 0.0f;
+		this->data[A1] = (xy - wz) * sy;
+		this->data[B1] = (1.0f - (xx + zz)) * sy;
+		this->data[C1] = (yz + wx) * sy;
+		this->data[D1] = 0.0f;
 
-		this->A2 = (xz + wy) * sz;
-		this->B2 = (yz - wx) * sz;
-		this->C2 = (1.0f - (xx + yy)) * sz;
-		this->D2 = 0.0f;
+		this->data[A2] = (xz + wy) * sz;
+		this->data[B2] = (yz - wx) * sz;
+		this->data[C2] = (1.0f - (xx + yy)) * sz;
+		this->data[D2] = 0.0f;
 
-		this->A3 = translation.x;
-		this->B3 = translation.y;
-		this->C3 = translation.z;
-		this->D3 = 1.0f;
+		this->data[A3] = translation.x;
+		this->data[B3] = translation.y;
+		this->data[C3] = translation.z;
+		this->data[D3] = 1.0f;
     }
 
     void Matrix4x4::compose(const Vector3Components<Real>& translation, const Vector3Components<Real>& euler, const Vector3Components<Real>& scale) {
@@ -243,44 +243,46 @@ namespace Core {
     void Matrix4x4::decompose(Vector3Components<Real> &translation, Quaternion &rotation, Vector3Components<Real> &scale) const {
         if (!isAffine()) throw NullPointerException("Matrix4x4::decompose -> Matrix is not affine.");
 
+        const Real* m = this->data;
         Matrix4x4 rotMatrix;
+        Real* rot = rotMatrix.data;
 
         // build orthogonal matrix [rotMatrix]
-        Real fInvLength = Math::inverseSquareRoot(A0 * A0 + B0 * B0 + C0 * C0);
+        Real fInvLength = Math::inverseSquareRoot(m[A0] * m[A0] + m[B0] * m[B0] + m[C0] * m[C0]);
 
-        rotMatrix.A0 = A0 * fInvLength;
-        rotMatrix.B0 = B0 * fInvLength;
-        rotMatrix.C0 = C0 * fInvLength;
+        rot[A0] = m[A0] * fInvLength;
+        rot[B0] = m[B0] * fInvLength;
+        rot[C0] = m[C0] * fInvLength;
 
-        Real fDot = rotMatrix.A0 * A1 + rotMatrix.B0 * B1 + rotMatrix.C0 * C1;
-        rotMatrix.A1 = A1 - fDot * rotMatrix.A0;
-        rotMatrix.B1 = B1 - fDot * rotMatrix.B0;
-        rotMatrix.C1 = C1 - fDot * rotMatrix.C0;
-        fInvLength = Math::inverseSquareRoot(rotMatrix.A1 * rotMatrix.A1 + rotMatrix.B1 * rotMatrix.B1 + rotMatrix.C1 * rotMatrix.C1);
+        Real fDot = rot[A0] * m[A1] + rot[B0] * m[B1] + rot[C0] * m[C1];
+        rot[A1] = m[A1] - fDot * rot[A0];
+        rot[B1] = m[B1] - fDot * rot[B0];
+        rot[C1] = m[C1] - fDot * rot[C0];
+        fInvLength = Math::inverseSquareRoot(rot[A1] * rot[A1] + rot[B1] * rot[B1] + rot[C1] * rot[C1]);
 
-        rotMatrix.A1 *= fInvLength;
-        rotMatrix.B1 *= fInvLength;
-        rotMatrix.C1 *= fInvLength;
+        rot[A1] *= fInvLength;
+        rot[B1] *= fInvLength;
+        rot[C1] *= fInvLength;
 
-        fDot = rotMatrix.A0 * A2 + rotMatrix.B0 * B2 + rotMatrix.C0 * C2;
-        rotMatrix.A2 = A2 - fDot * rotMatrix.A0;
-        rotMatrix.B2 = B2 - fDot * rotMatrix.B0;
-        rotMatrix.C2 = C2 - fDot * rotMatrix.C0;
+        fDot = rot[A0] * m[A2] + rot[B0] * m[B2] + rot[C0] * m[C2];
+        rot[A2] = m[A2] - fDot * rot[A0];
+        rot[B2] = m[B2] - fDot * rot[B0];
+        rot[C2] = m[C2] - fDot * rot[C0];
 
-        fDot = rotMatrix.A1 * A2 + rotMatrix.B1 * B2 + rotMatrix.C1 * C2;
-        rotMatrix.A2 -= fDot * rotMatrix.A1;
-        rotMatrix.B2 -= fDot * rotMatrix.B1;
-        rotMatrix.C2 -= fDot * rotMatrix.C1;
+        fDot = rot[A1] * m[A2] + rot[B1] * m[B2] + rot[C1] * m[C2];
+        rot[A2] -= fDot * rot[A1];
+        rot[B2] -= fDot * rot[B1];
+        rot[C2] -= fDot * rot[C1];
 
-        fInvLength = Math::inverseSquareRoot(rotMatrix.A2 * rotMatrix.A2 + rotMatrix.B2 * rotMatrix.B2 + rotMatrix.C2 * rotMatrix.C2);
+        fInvLength = Math::inverseSquareRoot(rot[A2] * rot[A2] + rot[B2] * rot[B2] + rot[C2] * rot[C2]);
 
-        rotMatrix.A2 *= fInvLength;
-        rotMatrix.B2 *= fInvLength;
-        rotMatrix.C2 *= fInvLength;
+        rot[A2] *= fInvLength;
+        rot[B2] *= fInvLength;
+        rot[C2] *= fInvLength;
 
         // guarantee that orthogonal matrix has determinant 1 (no reflections)
-        Real fDet = rotMatrix.A0 * rotMatrix.B1 * rotMatrix.C2 + rotMatrix.A1 * rotMatrix.B2 * rotMatrix.C0 + rotMatrix.A2 * rotMatrix.B0 * rotMatrix.C1 -
-                    rotMatrix.A2 * rotMatrix.B1 * rotMatrix.C0 - rotMatrix.A1 * rotMatrix.B0 * rotMatrix.C2 - rotMatrix.A0 * rotMatrix.B2 * rotMatrix.C1;
+        Real fDet = rot[A0] * rot[B1] * rot[C2] + rot[A1] * rot[B2] * rot[C0] + rot[A2] * rot[B0] * rot[C1] -
+                    rot[A2] * rot[B1] * rot[C0] - rot[A1] * rot[B0] * rot[C2] - rot[A0] * rot[B2] * rot[C1];
 
         if (fDet < 0.0) {
             for (size_t iRow = 0; iRow < 3; iRow++)
@@ -289,32 +291,33 @@ namespace Core {
 
         // build "right" matrix [rightMatrix]
         Matrix4x4 rightMatrix;
-        rightMatrix.A0 = rotMatrix.A0 * A0 + rotMatrix.B0 * B0 + rotMatrix.C0 * C0;
-        rightMatrix.A1 = rotMatrix.A0 * A1 + rotMatrix.B0 * B1 + rotMatrix.C0 * C1;
-        rightMatrix.B1 = rotMatrix.A1 * A1 + rotMatrix.B1 * B1 + rotMatrix.C1 * C1;
-        rightMatrix.A2 = rotMatrix.A0 * A2 + rotMatrix.B0 * B2 + rotMatrix.C0 * C2;
-        rightMatrix.B2 = rotMatrix.A1 * A2 + rotMatrix.B1 * B2 + rotMatrix.C1 * C2;
-        rightMatrix.C2 = rotMatrix.A2 * A2 + rotMatrix.B2 * B2 + rotMatrix.C2 * C2;
+        Real* right = rightMatrix.data;
+        right[A0] = rot[A0] * m[A0] + rot[B0] * m[B0] + rot[C0] * m[C0];
+        right[A1] = rot[A0] * m[A1] + rot[B0] * m[B1] + rot[C0] * m[C1];
+        right[B1] = rot[A1] * m[A1] + rot[B1] * m[B1] + rot[C1] * m[C1];
+        right[A2] = rot[A0] * m[A2] + rot[B0] * m[B2] + rot[C0] * m[C2];
+        right[B2] = rot[A1] * m[A2] + rot[B1] * m[B2] + rot[C1] * m[C2];
+        right[C2] = rot[A2] * m[A2] + rot[B2] * m[B2] + rot[C2] * m[C2];
 
         // the scaling component
-        scale.x = rightMatrix.A0;
-        scale.y = rightMatrix.B1;
-        scale.z = rightMatrix.C2;
+        scale.x = right[A0];
+        scale.y = right[B1];
+        scale.z = right[C2];
 
         Vector3r shear;
 
         // the shear component
         Real fInvD0 = 1.0f / scale.x;
-        shear.x = rightMatrix.A1 * fInvD0;
-        shear.y = rightMatrix.A2 * fInvD0;
-        shear.z = rightMatrix.B2 / scale.y;
+        shear.x = right[A1] * fInvD0;
+        shear.y = right[A2] * fInvD0;
+        shear.z = right[B2] / scale.y;
 
         rotation.fromMatrix(rotMatrix);
-        translation.set(A3, B3, C3);
+        translation.set(m[A3], m[B3], m[C3]);
     }
 
     Bool Matrix4x4::isAffine(void) const {
-        return D0 == 0 && D1 == 0 && D2 == 0 && D3 == 1;
+        return this->data[D0] == 0 && this->data[D1] == 0 && this->data[D2] == 0 && this->data[D3] == 1;
     }
 
     Bool Matrix4x4::isAffine(const Real *data) {
@@ -20,22 +20,14 @@ namespace Core {
         Matrix4x4(const Matrix4x4& source);
         ~Matrix4x4();
 
-        Real& A0 = data[0];
-        Real& A1 = data[4];
-        Real& A2 = data[8];
-        Real& A3 = data[12];
-        Real& B0 = data[1];
-        Real& B1 = data[5];
-        Real& B2 = data[9];
-        Real& B3 = data[13];
-        Real& C0 = data[2];
-        Real& C1 = data[6];
-        Real& C2 = data[10];
-        Real& C3 = data[14];
-        Real& D0 = data[3];
-        Real& D1 = data[7];
-        Real& D2 = data[11];
-        Real& D3 = data[15];
+        // indices into the column-major data of the element in row A-D, column 0-3; elements are addressed by
+        // index rather than through reference members so that a matrix is just its 16 values
+        enum Element : UInt32 {
+            A0 = 0, B0 = 1, C0 = 2, D0 = 3,
+            A1 = 4, B1 = 5, C1 = 6, D1 = 7,
+            A2 = 8, B2 = 9, C2 = 10, D2 = 11,
+            A3 = 12, B3 = 13, C3 = 14, D3 = 15
+        };
 
         Real* getData();
         const Real* getConstData() const;
@@ -53,6 +53,35 @@ namespace Core {
         ColorS* initialColor;
     };
 
+    /*
+     * Raw pointers to the first element of each particle attribute column, for operators that process
+     * contiguous ranges of particles at once. Vector-valued columns are strided by their component count
+     * (the unused w component of 3D vectors is always 0 for directions and 1 for positions).
+     */
+    class ParticleStateColumns {
+    public:
+        static const UInt32 Vector2Stride = Vector2rs::ComponentCount;
+        static const UInt32 Vector3Stride = Vector3rs::ComponentCount;
+        static const UInt32 Vector4Stride = Vector4rs::ComponentCount;
+        static const UInt32 ColorStride = ColorS::ComponentCount;
+
+        Real* progressTypes;
+        Real* lifetimes;
+        Real* ages;
+        Real* sequenceElements;
+        Real* positions;
+        Real* velocities;
+        Real* accelerations;
+        Real* normals;
+        Real* rotations;
+        Real* rotationalSpeeds;
+        Real* sizes;
+        Real* colors;
+
+        Real* initialSizes;
+        Real* initialColors;
+    };
+
     class ParticleStateArrayBase {
     public:
         ParticleStateArrayBase() {
@@ -117,6 +146,10 @@ namespace Core {
             return this->particleStatePointers.get()[index];
         }
 
+        const ParticleStateColumns& getColumns() const {
+            return this->columns;
+        }
+
         std::shared_ptr<AttributeArray<Point3rs>> getPositions() {return this->positions;}
         std::shared_ptr<AttributeArray<Vector2rs>> getSizes() {return this->sizes;}
         std::shared_ptr<ScalarAttributeArray<Real>> getRotations() {return this->rotations;}
@@ -150,6 +183,7 @@ namespace Core {
             for (UInt32 i = 0; i < particleCount; i++) {
                 this->bindStatePtr(i, this->particleStatePointers.get()[i]);
             }
+            this->bindColumns();
         }
 
         void deallocate() override {
@@ -173,6 +207,25 @@ namespace Core {
             ptr.initialColor = &this->initialColors->getAttribute(index);
         }
 
+        void bindColumns() {
+            this->columns.progressTypes = this->progressTypes->getAttributes();
+            this->columns.lifetimes = this->lifetimes->getAttributes();
+            this->columns.ages = this->ages->getAttributes();
+            this->columns.sequenceElements = this->sequenceElements->getStorage();
+            this->columns.positions = this->positions->getStorage();
+            this->columns.velocities = this->velocities->getStorage();
+            this->columns.accelerations = this->accelerations->getStorage();
+            this->columns.normals = this->normals->getStorage();
+            this->columns.rotations = this->rotations->getAttributes();
+            this->columns.rotationalSpeeds = this->rotationalSpeeds->getAttributes();
+            this->columns.sizes = this->sizes->getStorage();
+            this->columns.colors = this->colors->getStorage();
+
+            this->columns.initialSizes = this->initialSizes->getStorage();
+            this->columns.initialColors = this->initialColors->getStorage();
+        }
+
+        ParticleStateColumns columns;
         std::shared_ptr<ParticleStatePtr> particleStatePointers;
         std::shared_ptr<ScalarAttributeArray<Real>> progressTypes;
         std::shared_ptr<ScalarAttributeArray<Real>> lifetimes;
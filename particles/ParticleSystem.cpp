@@ -1,3 +1,5 @@
+#include <string.h>
+
 #include "ParticleSystem.h"
 #include "ParticleSequenceGroup.h"
 
@@ -11,6 +13,10 @@ namespace Core {
         this->simulateInWorldSpace = false;
 
         this->particleStates.setParticleCount(maximumActiveParticles);
+        this->particleAliveFlags.resize(maximumActiveParticles);
+        this->updateInProgress = false;
+        this->skippedSimulationTime = 0.0f;
+        this->emissionLimit = maximumActiveParticles;
 
         ParticleSequenceGroup* sequencesPtr = new(std::nothrow) ParticleSequenceGroup();
         if (sequencesPtr == nullptr) {
@@ -23,11 +29,99 @@ namespace Core {
     }
 
     void ParticleSystem::update(Real timeDelta) {
-        if (this->emitterInitialized && this->systemState == SystemState::Running) {
-            UInt32 particlesToEmit = this->particleEmitter->update(timeDelta);
-            if (particlesToEmit > 0) this->activateParticles(particlesToEmit);
-            this->advanceActiveParticles(timeDelta);
+        if (this->beginUpdate(timeDelta)) {
+            this->advanceParticleRange(0, this->activeParticleCount, timeDelta);
+            this->endUpdate();
+        }
+    }
+
+    /*
+     * The update of a running system is split into three phases so that the (expensive) middle phase can be
+     * spread across threads: beginUpdate() emits new particles, advanceParticleRange() runs the operators on
+     * a range of active particles and may be called concurrently for disjoint ranges, and endUpdate() removes
+     * the particles that expired. Returns false if the system isn't running, in which case the other two
+     * phases must be skipped.
+     */
+    Bool ParticleSystem::beginUpdate(Real timeDelta) {
+        if (!this->emitterInitialized || this->systemState != SystemState::Running) return false;
+
+        UInt32 particlesToEmit = this->particleEmitter->update(timeDelta);
+        if (particlesToEmit > 0) this->activateParticles(particlesToEmit);
+        if (this->activeParticleCount > 0) {
+            memset(this->particleAliveFlags.data(), 1, this->activeParticleCount);
+        }
+        this->updateInProgress = true;
+        return true;
+    }
+
+    void ParticleSystem::advanceParticleRange(UInt32 start, UInt32 count, Real timeDelta) {
+        if (!this->updateInProgress) {
+            throw Exception("ParticleSystem::advanceParticleRange() -> Called outside of beginUpdate()/endUpdate().");
+        }
+        if (start + count > this->activeParticleCount) {
+            throw OutOfRangeException("ParticleSystem::advanceParticleRange() -> Range exceeds active particle count.");
+        }
+
+        Byte* aliveFlags = this->particleAliveFlags.data();
+        const ParticleStateColumns& columns = this->particleStates.getColumns();
+        for (UInt32 i = 0; i < this->particleStateOperators.size(); i++) {
+            this->particleStateOperators[i]->updateStates(this->particleStates, start, count, timeDelta, aliveFlags);
+
+            // expire particles after every operator so later operators skip them, as with per-particle updates
+            for (UInt32 p = start; p < start + count; p++) {
+                Real particleLifeTime = columns.lifetimes[p];
+                if (particleLifeTime != 0.0f && columns.ages[p] >= particleLifeTime) aliveFlags[p] = 0;
+            }
+        }
+    }
+
+    void ParticleSystem::endUpdate() {
+        if (!this->updateInProgress) return;
+        this->removeExpiredParticles();
+        if (this->simulationLOD.enabled) this->updateSimulationBounds();
+        this->updateInProgress = false;
+    }
+
+    /*
+     * Decide how many update steps the system takes this frame, and the time delta of each, according to its
+     * SimulationLOD. [inView] is whether the simulation bounds intersect any view, and [viewDistance] the distance
+     * from the bounds to the nearest view. Returns 0 if the system should not be updated this frame.
+     */
+    UInt32 ParticleSystem::computeSimulationSteps(Real timeDelta, Bool inView, Real viewDistance, Real& stepDelta) {
+        stepDelta = timeDelta;
+        this->emissionLimit = this->maximumActiveParticles;
+        if (!this->simulationLOD.enabled || !this->emitterInitialized || this->systemState != SystemState::Running) {
+            this->skippedSimulationTime = 0.0f;
+            return 1;
+        }
+
+        if (this->simulationLOD.distantEmissionRange > 0.0f && viewDistance > this->simulationLOD.distantEmissionRange) {
+            this->emissionLimit = Math::min(this->simulationLOD.distantParticleCap, this->maximumActiveParticles);
+        }
+
+        Real pendingTime = this->skippedSimulationTime + timeDelta;
+        if (!inView) {
+            Real interval = this->simulationLOD.culledUpdateInterval;
+            if (interval > 0.0f) {
+                // skipped time is capped at maxCatchUpTime, so a longer interval would never elapse
+                interval = Math::min(interval, this->simulationLOD.maxCatchUpTime);
+                if (pendingTime >= interval) {
+                    this->skippedSimulationTime = 0.0f;
+                    stepDelta = pendingTime;
+                    return 1;
+                }
+            }
+            this->skippedSimulationTime = Math::min(pendingTime, this->simulationLOD.maxCatchUpTime);
+            return 0;
         }
+
+        this->skippedSimulationTime = 0.0f;
+        if (pendingTime <= timeDelta || this->simulationLOD.catchUpTimeStep <= 0.0f) return 1;
+
+        UInt32 steps = (UInt32)(pendingTime / this->simulationLOD.catchUpTimeStep);
+        if ((Real)steps * this->simulationLOD.catchUpTimeStep < pendingTime) steps++;
+        stepDelta = pendingTime / (Real)steps;
+        return steps;
     }
 
     void ParticleSystem::start() {
@@ -49,7 +143,8 @@ namespace Core {
     }
 
     void ParticleSystem::activateParticles(UInt32 particleCount) { 
-        UInt32 newActiveParticleCount = Math::clamp(this->activeParticleCount + particleCount, (UInt32)0, this->maximumActiveParticles);
+        if (this->activeParticleCount >= this->emissionLimit) return;
+        UInt32 newActiveParticleCount = Math::clamp(this->activeParticleCount + particleCount, (UInt32)0, this->emissionLimit);
         for (UInt32 i = this->activeParticleCount; i < newActiveParticleCount; i++) {
             this->activateParticle(i);
         }
@@ -67,38 +162,68 @@ namespace Core {
         if (this->simulateInWorldSpace) statePtr.position->add(worldPosition.x, worldPosition.y, worldPosition.z);
     }
 
-    void ParticleSystem::advanceActiveParticles(Real timeDelta) {
+    /*
+     * Compact the active particles by moving the last live particle into each expired slot.
+     */
+    void ParticleSystem::removeExpiredParticles() {
+        Byte* aliveFlags = this->particleAliveFlags.data();
         UInt32 i = 0;
         while (i < this->activeParticleCount) {
-            Bool particleIsActive = this->advanceActiveParticle(i, timeDelta); 
-            if (!particleIsActive) {
-                if (i < this->activeParticleCount - 1) {
-                    this->copyParticleInArray(this->activeParticleCount - 1, i);
+            if (!aliveFlags[i]) {
+                UInt32 lastIndex = this->activeParticleCount - 1;
+                if (i < lastIndex) {
+                    this->copyParticleInArray(lastIndex, i);
+                    aliveFlags[i] = aliveFlags[lastIndex];
                 }
-                this->activeParticleCount--; 
+                this->activeParticleCount--;
                 continue;
             }
             i++;
         }
     }
 
-    Bool ParticleSystem::advanceActiveParticle(UInt32 index, Real timeDelta) {
-        ParticleStatePtr statePtr = this->particleStates.getStatePtr(index);
-        for (UInt32 i = 0; i < this->particleStateOperators.size(); i++) {
-            std::shared_ptr<ParticleStateOperator> particleStateOperator = this->particleStateOperators[i];
-            Bool stillAlive = particleStateOperator->updateState(statePtr, timeDelta);
-            Real particleLifeTime = *statePtr.lifetime;
-            if (!stillAlive || particleLifeTime != 0.0f && *statePtr.age >= particleLifeTime) {
-                return false;
-            }
-        }
-        return true;
-    }
-
     void ParticleSystem::copyParticleInArray(UInt32 srcIndex, UInt32 destIndex) {
         this->particleStates.copyState(srcIndex, destIndex);
     }
 
+    /*
+     * Runs in endUpdate(), which the particle system manager calls from worker threads, so the owner's world
+     * transform is only read here.
+     */
+    void ParticleSystem::updateSimulationBounds() {
+        const Matrix4x4& worldMatrix = this->owner->getTransform().getConstWorldMatrix();
+        const Real* m = worldMatrix.getConstData();
+        Point3r emitterPosition(m[12], m[13], m[14]);
+
+        // start from the emitter's position, in the space the particles are simulated in
+        Box3 particleBounds(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        if (this->simulateInWorldSpace) {
+            particleBounds.setMin(emitterPosition.x, emitterPosition.y, emitterPosition.z);
+            particleBounds.setMax(emitterPosition.x, emitterPosition.y, emitterPosition.z);
+        }
+
+        const ParticleStateColumns& columns = this->particleStates.getColumns();
+        Real maxSize = 0.0f;
+        for (UInt32 i = 0; i < this->activeParticleCount; i++) {
+            const Real* position = columns.positions + i * Point3rs::ComponentCount;
+            particleBounds.expandByPoint(Point3r(position[0], position[1], position[2]));
+            const Real* size = columns.sizes + i * Vector2rs::ComponentCount;
+            maxSize = Math::max(maxSize, Math::max(size[0], size[1]));
+        }
+
+        if (this->simulateInWorldSpace) {
+            this->simulationBounds = particleBounds;
+        } else {
+            particleBounds.transform(worldMatrix, this->simulationBounds);
+        }
+
+        Real padding = maxSize + this->simulationLOD.boundsPadding;
+        const Vector3r& min = this->simulationBounds.getMin();
+        const Vector3r& max = this->simulationBounds.getMax();
+        this->simulationBounds.setMin(min.x - padding, min.y - padding, min.z - padding);
+        this->simulationBounds.setMax(max.x + padding, max.y + padding, max.z + padding);
+    }
+
     ParticleSystem::SystemState ParticleSystem::getSystemState() {
         return this->systemState;
     }
@@ -159,4 +284,26 @@ namespace Core {
     WeakPointer<ParticleSequenceGroup> ParticleSystem::getParticleSequences() {
         return this->particleSequences;
     }
+
+    /*
+     * Until the system has been simulated with LOD enabled its bounds are just the emitter position.
+     */
+    void ParticleSystem::setSimulationLOD(const SimulationLOD& simulationLOD) {
+        Bool wasEnabled = this->simulationLOD.enabled;
+        this->simulationLOD = simulationLOD;
+        if (simulationLOD.enabled && !wasEnabled) {
+            Point3r emitterPosition = this->owner->getTransform().getWorldPosition();
+            this->simulationBounds.setMin(emitterPosition.x, emitterPosition.y, emitterPosition.z);
+            this->simulationBounds.setMax(emitterPosition.x, emitterPosition.y, emitterPosition.z);
+        }
+        if (!simulationLOD.enabled) this->skippedSimulationTime = 0.0f;
+    }
+
+    const ParticleSystem::SimulationLOD& ParticleSystem::getSimulationLOD() const {
+        return this->simulationLOD;
+    }
+
+    const Box3& ParticleSystem::getSimulationBounds() const {
+        return this->simulationBounds;
+    }
 }
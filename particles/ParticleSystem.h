@@ -5,6 +5,7 @@
 #include "../util/PersistentWeakPointer.h"
 #include "../common/types.h"
 #include "../scene/Object3DComponent.h"
+#include "../geometry/Box3.h"
 #include "ParticleEmitter.h"
 #include "renderer/ParticleSystemRenderer.h"
 #include "ParticleState.h"
@@ -25,10 +26,33 @@ namespace Core {
             Done = 3
         };
 
+        /*
+         * Optional simulation level of detail, applied by ParticleSystemManager. A system whose bounds are outside
+         * every view is paused (culledUpdateInterval == 0) or stepped once per culledUpdateInterval seconds (capped
+         * at maxCatchUpTime), and the time it skipped (at most maxCatchUpTime) is simulated in steps of at most
+         * catchUpTimeStep once it comes back into view. A system farther than distantEmissionRange from every view
+         * only emits while it has fewer than distantParticleCap active particles.
+         */
+        class SimulationLOD {
+        public:
+            Bool enabled = false;
+            Real culledUpdateInterval = 0.0f;
+            Real catchUpTimeStep = 1.0f / 30.0f;
+            Real maxCatchUpTime = 2.0f;
+            Real distantEmissionRange = 0.0f;
+            UInt32 distantParticleCap = 0;
+            // added to the particle bounds on every side, for particles drawn larger than their size attribute
+            Real boundsPadding = 0.0f;
+        };
+
         ParticleSystem(WeakPointer<Object3D> owner, UInt32 maximumActiveParticles);
         ~ParticleSystem();
 
         void update(Real timeDelta);
+        Bool beginUpdate(Real timeDelta);
+        void advanceParticleRange(UInt32 start, UInt32 count, Real timeDelta);
+        void endUpdate();
+        UInt32 computeSimulationSteps(Real timeDelta, Bool inView, Real viewDistance, Real& stepDelta);
         void start();
         void pause();
         void stop();
@@ -74,13 +98,17 @@ namespace Core {
         void addParticleSequence(UInt32 id, UInt32 start, UInt32 length);
         WeakPointer<ParticleSequenceGroup> getParticleSequences();
 
+        void setSimulationLOD(const SimulationLOD& simulationLOD);
+        const SimulationLOD& getSimulationLOD() const;
+        const Box3& getSimulationBounds() const;
+
     private:
 
         void activateParticles(UInt32 particleCount);
         void activateParticle(UInt32 index);
-        void advanceActiveParticles(Real timeDelta);
-        Bool advanceActiveParticle(UInt32 index, Real timeDelta);
+        void removeExpiredParticles();
         void copyParticleInArray(UInt32 srcIndex, UInt32 destIndex);
+        void updateSimulationBounds();
 
         Bool simulateInWorldSpace;
         Bool emitterInitialized;
@@ -91,6 +119,14 @@ namespace Core {
         std::vector<std::shared_ptr<ParticleStateInitializer>> particleStateInitializers;
         std::vector<std::shared_ptr<ParticleStateOperator>> particleStateOperators;
         ParticleStateAttributeArray particleStates;
+        std::vector<Byte> particleAliveFlags;
+        Bool updateInProgress;
         std::shared_ptr<ParticleSequenceGroup> particleSequences;
+
+        SimulationLOD simulationLOD;
+        // world space bounds of the live particles and the emitter, as of the last simulated step
+        Box3 simulationBounds;
+        Real skippedSimulationTime;
+        UInt32 emissionLimit;
     };
 }
\ No newline at end of file
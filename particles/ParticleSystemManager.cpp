@@ -1,25 +1,145 @@
+#include "../Engine.h"
 #include "ParticleSystemManager.h"
 #include "ParticleSystem.h"
 #include "../util/Time.h"
+#include "../util/WorkerPool.h"
+#include "../math/Math.h"
 
 namespace Core {
 
-    ParticleSystemManager::ParticleSystemManager() {
+    const UInt32 ParticleSystemManager::ParticleBatchSize;
+    const UInt32 ParticleSystemManager::MaxViewCount;
+
+    ParticleSystemManager::ParticleSystemManager(): updateStepCount(0) {
     }
 
     ParticleSystemManager::~ParticleSystemManager() {
     }
 
+    /*
+     * Each system first decides, from its SimulationLOD and the views reported since the last update, how many
+     * steps it takes this frame (0 when it's culled, more than 1 when it's catching up). The steps are then run
+     * in lockstep across all systems: emission runs serially (initializers may touch the scene graph), then the
+     * active particles of every updating system are cut into batches of at most ParticleBatchSize that are
+     * advanced on the engine's worker pool, and finally each system compacts away its expired particles.
+     *
+     * Operators that draw random values (e.g. through a RandomGenerator) get them from a generator owned by the
+     * batch, seeded from the system, the step and the batch's first particle, so results don't depend on which
+     * worker ran the batch.
+     */
     void ParticleSystemManager::update() {
+        Real timeDelta = Time::getDeltaTime();
+        if (this->pendingViews.size() > 0) {
+            this->views.swap(this->pendingViews);
+            this->pendingViews.clear();
+        }
+
+        this->scheduledSystems.clear();
+        UInt32 stepCount = 0;
         for(WeakPointer<ParticleSystem> particleSystem : this->particleSystems) {
-            particleSystem->update(Time::getDeltaTime());
+            Bool inView = true;
+            Real viewDistance = 0.0f;
+            if (particleSystem->getSimulationLOD().enabled && this->views.size() > 0) {
+                this->classifyAgainstViews(particleSystem->getSimulationBounds(), inView, viewDistance);
+            }
+
+            ScheduledSystem scheduled;
+            scheduled.system = particleSystem.get();
+            scheduled.stepCount = particleSystem->computeSimulationSteps(timeDelta, inView, viewDistance, scheduled.stepDelta);
+            if (scheduled.stepCount == 0) {
+                this->stats.culledSystems++;
+                continue;
+            }
+            this->stats.catchUpSteps += scheduled.stepCount - 1;
+            this->scheduledSystems.push_back(scheduled);
+            stepCount = Math::max(stepCount, scheduled.stepCount);
+        }
+
+        for (UInt32 step = 0; step < stepCount; step++) {
+            this->runUpdateStep(step);
         }
     }
 
+    void ParticleSystemManager::runUpdateStep(UInt32 step) {
+        this->updatingSystems.clear();
+        this->particleBatches.clear();
+        for (UInt32 i = 0; i < this->scheduledSystems.size(); i++) {
+            const ScheduledSystem& scheduled = this->scheduledSystems[i];
+            if (step >= scheduled.stepCount) continue;
+            if (!scheduled.system->beginUpdate(scheduled.stepDelta)) continue;
+
+            if (step == 0) this->stats.simulatedSystems++;
+            this->updatingSystems.push_back(i);
+            UInt32 activeParticleCount = scheduled.system->getActiveParticleCount();
+            for (UInt32 start = 0; start < activeParticleCount; start += ParticleBatchSize) {
+                ParticleBatch batch;
+                batch.systemIndex = i;
+                batch.start = start;
+                batch.count = Math::min(ParticleBatchSize, activeParticleCount - start);
+                this->particleBatches.push_back(batch);
+            }
+        }
+
+        this->updateStepCount++;
+        WeakPointer<WorkerPool> workerPool = Engine::instance()->getWorkerPool();
+        workerPool->execute((UInt32)this->particleBatches.size(), [this](UInt32 batchIndex) {
+            const ParticleBatch& batch = this->particleBatches[batchIndex];
+            const ScheduledSystem& scheduled = this->scheduledSystems[batch.systemIndex];
+            const UInt64 fnvPrime = 0x100000001B3ULL;
+            UInt64 seed = (scheduled.system->getObjectID() * fnvPrime ^ this->updateStepCount) * fnvPrime ^ batch.start;
+            Math::RandomScope randomScope(seed);
+            scheduled.system->advanceParticleRange(batch.start, batch.count, scheduled.stepDelta);
+        });
+
+        workerPool->execute((UInt32)this->updatingSystems.size(), [this](UInt32 updatingIndex) {
+            this->scheduledSystems[this->updatingSystems[updatingIndex]].system->endUpdate();
+        });
+    }
+
+    /*
+     * [bounds] is in view if it intersects any view frustum; [viewDistance] is the distance from the closest
+     * point of [bounds] to the nearest view position.
+     */
+    void ParticleSystemManager::classifyAgainstViews(const Box3& bounds, Bool& inView, Real& viewDistance) const {
+        inView = false;
+        Real minDistanceSquared = -1.0f;
+        const Vector3r& min = bounds.getMin();
+        const Vector3r& max = bounds.getMax();
+        for (const View& view : this->views) {
+            if (!inView && view.frustum.intersectsBox(bounds)) inView = true;
+            Real dx = Math::max(Math::max(min.x - view.position.x, view.position.x - max.x), 0.0f);
+            Real dy = Math::max(Math::max(min.y - view.position.y, view.position.y - max.y), 0.0f);
+            Real dz = Math::max(Math::max(min.z - view.position.z, view.position.z - max.z), 0.0f);
+            Real distanceSquared = dx * dx + dy * dy + dz * dz;
+            if (minDistanceSquared < 0.0f || distanceSquared < minDistanceSquared) minDistanceSquared = distanceSquared;
+        }
+        viewDistance = Math::squareRoot(minDistanceSquared);
+    }
+
     void ParticleSystemManager::addParticleSystem(WeakPointer<ParticleSystem> particleSystem) {
         if (!particleSystem.isValid()) {
             throw InvalidArgumentException("ParticleSystemManager::addParticleSystem() -> 'particleSystem' is invalid."); 
         }
         this->particleSystems.push_back(particleSystem);
     }
+
+    /*
+     * Report a view (e.g. a camera rendered this frame) for simulation LOD. Views reported between two updates
+     * replace the previous set at the next update; if none were reported, the previous set stays in use.
+     */
+    void ParticleSystemManager::addView(const Frustum& frustum, const Point3r& position) {
+        if (this->pendingViews.size() >= MaxViewCount) return;
+        View view;
+        view.frustum = frustum;
+        view.position = position;
+        this->pendingViews.push_back(view);
+    }
+
+    const ParticleSystemManager::Stats& ParticleSystemManager::getStats() const {
+        return this->stats;
+    }
+
+    void ParticleSystemManager::resetStats() {
+        this->stats = Stats();
+    }
 }
@@ -1,14 +1,18 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "../util/PersistentWeakPointer.h"
 #include "../common/types.h"
+#include "../geometry/Frustum.h"
+#include "../geometry/Vector3.h"
 
 namespace Core {
 
     //forward declarations
     class ParticleSystem;
+    class Box3;
 
     class ParticleSystemManager final {
 
@@ -16,15 +20,64 @@ namespace Core {
 
     public:
 
+        // maximum number of particles advanced by a single worker job
+        static const UInt32 ParticleBatchSize = 2048;
+        // views reported beyond this many between two updates are ignored
+        static const UInt32 MaxViewCount = 32;
+
+        class Stats {
+        public:
+            UInt32 simulatedSystems = 0;
+            UInt32 culledSystems = 0;
+            UInt32 catchUpSteps = 0;
+        };
+
         ~ParticleSystemManager();
 
         void update();
         void addParticleSystem(WeakPointer<ParticleSystem> particleSystem);
+        void addView(const Frustum& frustum, const Point3r& position);
+
+        const Stats& getStats() const;
+        void resetStats();
 
     private:
 
+        class ParticleBatch {
+        public:
+            UInt32 systemIndex;
+            UInt32 start;
+            UInt32 count;
+        };
+
+        class ScheduledSystem {
+        public:
+            ParticleSystem* system;
+            UInt32 stepCount;
+            Real stepDelta;
+        };
+
+        class View {
+        public:
+            Frustum frustum;
+            Point3r position;
+        };
+
         ParticleSystemManager();
 
+        void runUpdateStep(UInt32 step);
+        void classifyAgainstViews(const Box3& bounds, Bool& inView, Real& viewDistance) const;
+
         std::vector<PersistentWeakPointer<ParticleSystem>> particleSystems;
+        std::vector<ScheduledSystem> scheduledSystems;
+        // indices into 'scheduledSystems' of the systems taking the current step
+        std::vector<UInt32> updatingSystems;
+        std::vector<ParticleBatch> particleBatches;
+        // number of update steps run so far, part of the random seed of each batch
+        UInt64 updateStepCount;
+        // views reported since the last update, and the ones simulation LOD is currently tested against
+        std::vector<View> pendingViews;
+        std::vector<View> views;
+        Stats stats;
     };
-}
\ No newline at end of file
+}
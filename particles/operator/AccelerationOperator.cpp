@@ -16,4 +16,17 @@ namespace Core {
         state.acceleration->copy(acceleration);
         return true;
     }
+
+    void AccelerationOperator::updateStates(ParticleStateAttributeArray& states, UInt32 start, UInt32 count, Real timeDelta, Byte* aliveFlags) {
+        const ParticleStateColumns& columns = states.getColumns();
+        const UInt32 stride = ParticleStateColumns::Vector3Stride;
+        Real* accelerations = columns.accelerations + start * stride;
+        Vector3r acceleration;
+        for (UInt32 i = 0; i < count; i++, accelerations += stride) {
+            this->generator->generate(acceleration);
+            accelerations[0] = acceleration.x;
+            accelerations[1] = acceleration.y;
+            accelerations[2] = acceleration.z;
+        }
+    }
 }
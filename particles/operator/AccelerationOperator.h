@@ -15,6 +15,7 @@ namespace Core {
         virtual ~AccelerationOperator();
 
         virtual Bool updateState(ParticleStatePtr& state, Real timeDelta) override;
+        virtual void updateStates(ParticleStateAttributeArray& states, UInt32 start, UInt32 count, Real timeDelta, Byte* aliveFlags) override;
     
     private:
 
@@ -10,19 +10,11 @@ namespace Core {
     }
 
     Bool BasicParticleStateOperator::updateState(ParticleStatePtr& state, Real timeDelta) {
-        static Vector3r timeScaledVelocity;
-        static Vector3r timeScaledAcceleration;
-
         Vector3rs& stateAcceleration = *state.acceleration;
-        timeScaledAcceleration.set(stateAcceleration.x, stateAcceleration.y, stateAcceleration.z);
-        timeScaledAcceleration.scale(timeDelta);
-        state.velocity->add(timeScaledAcceleration.x, timeScaledAcceleration.y, timeScaledAcceleration.z);
+        state.velocity->add(stateAcceleration.x * timeDelta, stateAcceleration.y * timeDelta, stateAcceleration.z * timeDelta);
 
         Vector3rs& stateVelocity = *state.velocity;
-        timeScaledVelocity.set(stateVelocity.x, stateVelocity.y, stateVelocity.z);
-        timeScaledVelocity.scale(timeDelta);
-       
-        state.position->add(timeScaledVelocity.x, timeScaledVelocity.y, timeScaledVelocity.z);
+        state.position->add(stateVelocity.x * timeDelta, stateVelocity.y * timeDelta, stateVelocity.z * timeDelta);
 
         *state.age = *state.age + timeDelta;
 
@@ -31,4 +23,33 @@ namespace Core {
         *state.rotation = currentRotation + timeDelta * currentRotationalSpeed;
         return true;
     }
+
+    /*
+     * Integrate the whole range as flat loops over the attribute columns so the compiler can vectorize them.
+     * The w components are included: they are 0 for accelerations and velocities, so positions keep w = 1.
+     * Expired particles are integrated as well since they will be discarded anyway.
+     */
+    void BasicParticleStateOperator::updateStates(ParticleStateAttributeArray& states, UInt32 start, UInt32 count, Real timeDelta, Byte* aliveFlags) {
+        const ParticleStateColumns& columns = states.getColumns();
+        const UInt32 stride = ParticleStateColumns::Vector3Stride;
+        const UInt32 componentCount = count * stride;
+
+        const Real* accelerations = columns.accelerations + start * stride;
+        Real* velocities = columns.velocities + start * stride;
+        Real* positions = columns.positions + start * stride;
+        for (UInt32 i = 0; i < componentCount; i++) {
+            velocities[i] += accelerations[i] * timeDelta;
+        }
+        for (UInt32 i = 0; i < componentCount; i++) {
+            positions[i] += velocities[i] * timeDelta;
+        }
+
+        Real* ages = columns.ages + start;
+        Real* rotations = columns.rotations + start;
+        const Real* rotationalSpeeds = columns.rotationalSpeeds + start;
+        for (UInt32 i = 0; i < count; i++) {
+            ages[i] += timeDelta;
+            rotations[i] += timeDelta * rotationalSpeeds[i];
+        }
+    }
 }
@@ -13,9 +13,6 @@ namespace Core {
         virtual ~BasicParticleStateOperator();
 
         virtual Bool updateState(ParticleStatePtr& state, Real timeDelta) override;
-    
-    private:
-
-
+        virtual void updateStates(ParticleStateAttributeArray& states, UInt32 start, UInt32 count, Real timeDelta, Byte* aliveFlags) override;
     };
 }
\ No newline at end of file
@@ -27,4 +27,27 @@ namespace Core {
         }
         return true;
     }
+
+    void ColorInterpolatorOperator::updateStates(ParticleStateAttributeArray& states, UInt32 start, UInt32 count, Real timeDelta, Byte* aliveFlags) {
+        const ParticleStateColumns& columns = states.getColumns();
+        const UInt32 stride = ParticleStateColumns::ColorStride;
+        Color c;
+        for (UInt32 i = start; i < start + count; i++) {
+            if (!aliveFlags[i]) continue;
+            this->interpolationElements.getInterpolatedElement(InterpolatorOperator::getInterpolationT(columns, i), c);
+            Real* color = columns.colors + i * stride;
+            if (this->relativeToInitialValue) {
+                const Real* initialColor = columns.initialColors + i * stride;
+                color[0] = initialColor[0] * c.r;
+                color[1] = initialColor[1] * c.g;
+                color[2] = initialColor[2] * c.b;
+                if (!this->ignoreAlpha) color[3] = initialColor[3] * c.a;
+            } else {
+                color[0] = c.r;
+                color[1] = c.g;
+                color[2] = c.b;
+                if (!this->ignoreAlpha) color[3] = c.a;
+            }
+        }
+    }
 }
@@ -14,6 +14,7 @@ namespace Core {
         virtual ~ColorInterpolatorOperator();
 
         virtual Bool updateState(ParticleStatePtr& state, Real timeDelta) override;
+        virtual void updateStates(ParticleStateAttributeArray& states, UInt32 start, UInt32 count, Real timeDelta, Byte* aliveFlags) override;
     
     private:
 
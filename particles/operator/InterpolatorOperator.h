@@ -42,6 +42,26 @@ namespace Core {
             this->interpolationElements.getInterpolatedElement(t, out);
         }
 
+        /*
+         * The same interpolation parameter getInterpolatedValue() computes, read from the attribute columns
+         * for particle [index].
+         */
+        static Real getInterpolationT(const ParticleStateColumns& columns, UInt32 index) {
+            switch((ParticleStateProgressType)(UInt32)columns.progressTypes[index]) {
+                case ParticleStateProgressType::Time:
+                {
+                    Real lifetime = columns.lifetimes[index];
+                    return lifetime != 0.0f ? columns.ages[index] / lifetime : columns.ages[index];
+                }
+                case ParticleStateProgressType::Sequence:
+                {
+                    const Real* sequenceElement = columns.sequenceElements + index * ParticleStateColumns::Vector4Stride;
+                    return sequenceElement[0] / sequenceElement[3];
+                }
+            }
+            return 0.0f;
+        }
+
         ContinuousArray<T> interpolationElements;
         Bool relativeToInitialValue;
     };
@@ -21,4 +21,16 @@ namespace Core {
         }
         return true;
     }
+
+    void OpacityInterpolatorOperator::updateStates(ParticleStateAttributeArray& states, UInt32 start, UInt32 count, Real timeDelta, Byte* aliveFlags) {
+        const ParticleStateColumns& columns = states.getColumns();
+        const UInt32 stride = ParticleStateColumns::ColorStride;
+        Real a;
+        for (UInt32 i = start; i < start + count; i++) {
+            if (!aliveFlags[i]) continue;
+            this->interpolationElements.getInterpolatedElement(InterpolatorOperator::getInterpolationT(columns, i), a);
+            Real* alpha = columns.colors + i * stride + 3;
+            *alpha = this->relativeToInitialValue ? columns.initialColors[i * stride + 3] * a : a;
+        }
+    }
 }
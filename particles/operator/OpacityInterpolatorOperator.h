@@ -13,6 +13,7 @@ namespace Core {
         virtual ~OpacityInterpolatorOperator();
 
         virtual Bool updateState(ParticleStatePtr& state, Real timeDelta) override;
+        virtual void updateStates(ParticleStateAttributeArray& states, UInt32 start, UInt32 count, Real timeDelta, Byte* aliveFlags) override;
     
     };
 }
\ No newline at end of file
@@ -8,4 +8,17 @@ namespace Core {
     ParticleStateOperator::~ParticleStateOperator() {
     }
 
+    /*
+     * Update particles [start] through [start] + [count] - 1 of [states]. A particle whose entry in [aliveFlags]
+     * is 0 has already expired this frame and is skipped; operators clear the flag of particles they kill.
+     * The default implementation forwards each live particle to updateState(). Operators with simple
+     * per-particle math should override this to work directly on the attribute columns.
+     */
+    void ParticleStateOperator::updateStates(ParticleStateAttributeArray& states, UInt32 start, UInt32 count, Real timeDelta, Byte* aliveFlags) {
+        for (UInt32 i = start; i < start + count; i++) {
+            if (!aliveFlags[i]) continue;
+            if (!this->updateState(states.getStatePtr(i), timeDelta)) aliveFlags[i] = 0;
+        }
+    }
+
 }
@@ -13,5 +13,6 @@ namespace Core {
         virtual ~ParticleStateOperator();
 
         virtual Bool updateState(ParticleStatePtr& state, Real timeDelta) = 0;
+        virtual void updateStates(ParticleStateAttributeArray& states, UInt32 start, UInt32 count, Real timeDelta, Byte* aliveFlags);
     };
 }
\ No newline at end of file
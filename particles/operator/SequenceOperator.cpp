@@ -34,4 +34,45 @@ namespace Core {
         }
         return true;
     }
+
+    /*
+     * Same as updateState() over the attribute columns. The particles of a system usually share one sequence,
+     * so the bounds of the last sequence looked up are reused until a particle with another one comes along.
+     */
+    void SequenceOperator::updateStates(ParticleStateAttributeArray& states, UInt32 start, UInt32 count, Real timeDelta, Byte* aliveFlags) {
+        const ParticleStateColumns& columns = states.getColumns();
+        const UInt32 stride = ParticleStateColumns::Vector4Stride;
+        WeakPointer<ParticleSequenceGroup> sequenceGroup = this->particleSequences;
+        Real tdOverS = timeDelta / this->speed;
+        Bool sequenceFound = false;
+        UInt32 sequenceID = 0;
+        Real sequenceStart = 0.0f;
+        Real sequenceEnd = 0.0f;
+        for (UInt32 i = start; i < start + count; i++) {
+            if (!aliveFlags[i]) continue;
+            Real* sequenceElement = columns.sequenceElements + i * stride;
+            UInt32 particleSequenceID = (UInt32)sequenceElement[1];
+            if (!sequenceFound || particleSequenceID != sequenceID) {
+                WeakPointer<ParticleSequence> activeSequence = sequenceGroup->getSequence(particleSequenceID);
+                sequenceStart = (Real)activeSequence->start;
+                sequenceEnd = (Real)activeSequence->start + (Real)activeSequence->length;
+                sequenceID = particleSequenceID;
+                sequenceFound = true;
+            }
+
+            if (this->reverse) {
+                sequenceElement[0] -= tdOverS;
+                if (sequenceElement[0] < sequenceStart) {
+                    sequenceElement[0] = sequenceEnd;
+                    if (!this->loop) aliveFlags[i] = 0;
+                }
+            } else {
+                sequenceElement[0] += tdOverS;
+                if (sequenceElement[0] >= sequenceEnd) {
+                    sequenceElement[0] = sequenceStart;
+                    if (!this->loop) aliveFlags[i] = 0;
+                }
+            }
+        }
+    }
 }
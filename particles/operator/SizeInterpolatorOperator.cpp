@@ -21,4 +21,23 @@ namespace Core {
         }
         return true;
     }
+
+    void SizeInterpolatorOperator::updateStates(ParticleStateAttributeArray& states, UInt32 start, UInt32 count, Real timeDelta, Byte* aliveFlags) {
+        const ParticleStateColumns& columns = states.getColumns();
+        const UInt32 stride = ParticleStateColumns::Vector2Stride;
+        Vector2r size;
+        for (UInt32 i = start; i < start + count; i++) {
+            if (!aliveFlags[i]) continue;
+            this->interpolationElements.getInterpolatedElement(InterpolatorOperator::getInterpolationT(columns, i), size);
+            Real* particleSize = columns.sizes + i * stride;
+            if (this->relativeToInitialValue) {
+                const Real* initialSize = columns.initialSizes + i * stride;
+                particleSize[0] = initialSize[0] * size.x;
+                particleSize[1] = initialSize[1] * size.y;
+            } else {
+                particleSize[0] = size.x;
+                particleSize[1] = size.y;
+            }
+        }
+    }
 }
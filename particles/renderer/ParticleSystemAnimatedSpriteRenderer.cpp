@@ -12,13 +12,18 @@
 
 namespace Core {
 
+    const UInt32 ParticleSystemAnimatedSpriteRenderer::InterleavedComponentCount;
+
     ParticleSystemAnimatedSpriteRenderer::ParticleSystemAnimatedSpriteRenderer(WeakPointer<Object3D> owner):
-        ParticleSystemRenderer(owner) {}
+        ParticleSystemRenderer(owner), interleavedVertexStreams(false), ringBufferedUploads(false), interleavedParticleCapacity(0) {}
 
     ParticleSystemAnimatedSpriteRenderer::~ParticleSystemAnimatedSpriteRenderer() {
         if (this->material.isValid()) {
             Engine::safeReleaseObject(this->material);
         }
+        if (this->interleavedGPUStorage.isValid()) {
+            Engine::safeReleaseObject(this->interleavedGPUStorage);
+        }
     }
 
     Bool ParticleSystemAnimatedSpriteRenderer::init() {
@@ -69,6 +74,22 @@ namespace Core {
         return this->material;
     }
 
+    void ParticleSystemAnimatedSpriteRenderer::setInterleavedVertexStreams(Bool interleaved) {
+        this->interleavedVertexStreams = interleaved;
+    }
+
+    Bool ParticleSystemAnimatedSpriteRenderer::getInterleavedVertexStreams() const {
+        return this->interleavedVertexStreams;
+    }
+
+    void ParticleSystemAnimatedSpriteRenderer::setRingBufferedUploads(Bool ringBuffered) {
+        this->ringBufferedUploads = ringBuffered;
+    }
+
+    Bool ParticleSystemAnimatedSpriteRenderer::getRingBufferedUploads() const {
+        return this->ringBufferedUploads;
+    }
+
     Bool ParticleSystemAnimatedSpriteRenderer::forwardRender(const ViewDescriptor& viewDescriptor, const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting) {
         return true;
     }
@@ -97,48 +118,107 @@ namespace Core {
         if (viewMatrixLoc >= 0) shader->setUniformMatrix4(viewMatrixLoc, viewDescriptor.inverseCameraTransformation);
 
         ParticleStateAttributeArray& particleStates = particleSystem->getParticleStates();
+        UInt32 activeParticleCount = particleSystem->getActiveParticleCount();
+        if (this->interleavedVertexStreams) {
+            this->sendInterleavedVertexStreams(particleStates, activeParticleCount, maxActiveParticles);
+        } else {
+            this->sendSeparateVertexStreams(particleStates, activeParticleCount);
+        }
+
+        this->material->sendCustomUniformsToShader();
+
+        Engine::instance()->getGraphicsSystem()->drawBoundVertexBuffer(activeParticleCount, PrimitiveType::Points);
 
+        Int32 locations[] = {this->material->getWorldPositionLocation(), this->material->getSizeLocation(), this->material->getRotationLocation(),
+                             this->material->getSequenceElementLocation(), this->material->getColorLocation()};
+        WeakPointer<AttributeArrayGPUStorage> gpuStorages[] = {particleStates.getPositions()->getGPUStorage(), particleStates.getSizes()->getGPUStorage(),
+                                                               particleStates.getRotations()->getGPUStorage(), particleStates.getSequenceElements()->getGPUStorage(),
+                                                               particleStates.getColors()->getGPUStorage()};
+        for (UInt32 i = 0; i < 5; i++) {
+            WeakPointer<AttributeArrayGPUStorage> gpuStorage = this->interleavedVertexStreams ? this->interleavedGPUStorage : gpuStorages[i];
+            if (locations[i] >= 0 && gpuStorage.isValid()) gpuStorage->disable(locations[i]);
+        }
+
+        return true;
+    }
+
+    /*
+     * Particles are kept packed at the front of the particle state arrays, so only the first [activeParticleCount]
+     * elements of each array need to go to the GPU.
+     */
+    void ParticleSystemAnimatedSpriteRenderer::sendSeparateVertexStreams(ParticleStateAttributeArray& particleStates, UInt32 activeParticleCount) {
         Int32 worldPositionLocation = this->material->getWorldPositionLocation();
         WeakPointer<AttributeArray<Point3rs>> positions = particleStates.getPositions();
         WeakPointer<AttributeArrayGPUStorage> positionsGPUStorage = positions->getGPUStorage();
-        positions->updateGPUStorageData();
+        if (positionsGPUStorage.isValid()) positionsGPUStorage->setRingBuffered(this->ringBufferedUploads);
+        positions->updateGPUStorageData(activeParticleCount);
         if (positionsGPUStorage.isValid()) positionsGPUStorage->enableAndSendToActiveShader(worldPositionLocation);
 
         Int32 sizeLocation = this->material->getSizeLocation();
         WeakPointer<AttributeArray<Vector2rs>> sizes = particleStates.getSizes();
         WeakPointer<AttributeArrayGPUStorage> sizesGPUStorage = sizes->getGPUStorage();
-        sizes->updateGPUStorageData();
-        if (sizesGPUStorage.isValid()) {
-            sizesGPUStorage->enableAndSendToActiveShader(sizeLocation);
-        }
+        if (sizesGPUStorage.isValid()) sizesGPUStorage->setRingBuffered(this->ringBufferedUploads);
+        sizes->updateGPUStorageData(activeParticleCount);
+        if (sizesGPUStorage.isValid()) sizesGPUStorage->enableAndSendToActiveShader(sizeLocation);
 
         Int32 rotationLocation = this->material->getRotationLocation();
         WeakPointer<ScalarAttributeArray<Real>> rotations = particleStates.getRotations();
         WeakPointer<AttributeArrayGPUStorage> rotationsGPUStorage = rotations->getGPUStorage();
-        rotations->updateGPUStorageData();
+        if (rotationsGPUStorage.isValid()) rotationsGPUStorage->setRingBuffered(this->ringBufferedUploads);
+        rotations->updateGPUStorageData(activeParticleCount);
         if (rotationsGPUStorage.isValid()) rotationsGPUStorage->enableAndSendToActiveShader(rotationLocation);
 
         Int32 sequenceElementLocation = this->material->getSequenceElementLocation();
         WeakPointer<AttributeArray<Vector4rs>> sequenceElements = particleStates.getSequenceElements();
         WeakPointer<AttributeArrayGPUStorage> sequenceElementsGPUStorage = sequenceElements->getGPUStorage();
-        sequenceElements->updateGPUStorageData();
+        if (sequenceElementsGPUStorage.isValid()) sequenceElementsGPUStorage->setRingBuffered(this->ringBufferedUploads);
+        sequenceElements->updateGPUStorageData(activeParticleCount);
         if (sequenceElementsGPUStorage.isValid()) sequenceElementsGPUStorage->enableAndSendToActiveShader(sequenceElementLocation);
 
         Int32 colorLocation = this->material->getColorLocation();
         WeakPointer<AttributeArray<ColorS>> colors = particleStates.getColors();
         WeakPointer<AttributeArrayGPUStorage> colorsGPUStorage = colors->getGPUStorage();
-        colors->updateGPUStorageData();
+        if (colorsGPUStorage.isValid()) colorsGPUStorage->setRingBuffered(this->ringBufferedUploads);
+        colors->updateGPUStorageData(activeParticleCount);
         if (colorsGPUStorage.isValid()) colorsGPUStorage->enableAndSendToActiveShader(colorLocation);
+    }
 
-        this->material->sendCustomUniformsToShader();
-
-        Engine::instance()->getGraphicsSystem()->drawBoundVertexBuffer(particleSystem->getActiveParticleCount(), PrimitiveType::Points);
+    void ParticleSystemAnimatedSpriteRenderer::sendInterleavedVertexStreams(ParticleStateAttributeArray& particleStates, UInt32 activeParticleCount,
+                                                                            UInt32 maxActiveParticles) {
+        if (maxActiveParticles != this->interleavedParticleCapacity || !this->interleavedGPUStorage.isValid()) {
+            if (this->interleavedGPUStorage.isValid()) Engine::safeReleaseObject(this->interleavedGPUStorage);
+            this->interleavedVertexData.resize(maxActiveParticles * InterleavedComponentCount);
+            this->interleavedGPUStorage = Engine::instance()->createGPUStorage(maxActiveParticles * InterleavedComponentCount * sizeof(Real),
+                                                                              InterleavedComponentCount, AttributeType::Float, false);
+            this->interleavedParticleCapacity = maxActiveParticles;
+        }
 
-        positionsGPUStorage->disable(worldPositionLocation);
-        sizesGPUStorage->disable(sizeLocation);
-        rotationsGPUStorage->disable(rotationLocation);
+        const Real* positions = particleStates.getPositions()->getStorage();
+        const Real* sizes = particleStates.getSizes()->getStorage();
+        const Real* rotations = particleStates.getRotations()->getAttributes();
+        const Real* sequenceElements = particleStates.getSequenceElements()->getStorage();
+        const Real* colors = particleStates.getColors()->getStorage();
+        Real* vertex = this->interleavedVertexData.data();
+        for (UInt32 i = 0; i < activeParticleCount; i++) {
+            for (UInt32 c = 0; c < Point3rs::ComponentCount; c++) *(vertex++) = positions[i * Point3rs::ComponentCount + c];
+            for (UInt32 c = 0; c < Vector2rs::ComponentCount; c++) *(vertex++) = sizes[i * Vector2rs::ComponentCount + c];
+            *(vertex++) = rotations[i];
+            for (UInt32 c = 0; c < Vector4rs::ComponentCount; c++) *(vertex++) = sequenceElements[i * Vector4rs::ComponentCount + c];
+            for (UInt32 c = 0; c < ColorS::ComponentCount; c++) *(vertex++) = colors[i * ColorS::ComponentCount + c];
+        }
 
-        return true;
+        this->interleavedGPUStorage->setRingBuffered(this->ringBufferedUploads);
+        this->interleavedGPUStorage->updateBufferRange(this->interleavedVertexData.data(), 0, activeParticleCount * InterleavedComponentCount * sizeof(Real));
+
+        Int32 locations[] = {this->material->getWorldPositionLocation(), this->material->getSizeLocation(), this->material->getRotationLocation(),
+                             this->material->getSequenceElementLocation(), this->material->getColorLocation()};
+        UInt32 componentCounts[] = {Point3rs::ComponentCount, Vector2rs::ComponentCount, 1, Vector4rs::ComponentCount, ColorS::ComponentCount};
+        UInt32 byteStride = InterleavedComponentCount * sizeof(Real);
+        UInt32 byteOffset = 0;
+        for (UInt32 i = 0; i < 5; i++) {
+            if (locations[i] >= 0) this->interleavedGPUStorage->enableAndSendToActiveShader(locations[i], componentCounts[i], byteStride, byteOffset);
+            byteOffset += componentCounts[i] * sizeof(Real);
+        }
     }
 
     Bool ParticleSystemAnimatedSpriteRenderer::supportsRenderPath(RenderPath renderPath) {
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "../../util/PersistentWeakPointer.h"
 #include "../../common/types.h"
 #include "ParticleSystemRenderer.h"
@@ -12,11 +14,16 @@ namespace Core {
     class Object3D;
     class Graphics;
     class ParticleStandardMaterial;
+    class AttributeArrayGPUStorage;
 
     class ParticleSystemAnimatedSpriteRenderer final: public ParticleSystemRenderer {
         friend class Engine;
 
     public:
+        // floats per particle in the interleaved vertex stream: position, size, rotation, sequence element, color
+        static const UInt32 InterleavedComponentCount = Point3rs::ComponentCount + Vector2rs::ComponentCount + 1 +
+                                                        Vector4rs::ComponentCount + ColorS::ComponentCount;
+
         ~ParticleSystemAnimatedSpriteRenderer() override;
         Bool forwardRender(const ViewDescriptor& viewDescriptor, const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting) override;
         Bool forwardRenderObject(const ViewDescriptor& viewDescriptor, WeakPointer<BaseRenderable> renderable, Bool isStatic,
@@ -30,10 +37,26 @@ namespace Core {
         void setRenderState();
         WeakPointer<ParticleStandardMaterial> getMaterial();
 
+        void setInterleavedVertexStreams(Bool interleaved);
+        Bool getInterleavedVertexStreams() const;
+        void setRingBufferedUploads(Bool ringBuffered);
+        Bool getRingBufferedUploads() const;
+
     protected:
         ParticleSystemAnimatedSpriteRenderer(WeakPointer<Object3D> owner);
 
+        void sendSeparateVertexStreams(ParticleStateAttributeArray& particleStates, UInt32 activeParticleCount);
+        void sendInterleavedVertexStreams(ParticleStateAttributeArray& particleStates, UInt32 activeParticleCount, UInt32 maxActiveParticles);
+
         ParticleStateAttributeArray renderAttributes;
         PersistentWeakPointer<ParticleStandardMaterial> material;
+
+        // pack position, size, rotation, sequence element & color of each particle into one buffer, so a frame
+        // makes a single upload instead of one per attribute
+        Bool interleavedVertexStreams;
+        Bool ringBufferedUploads;
+        std::vector<Real> interleavedVertexData;
+        PersistentWeakPointer<AttributeArrayGPUStorage> interleavedGPUStorage;
+        UInt32 interleavedParticleCapacity;
     };
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "BaseRenderableContainer.h"
 #include "BaseObject3DRenderer.h"
 #include "BaseRenderable.h"
+#include "../scene/Object3D.h"
 
 namespace Core {
 
@@ -14,6 +15,7 @@ namespace Core {
 
     void BaseRenderableContainer::addBaseRenderable(WeakPointer<BaseRenderable> renderable) {
         this->renderables.push_back(renderable);
+        if (this->owner.isValid()) this->owner->invalidateRenderState();
     }
 
     UInt32 BaseRenderableContainer::getBaseRenderableCount() const {
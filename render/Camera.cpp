@@ -31,6 +31,8 @@ namespace Core {
         this->depthOutputOverride = DepthOutputOverride::None;
         this->overrideMaterial = WeakPointer<Material>::nullPtr();
         this->skyboxEnabled = false;
+        this->frustumCullingEnabled = true;
+        this->clusteredLightingEnabled = false;
     }
 
     Camera::~Camera() {
@@ -185,6 +187,10 @@ namespace Core {
         this->skybox = other->skybox;
         this->skyboxEnabled = other->skyboxEnabled;
         this->hdrEnabled = other->hdrEnabled;
+        this->frustumCullingEnabled = other->frustumCullingEnabled;
+        this->clusteredLightingEnabled = other->clusteredLightingEnabled;
+        this->lightClusterGrid.setDimensions(other->lightClusterGrid.getTileCountX(), other->lightClusterGrid.getTileCountY(),
+                                             other->lightClusterGrid.getSliceCount());
         this->projectionMatrix.copy(other->projectionMatrix);
 
         // TODO: Do we need a deep copy here?
@@ -281,6 +287,37 @@ namespace Core {
         this->depthOutputOverride = depthOutputOverride;
     }
 
+    void Camera::setFrustumCullingEnabled(Bool enabled) {
+        this->frustumCullingEnabled = enabled;
+    }
+
+    Bool Camera::isFrustumCullingEnabled() const {
+        return this->frustumCullingEnabled;
+    }
+
+    void Camera::setClusteredLightingEnabled(Bool enabled) {
+        this->clusteredLightingEnabled = enabled;
+    }
+
+    Bool Camera::isClusteredLightingEnabled() const {
+        return this->clusteredLightingEnabled;
+    }
+
+    LightClusterGrid& Camera::getLightClusterGrid() {
+        return this->lightClusterGrid;
+    }
+
+    /*
+     * Build the world-space view frustum of this camera from its current projection
+     * and the world matrix of its owner.
+     */
+    void Camera::buildFrustum(Frustum& frustum) {
+        Matrix4x4 viewProjection = this->getOwner()->getTransform().getWorldMatrix();
+        viewProjection.invert();
+        viewProjection.preMultiply(this->projectionMatrix);
+        frustum.setFromMatrix(viewProjection);
+    }
+
     void Camera::buildPerspectiveProjectionMatrix(Real fov, Real aspectRatio, Real nearP, Real farP, Matrix4x4& out) {
         Real xMag = Math::abs(nearP * Math::tan(fov * 0.5f));
         Real yMag = xMag / aspectRatio;
@@ -9,9 +9,11 @@
 #include "../render/ToneMapType.h"
 #include "../base/BitMask.h"
 #include "../geometry/Ray.h"
+#include "../geometry/Frustum.h"
 #include "../scene/Skybox.h"
 #include "../image/CubeTexture.h"
 #include "../render/DepthOutputOverride.h"
+#include "../render/LightClusterGrid.h"
 
 namespace Core {
 
@@ -86,6 +88,14 @@ namespace Core {
         DepthOutputOverride getDepthOutputOverride();
         void setDepthOutputOverride(DepthOutputOverride depthOutputOverride);
 
+        void setFrustumCullingEnabled(Bool enabled);
+        Bool isFrustumCullingEnabled() const;
+        void buildFrustum(Frustum& frustum);
+
+        void setClusteredLightingEnabled(Bool enabled);
+        Bool isClusteredLightingEnabled() const;
+        LightClusterGrid& getLightClusterGrid();
+
         static void buildPerspectiveProjectionMatrix(Real fov, Real aspectRatio, Real near, Real far, Matrix4x4& out);
         static void buildOrthographicProjectionMatrix(Real top, Real bottom, Real left, Real right, Real near, Real far, Matrix4x4& matrix);
 
@@ -131,6 +141,13 @@ namespace Core {
 
         PersistentWeakPointer<Material> overrideMaterial;
         DepthOutputOverride depthOutputOverride;
+
+        Bool frustumCullingEnabled;
+
+        // rebuilt by the renderer every time the camera is rendered while clustered lighting is enabled both here
+        // and on the renderer, see Renderer::setClusteredLightingEnabled()
+        Bool clusteredLightingEnabled;
+        LightClusterGrid lightClusterGrid;
         
     };
 }
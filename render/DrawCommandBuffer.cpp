@@ -0,0 +1,138 @@
+#include <string.h>
+
+#include "DrawCommandBuffer.h"
+#include "../common/Exception.h"
+
+namespace Core {
+
+    DrawCommandBuffer::DrawCommandBuffer() {
+    }
+
+    void DrawCommandBuffer::clear() {
+        this->commands.clear();
+        this->shaderSlots.clear();
+        this->materialSlots.clear();
+        this->meshSlots.clear();
+    }
+
+    void DrawCommandBuffer::addOpaqueCommand(RenderItem* renderItem, UInt32 queueID, UInt64 shaderID, UInt64 materialID, UInt64 meshID, Real depth) {
+        UInt16 shaderSlot = getSlot(this->shaderSlots, shaderID, 0x3FFF);
+        UInt16 materialSlot = getSlot(this->materialSlots, materialID, 0x3FFF);
+        UInt16 meshSlot = getSlot(this->meshSlots, meshID, 0xFFF);
+        UInt64 sortKey = (getQueueBits(queueID) << 52) |
+                         ((UInt64)shaderSlot << 38) |
+                         ((UInt64)materialSlot << 24) |
+                         ((UInt64)meshSlot << 12) |
+                         (getDepthBits(depth) >> 20);
+        this->addCommand(sortKey, renderItem, shaderSlot, materialSlot, meshSlot);
+    }
+
+    void DrawCommandBuffer::addTransparentCommand(RenderItem* renderItem, UInt32 queueID, Real depth, UInt64 shaderID, UInt64 materialID, UInt64 meshID) {
+        UInt16 shaderSlot = getSlot(this->shaderSlots, shaderID, 0x3FFF);
+        UInt16 materialSlot = getSlot(this->materialSlots, materialID, 0x3FFF);
+        UInt16 meshSlot = getSlot(this->meshSlots, meshID, 0xFFF);
+        UInt64 farToNear = (~getDepthBits(depth) >> 8) & 0xFFFFFF;
+        UInt64 sortKey = (getQueueBits(queueID) << 52) |
+                         (farToNear << 28) |
+                         ((UInt64)shaderSlot << 14) |
+                         (UInt64)materialSlot;
+        this->addCommand(sortKey, renderItem, shaderSlot, materialSlot, meshSlot);
+    }
+
+    void DrawCommandBuffer::addCommand(UInt64 sortKey, RenderItem* renderItem, UInt16 shaderSlot, UInt16 materialSlot, UInt16 meshSlot) {
+        this->commands.push_back({sortKey, renderItem, shaderSlot, materialSlot, meshSlot});
+    }
+
+    /*
+     * LSD radix sort over the eight bytes of the sort key. Histograms for every byte are gathered in a single
+     * pass, and bytes that hold the same value for every key (typically the queue and, within a view, most of
+     * the shader bits) are skipped entirely.
+     */
+    void DrawCommandBuffer::sort() {
+        UInt32 commandCount = this->commands.size();
+        if (commandCount < 2) return;
+
+        UInt32 histograms[8][256];
+        memset(histograms, 0, sizeof(histograms));
+        for (UInt32 i = 0; i < commandCount; i++) {
+            UInt64 key = this->commands[i].sortKey;
+            for (UInt32 b = 0; b < 8; b++) {
+                histograms[b][(key >> (b * 8)) & 0xFF]++;
+            }
+        }
+
+        this->sortScratch.resize(commandCount);
+        for (UInt32 b = 0; b < 8; b++) {
+            UInt32* histogram = histograms[b];
+            UInt32 firstKeyByte = (this->commands[0].sortKey >> (b * 8)) & 0xFF;
+            if (histogram[firstKeyByte] == commandCount) continue;
+
+            UInt32 offset = 0;
+            for (UInt32 v = 0; v < 256; v++) {
+                UInt32 count = histogram[v];
+                histogram[v] = offset;
+                offset += count;
+            }
+
+            for (UInt32 i = 0; i < commandCount; i++) {
+                const DrawCommand& command = this->commands[i];
+                UInt32 keyByte = (command.sortKey >> (b * 8)) & 0xFF;
+                this->sortScratch[histogram[keyByte]++] = command;
+            }
+            this->commands.swap(this->sortScratch);
+        }
+    }
+
+    /*
+     * Count the shader, material and mesh switches that executing the commands in their current order would take.
+     */
+    void DrawCommandBuffer::countStateChanges(StateChanges& stateChanges) const {
+        for (UInt32 i = 0; i < this->commands.size(); i++) {
+            const DrawCommand& command = this->commands[i];
+            if (i == 0 || command.shaderSlot != this->commands[i - 1].shaderSlot) stateChanges.shaderChanges++;
+            if (i == 0 || command.materialSlot != this->commands[i - 1].materialSlot) stateChanges.materialChanges++;
+            if (i == 0 || command.meshSlot != this->commands[i - 1].meshSlot) stateChanges.meshChanges++;
+        }
+    }
+
+    UInt32 DrawCommandBuffer::getCommandCount() const {
+        return this->commands.size();
+    }
+
+    const DrawCommandBuffer::DrawCommand& DrawCommandBuffer::getCommand(UInt32 index) const {
+        if (index >= this->commands.size()) {
+            throw OutOfRangeException("DrawCommandBuffer::getCommand -> Index is out of bounds.");
+        }
+        return this->commands[index];
+    }
+
+    /*
+     * Slot for [objectID] in first-seen order. Once [maxSlot] is reached all further objects share the last slot.
+     */
+    UInt16 DrawCommandBuffer::getSlot(std::unordered_map<UInt64, UInt16>& slots, UInt64 objectID, UInt16 maxSlot) {
+        auto result = slots.find(objectID);
+        if (result != slots.end()) return result->second;
+        UInt16 slot = slots.size() < maxSlot ? (UInt16)slots.size() : maxSlot;
+        slots[objectID] = slot;
+        return slot;
+    }
+
+    /*
+     * Queue IDs from 4095 up share the last slot.
+     */
+    UInt64 DrawCommandBuffer::getQueueBits(UInt32 queueID) {
+        return queueID < 0xFFF ? queueID : 0xFFF;
+    }
+
+    /*
+     * Order-preserving 32-bit encoding of a non-negative depth: the bit pattern of a non-negative IEEE float grows
+     * with its value. Bit 31 (the sign) is dropped so the result is a 32-bit value with the most significant
+     * bits first.
+     */
+    UInt32 DrawCommandBuffer::getDepthBits(Real depth) {
+        float value = depth > 0.0f ? (float)depth : 0.0f;
+        UInt32 bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits << 1;
+    }
+}
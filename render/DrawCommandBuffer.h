@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include "../common/types.h"
+
+namespace Core {
+
+    // forward declarations
+    class RenderItem;
+
+    /*
+     * Draw packets recorded for a single view. Each packet pairs a render item with a 64-bit sort key; sort() orders
+     * the packets by key (stable, so equal keys keep their recording order) and the renderer then executes them in
+     * that order. Keys are laid out as:
+     *
+     *   opaque:      queue (12) | shader (14) | material (14) | mesh (12) | depth, near to far (12)
+     *   transparent: queue (12) | depth, far to near (24) | shader (14) | material (14)
+     *
+     * Shaders, materials and meshes are not keyed by object ID but by a dense slot handed out in first-recorded
+     * order. The last value of each field is shared by everything past the limit, so grouping is exact for up to
+     * 16383 shaders, 16383 materials and 4095 meshes per view.
+     */
+    class DrawCommandBuffer {
+    public:
+
+        class DrawCommand {
+        public:
+            UInt64 sortKey;
+            RenderItem* renderItem;
+            UInt16 shaderSlot;
+            UInt16 materialSlot;
+            UInt16 meshSlot;
+        };
+
+        class StateChanges {
+        public:
+            UInt32 shaderChanges = 0;
+            UInt32 materialChanges = 0;
+            UInt32 meshChanges = 0;
+        };
+
+        DrawCommandBuffer();
+
+        void clear();
+        void addOpaqueCommand(RenderItem* renderItem, UInt32 queueID, UInt64 shaderID, UInt64 materialID, UInt64 meshID, Real depth);
+        void addTransparentCommand(RenderItem* renderItem, UInt32 queueID, Real depth, UInt64 shaderID, UInt64 materialID, UInt64 meshID);
+        void sort();
+        void countStateChanges(StateChanges& stateChanges) const;
+        UInt32 getCommandCount() const;
+        const DrawCommand& getCommand(UInt32 index) const;
+
+    private:
+        void addCommand(UInt64 sortKey, RenderItem* renderItem, UInt16 shaderSlot, UInt16 materialSlot, UInt16 meshSlot);
+        static UInt16 getSlot(std::unordered_map<UInt64, UInt16>& slots, UInt64 objectID, UInt16 maxSlot);
+        static UInt64 getQueueBits(UInt32 queueID);
+        static UInt32 getDepthBits(Real depth);
+
+        std::vector<DrawCommand> commands;
+        std::vector<DrawCommand> sortScratch;
+        std::unordered_map<UInt64, UInt16> shaderSlots;
+        std::unordered_map<UInt64, UInt16> materialSlots;
+        std::unordered_map<UInt64, UInt16> meshSlots;
+    };
+}
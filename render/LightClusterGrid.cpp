@@ -0,0 +1,289 @@
+#include <algorithm>
+
+#include "LightClusterGrid.h"
+#include "../light/LightPack.h"
+#include "../light/PointLight.h"
+#include "../scene/Object3D.h"
+#include "../util/WorkerPool.h"
+#include "../math/Math.h"
+#include "../common/Exception.h"
+
+namespace Core {
+
+    const UInt32 LightClusterGrid::DefaultTileCountX;
+    const UInt32 LightClusterGrid::DefaultTileCountY;
+    const UInt32 LightClusterGrid::DefaultSliceCount;
+    const UInt32 LightClusterGrid::LightDataComponentCount;
+
+    LightClusterGrid::LightClusterGrid() {
+        this->setDimensions(DefaultTileCountX, DefaultTileCountY, DefaultSliceCount);
+    }
+
+    void LightClusterGrid::setDimensions(UInt32 tileCountX, UInt32 tileCountY, UInt32 sliceCount) {
+        if (tileCountX == 0 || tileCountY == 0 || sliceCount == 0) {
+            throw InvalidArgumentException("LightClusterGrid::setDimensions() -> Grid dimensions must be greater than zero.");
+        }
+        this->tileCountX = tileCountX;
+        this->tileCountY = tileCountY;
+        this->sliceCount = sliceCount;
+        this->clusterBounds.resize(this->getClusterCount());
+        this->clusterLightRanges.assign(this->getClusterCount() * 2, 0);
+        this->lightIndices.resize(0);
+        this->sliceLights.resize(sliceCount);
+    }
+
+    UInt32 LightClusterGrid::getTileCountX() const {
+        return this->tileCountX;
+    }
+
+    UInt32 LightClusterGrid::getTileCountY() const {
+        return this->tileCountY;
+    }
+
+    UInt32 LightClusterGrid::getSliceCount() const {
+        return this->sliceCount;
+    }
+
+    UInt32 LightClusterGrid::getClusterCount() const {
+        return this->tileCountX * this->tileCountY * this->sliceCount;
+    }
+
+    UInt32 LightClusterGrid::getClusterIndex(UInt32 tileX, UInt32 tileY, UInt32 slice) const {
+        return (slice * this->tileCountY + tileY) * this->tileCountX + tileX;
+    }
+
+    const Box3& LightClusterGrid::getClusterBounds(UInt32 clusterIndex) const {
+        if (clusterIndex >= this->clusterBounds.size()) {
+            throw OutOfRangeException("LightClusterGrid::getClusterBounds() -> 'clusterIndex' is out of range.");
+        }
+        return this->clusterBounds[clusterIndex];
+    }
+
+    /*
+     * [viewMatrix] takes world space to the camera's view space (the inverse of the camera's world matrix).
+     */
+    void LightClusterGrid::build(const Matrix4x4& projection, const Matrix4x4& viewMatrix, Real near, Real far,
+                                 const LightPack& lightPack, WorkerPool* workerPool) {
+        this->prepare(projection, viewMatrix, near, far, lightPack);
+        if (workerPool != nullptr) {
+            workerPool->execute(this->sliceCount, [this](UInt32 slice) {
+                this->assignSlice(slice);
+            });
+        } else {
+            for (UInt32 slice = 0; slice < this->sliceCount; slice++) this->assignSlice(slice);
+        }
+        this->gatherSlices();
+        this->updateStats();
+    }
+
+    void LightClusterGrid::buildBruteForce(const Matrix4x4& projection, const Matrix4x4& viewMatrix, Real near, Real far,
+                                           const LightPack& lightPack) {
+        this->prepare(projection, viewMatrix, near, far, lightPack);
+        this->lightIndices.resize(0);
+        this->stats.testedPairs = 0;
+        for (UInt32 c = 0; c < this->getClusterCount(); c++) {
+            this->clusterLightRanges[c * 2] = this->lightIndices.size();
+            for (UInt32 l = 0; l < this->lightSpheres.size(); l++) {
+                const LightSphere& sphere = this->lightSpheres[l];
+                this->stats.testedPairs++;
+                if (this->clusterBounds[c].intersectsSphere(sphere.center, sphere.radius)) this->lightIndices.push_back(l);
+            }
+            this->clusterLightRanges[c * 2 + 1] = this->lightIndices.size() - this->clusterLightRanges[c * 2];
+        }
+        this->updateStats();
+    }
+
+    const std::vector<UInt32>& LightClusterGrid::getClusterLightRanges() const {
+        return this->clusterLightRanges;
+    }
+
+    const std::vector<UInt32>& LightClusterGrid::getLightIndices() const {
+        return this->lightIndices;
+    }
+
+    const std::vector<Real>& LightClusterGrid::getLightData() const {
+        return this->lightData;
+    }
+
+    const LightClusterGrid::Stats& LightClusterGrid::getStats() const {
+        return this->stats;
+    }
+
+    /*
+     * Compute the cluster bounds and move the point lights into view space.
+     */
+    void LightClusterGrid::prepare(const Matrix4x4& projection, const Matrix4x4& viewMatrix, Real near, Real far, const LightPack& lightPack) {
+        this->buildClusterBounds(projection, near, far);
+
+        const std::vector<WeakPointer<PointLight>>& pointLights = lightPack.getPointLights();
+        this->lightSpheres.resize(pointLights.size());
+        this->lightData.resize(pointLights.size() * LightDataComponentCount);
+        for (UInt32 i = 0; i < pointLights.size(); i++) {
+            WeakPointer<PointLight> pointLight = pointLights[i];
+            const Real* worldMatrix = pointLight->getOwner()->getTransform().getConstWorldMatrix().getConstData();
+            Point3r position(worldMatrix[12], worldMatrix[13], worldMatrix[14]);
+            viewMatrix.transform(position);
+            LightSphere& sphere = this->lightSpheres[i];
+            sphere.center = position;
+            sphere.radius = pointLight->getRadius();
+
+            const Color& color = pointLight->getColor();
+            Real intensity = pointLight->getIntensity();
+            Real* data = &this->lightData[i * LightDataComponentCount];
+            data[0] = position.x;
+            data[1] = position.y;
+            data[2] = position.z;
+            data[3] = sphere.radius;
+            data[4] = color.r * intensity;
+            data[5] = color.g * intensity;
+            data[6] = color.b * intensity;
+            data[7] = pointLight->getAttenuation();
+        }
+    }
+
+    /*
+     * Each cluster's box encloses the points where the rays through its tile's corners cross the near and far
+     * depths of its slice. The rays come from unprojecting the tile corners at both ends of the NDC depth range,
+     * so perspective and orthographic projections are handled alike.
+     */
+    void LightClusterGrid::buildClusterBounds(const Matrix4x4& projection, Real near, Real far) {
+        Matrix4x4 inverseProjection = projection;
+        inverseProjection.invert();
+
+        UInt32 cornerCountX = this->tileCountX + 1;
+        UInt32 cornerCountY = this->tileCountY + 1;
+        std::vector<Point3r> rayStarts(cornerCountX * cornerCountY);
+        std::vector<Point3r> rayEnds(cornerCountX * cornerCountY);
+        for (UInt32 y = 0; y < cornerCountY; y++) {
+            for (UInt32 x = 0; x < cornerCountX; x++) {
+                Real ndcX = -1.0f + 2.0f * (Real)x / (Real)this->tileCountX;
+                Real ndcY = -1.0f + 2.0f * (Real)y / (Real)this->tileCountY;
+                Point3r& start = rayStarts[y * cornerCountX + x];
+                Point3r& end = rayEnds[y * cornerCountX + x];
+                start.set(ndcX, ndcY, -1.0f);
+                end.set(ndcX, ndcY, 1.0f);
+                inverseProjection.transform(start);
+                inverseProjection.transform(end);
+            }
+        }
+
+        for (UInt32 s = 0; s < this->sliceCount; s++) {
+            Real depths[2];
+            for (UInt32 d = 0; d < 2; d++) {
+                Real t = (Real)(s + d) / (Real)this->sliceCount;
+                depths[d] = near > 0.0f ? near * Math::pow(far / near, t) : near + (far - near) * t;
+            }
+            for (UInt32 y = 0; y < this->tileCountY; y++) {
+                for (UInt32 x = 0; x < this->tileCountX; x++) {
+                    Box3& bounds = this->clusterBounds[this->getClusterIndex(x, y, s)];
+                    Bool first = true;
+                    for (UInt32 corner = 0; corner < 4; corner++) {
+                        UInt32 cornerIndex = (y + corner / 2) * cornerCountX + x + corner % 2;
+                        const Point3r& start = rayStarts[cornerIndex];
+                        const Point3r& end = rayEnds[cornerIndex];
+                        for (UInt32 d = 0; d < 2; d++) {
+                            // the view looks down -z
+                            Real t = (-depths[d] - start.z) / (end.z - start.z);
+                            Point3r point(start.x + (end.x - start.x) * t, start.y + (end.y - start.y) * t, -depths[d]);
+                            if (first) {
+                                bounds.setMin(point.x, point.y, point.z);
+                                bounds.setMax(point.x, point.y, point.z);
+                                first = false;
+                            } else {
+                                bounds.expandByPoint(point);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    /*
+     * Only lights that reach the slice's bounds are considered, and for each only the tiles whose column and row
+     * extents overlap its sphere. Those filters never reject a cluster the exact sphere/box test would accept, so
+     * the result matches buildBruteForce().
+     */
+    void LightClusterGrid::assignSlice(UInt32 slice) {
+        SliceLights& sliceLights = this->sliceLights[slice];
+        UInt32 tilesPerSlice = this->tileCountX * this->tileCountY;
+        UInt32 firstCluster = slice * tilesPerSlice;
+        sliceLights.pairs.resize(0);
+        sliceLights.testedPairs = 0;
+
+        // extents of each column and row of tiles across the whole slice
+        Box3 sliceBounds = this->clusterBounds[firstCluster];
+        sliceLights.columnExtents.resize(this->tileCountX * 2);
+        sliceLights.rowExtents.resize(this->tileCountY * 2);
+        for (UInt32 y = 0; y < this->tileCountY; y++) {
+            for (UInt32 x = 0; x < this->tileCountX; x++) {
+                const Box3& bounds = this->clusterBounds[firstCluster + y * this->tileCountX + x];
+                sliceBounds.expandByBox(bounds);
+                Real* column = &sliceLights.columnExtents[x * 2];
+                Real* row = &sliceLights.rowExtents[y * 2];
+                column[0] = y == 0 ? bounds.getMin().x : Math::min(column[0], bounds.getMin().x);
+                column[1] = y == 0 ? bounds.getMax().x : Math::max(column[1], bounds.getMax().x);
+                row[0] = x == 0 ? bounds.getMin().y : Math::min(row[0], bounds.getMin().y);
+                row[1] = x == 0 ? bounds.getMax().y : Math::max(row[1], bounds.getMax().y);
+            }
+        }
+
+        for (UInt32 l = 0; l < this->lightSpheres.size(); l++) {
+            const LightSphere& sphere = this->lightSpheres[l];
+            if (!sliceBounds.intersectsSphere(sphere.center, sphere.radius)) continue;
+
+            for (UInt32 y = 0; y < this->tileCountY; y++) {
+                const Real* row = &sliceLights.rowExtents[y * 2];
+                if (row[0] > sphere.center.y + sphere.radius || row[1] < sphere.center.y - sphere.radius) continue;
+                for (UInt32 x = 0; x < this->tileCountX; x++) {
+                    const Real* column = &sliceLights.columnExtents[x * 2];
+                    if (column[0] > sphere.center.x + sphere.radius || column[1] < sphere.center.x - sphere.radius) continue;
+                    UInt32 localCluster = y * this->tileCountX + x;
+                    sliceLights.testedPairs++;
+                    if (this->clusterBounds[firstCluster + localCluster].intersectsSphere(sphere.center, sphere.radius)) {
+                        sliceLights.pairs.push_back(localCluster);
+                        sliceLights.pairs.push_back(l);
+                    }
+                }
+            }
+        }
+
+        // counting sort by cluster; pairs were produced in light order, so each cluster's lights stay ascending
+        sliceLights.clusterCounts.assign(tilesPerSlice + 1, 0);
+        for (UInt32 p = 0; p < sliceLights.pairs.size(); p += 2) sliceLights.clusterCounts[sliceLights.pairs[p] + 1]++;
+        for (UInt32 c = 0; c < tilesPerSlice; c++) sliceLights.clusterCounts[c + 1] += sliceLights.clusterCounts[c];
+        sliceLights.clusterLights.resize(sliceLights.pairs.size() / 2);
+        for (UInt32 p = 0; p < sliceLights.pairs.size(); p += 2) {
+            UInt32& next = sliceLights.clusterCounts[sliceLights.pairs[p]];
+            sliceLights.clusterLights[next] = sliceLights.pairs[p + 1];
+            next++;
+        }
+        // 'clusterCounts[c]' is now the end of cluster c's lights
+    }
+
+    void LightClusterGrid::gatherSlices() {
+        UInt32 tilesPerSlice = this->tileCountX * this->tileCountY;
+        this->lightIndices.resize(0);
+        this->stats.testedPairs = 0;
+        for (UInt32 s = 0; s < this->sliceCount; s++) {
+            const SliceLights& sliceLights = this->sliceLights[s];
+            UInt32 base = this->lightIndices.size();
+            for (UInt32 c = 0; c < tilesPerSlice; c++) {
+                UInt32 start = c > 0 ? sliceLights.clusterCounts[c - 1] : 0;
+                UInt32 clusterIndex = s * tilesPerSlice + c;
+                this->clusterLightRanges[clusterIndex * 2] = base + start;
+                this->clusterLightRanges[clusterIndex * 2 + 1] = sliceLights.clusterCounts[c] - start;
+            }
+            this->lightIndices.insert(this->lightIndices.end(), sliceLights.clusterLights.begin(), sliceLights.clusterLights.end());
+            this->stats.testedPairs += sliceLights.testedPairs;
+        }
+    }
+
+    void LightClusterGrid::updateStats() {
+        this->stats.lightReferences = this->lightIndices.size();
+        this->stats.maxLightsInCluster = 0;
+        for (UInt32 c = 0; c < this->getClusterCount(); c++) {
+            this->stats.maxLightsInCluster = Math::max(this->stats.maxLightsInCluster, this->clusterLightRanges[c * 2 + 1]);
+        }
+    }
+}
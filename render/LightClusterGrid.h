@@ -0,0 +1,106 @@
+#pragma once
+
+#include <vector>
+
+#include "../common/types.h"
+#include "../geometry/Vector3.h"
+#include "../geometry/Box3.h"
+#include "../math/Matrix4x4.h"
+
+namespace Core {
+
+    // forward declarations
+    class LightPack;
+    class WorkerPool;
+
+    /*
+     * Froxel grid over a camera's view volume for clustered lighting. The screen is split into tiles and the view
+     * depth range into slices spaced exponentially (so clusters stay roughly as deep as they are wide), and every
+     * cluster gets the list of point lights whose bounding sphere touches the cluster's view-space bounding box.
+     *
+     * The results are kept in flat arrays that can be uploaded as they are:
+     *   - cluster light ranges: two UInt32 per cluster, the offset of its first entry in the light indices and its
+     *     light count. Clusters are ordered by tile x, then tile y, then slice (slowest).
+     *   - light indices: point light indices (in LightPack::getPointLights()), grouped by cluster and ascending
+     *     within a cluster.
+     *   - light data: LightDataComponentCount floats per point light; view-space position and radius, then color
+     *     scaled by intensity and the light's attenuation.
+     *
+     * build() assigns lights one slice per job on a WorkerPool. buildBruteForce() tests every light against every
+     * cluster on the calling thread and produces identical arrays, as a reference for build().
+     */
+    class LightClusterGrid {
+    public:
+        static const UInt32 DefaultTileCountX = 16;
+        static const UInt32 DefaultTileCountY = 9;
+        static const UInt32 DefaultSliceCount = 24;
+        static const UInt32 LightDataComponentCount = 8;
+
+        class Stats {
+        public:
+            // sphere/box overlap tests performed by the last build
+            UInt32 testedPairs = 0;
+            UInt32 lightReferences = 0;
+            UInt32 maxLightsInCluster = 0;
+        };
+
+        LightClusterGrid();
+
+        void setDimensions(UInt32 tileCountX, UInt32 tileCountY, UInt32 sliceCount);
+        UInt32 getTileCountX() const;
+        UInt32 getTileCountY() const;
+        UInt32 getSliceCount() const;
+        UInt32 getClusterCount() const;
+        UInt32 getClusterIndex(UInt32 tileX, UInt32 tileY, UInt32 slice) const;
+        const Box3& getClusterBounds(UInt32 clusterIndex) const;
+
+        void build(const Matrix4x4& projection, const Matrix4x4& viewMatrix, Real near, Real far,
+                   const LightPack& lightPack, WorkerPool* workerPool);
+        void buildBruteForce(const Matrix4x4& projection, const Matrix4x4& viewMatrix, Real near, Real far,
+                             const LightPack& lightPack);
+
+        const std::vector<UInt32>& getClusterLightRanges() const;
+        const std::vector<UInt32>& getLightIndices() const;
+        const std::vector<Real>& getLightData() const;
+        const Stats& getStats() const;
+
+    private:
+        class LightSphere {
+        public:
+            Point3r center;
+            Real radius;
+        };
+
+        // lights assigned to the clusters of one slice, sorted by cluster
+        class SliceLights {
+        public:
+            std::vector<UInt32> clusterLights;
+            std::vector<UInt32> clusterCounts;
+            // (cluster, light) pairs in light order, before sorting
+            std::vector<UInt32> pairs;
+            // min and max x of each column of tiles, and min and max y of each row
+            std::vector<Real> columnExtents;
+            std::vector<Real> rowExtents;
+            UInt32 testedPairs;
+        };
+
+        void prepare(const Matrix4x4& projection, const Matrix4x4& viewMatrix, Real near, Real far, const LightPack& lightPack);
+        void buildClusterBounds(const Matrix4x4& projection, Real near, Real far);
+        void assignSlice(UInt32 slice);
+        void gatherSlices();
+        void updateStats();
+
+        UInt32 tileCountX;
+        UInt32 tileCountY;
+        UInt32 sliceCount;
+
+        std::vector<Box3> clusterBounds;
+        std::vector<LightSphere> lightSpheres;
+        std::vector<SliceLights> sliceLights;
+
+        std::vector<UInt32> clusterLightRanges;
+        std::vector<UInt32> lightIndices;
+        std::vector<Real> lightData;
+        Stats stats;
+    };
+}
@@ -1,9 +0,0 @@
-#include "MaterialGroupedRenderQueue.h"
-
-namespace Core {
-
-    MaterialGroupedRenderQueue::MaterialGroupedRenderQueue(UInt32 initialCapacity): RenderQueue(initialCapacity) {
-
-    }
-
-}
\ No newline at end of file
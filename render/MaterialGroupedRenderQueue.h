@@ -1,15 +0,0 @@
-#pragma once
-
-#include "../common/types.h"
-#include "RenderQueue.h"
-
-namespace Core {
-
-    class MaterialGroupedRenderQueue : public RenderQueue{
-    public:
-
-        MaterialGroupedRenderQueue(UInt32 initialCapacity);
-        void clear();
-    };
-
-}
\ No newline at end of file
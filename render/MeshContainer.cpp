@@ -38,7 +38,8 @@ namespace Core {
     }
 
     Bool MeshContainer::hasVertexBoneMap(UInt64 meshID) {
-        return this->vertexBoneMapSet[meshID];
+        auto result = this->vertexBoneMapSet.find(meshID);
+        return result != this->vertexBoneMapSet.end() && result->second;
     }
 
 }
\ No newline at end of file
@@ -26,7 +26,7 @@
 namespace Core {
 
     MeshRenderer::MeshRenderer(WeakPointer<Material> material, WeakPointer<Object3D> owner)
-        : Object3DRenderer<Mesh>(owner), material(material) {
+        : Object3DRenderer<Mesh>(owner), material(material), lightSelectionAssignmentID(0) {
     }
 
     MeshRenderer::~MeshRenderer() {
@@ -231,13 +231,16 @@ namespace Core {
 
             Int32 directionalLightIndex = -1;
             Int32 pointLightIndex = -1;
-            Int32 ambientLightIndex = -1;
             Int32 ambientIBLLightIndex = -1;
             Int32 shadowLightIndex = -1;
 
             UInt32 currentTextureSlot = baseTextureSlot;
-            for (UInt32 i = 0; i < lightPack.lightCount(); i++) {
+            // when the renderer has picked this mesh's lights for 'lightPack', only those are visited
+            Bool useLightSelection = lightPack.getLightAssignmentID() != 0 && lightPack.getLightAssignmentID() == this->lightSelectionAssignmentID;
+            UInt32 visitedLightCount = useLightSelection ? this->selectedLights.size() : lightPack.lightCount();
+            for (UInt32 s = 0; s < visitedLightCount; s++) {
 
+                UInt32 i = useLightSelection ? this->selectedLights[s] : s;
                 WeakPointer<Light> light = lightPack.getLight(i);
                 LightType lightType = light->getType();
 
@@ -245,18 +248,17 @@ namespace Core {
 
                 switch (lightType) {
                     case LightType::Directional:
-                        directionalLightIndex++;
-                        shadowLightIndex++;
+                        directionalLightIndex = lightPack.getTypedLightIndex(i);
+                        shadowLightIndex = lightPack.getShadowLightIndex(i);
                     break;
                     case LightType::Point:
-                        pointLightIndex++;
-                        shadowLightIndex++;
+                        pointLightIndex = lightPack.getTypedLightIndex(i);
+                        shadowLightIndex = lightPack.getShadowLightIndex(i);
                     break;
                     case LightType::Ambient:
-                        ambientLightIndex++;
                     break;
                     case LightType::AmbientIBL:
-                        ambientIBLLightIndex++;
+                        ambientIBLLightIndex = lightPack.getTypedLightIndex(i);
                     break;
                 }
 
@@ -273,9 +275,15 @@ namespace Core {
                 Point3r pointLightPos;
                 if (lightType == LightType::Point) {
                     WeakPointer<PointLight> pointLight = lightPack.getPointLight(pointLightIndex);
-                    pointLightPos.set(0.0f, 0.0f, 0.0f);
-                    pointLight->getOwner()->getTransform().applyTransformationTo(pointLightPos);
-                    if (!RenderUtils::isPointLightInRangeOfMesh(pointLightPos, pointLight->getRadius(), mesh, this->owner)) continue;
+                    if (useLightSelection) {
+                        // selected lights already passed the range test, and the renderer has computed their world matrices
+                        const Real* lightWorldData = pointLight->getOwner()->getTransform().getConstWorldMatrix().getConstData();
+                        pointLightPos.set(lightWorldData[12], lightWorldData[13], lightWorldData[14]);
+                    } else {
+                        pointLightPos.set(0.0f, 0.0f, 0.0f);
+                        pointLight->getOwner()->getTransform().applyTransformationTo(pointLightPos);
+                        if (!RenderUtils::isPointLightInRangeOfMesh(pointLightPos, pointLight->getRadius(), mesh, this->owner)) continue;
+                    }
                 }
 
                 if (renderPath != RenderPath::SinglePassMultiLight) {
@@ -490,6 +498,15 @@ namespace Core {
         return this->material;
     }
 
+    void MeshRenderer::setLightSelection(UInt64 lightAssignmentID, const std::vector<UInt32>& lightIndices) {
+        this->lightSelectionAssignmentID = lightAssignmentID;
+        this->selectedLights.assign(lightIndices.begin(), lightIndices.end());
+    }
+
+    const std::vector<UInt32>& MeshRenderer::getSelectedLights() const {
+        return this->selectedLights;
+    }
+
     void MeshRenderer::checkAndSetShaderAttribute(WeakPointer<Mesh> mesh, WeakPointer<Material> material, StandardAttribute checkAttribute,
                                                   StandardAttribute setAttribute, WeakPointer<AttributeArrayBase> array, Bool force) {
         if (mesh->isAttributeEnabled(checkAttribute) || force) {
@@ -35,6 +35,8 @@ namespace Core {
         virtual void preProcess() override;
         void setMaterial(WeakPointer<Material> material);
         WeakPointer<Material> getMaterial();
+        void setLightSelection(UInt64 lightAssignmentID, const std::vector<UInt32>& lightIndices);
+        const std::vector<UInt32>& getSelectedLights() const;
 
     private:
         MeshRenderer(WeakPointer<Material> material, WeakPointer<Object3D> owner);
@@ -50,5 +52,9 @@ namespace Core {
         void testAndSetTextureCubeWithInc(WeakPointer<Shader> shader, UInt32& textureSlot, Int32 shaderVarLoc, UInt32 textureID);
 
         PersistentWeakPointer<Material> material;
+        // indices (in LightPack::getLights()) of the lights picked for this renderer by the light assignment
+        // with ID 'lightSelectionAssignmentID'
+        std::vector<UInt32> selectedLights;
+        UInt64 lightSelectionAssignmentID;
     };
 }
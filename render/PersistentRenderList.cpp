@@ -0,0 +1,119 @@
+#include "PersistentRenderList.h"
+#include "../scene/Object3D.h"
+#include "BaseObject3DRenderer.h"
+#include "BaseRenderable.h"
+#include "BaseRenderableContainer.h"
+#include "MeshContainer.h"
+#include "MeshRenderer.h"
+#include "../particles/ParticleSystem.h"
+#include "../particles/renderer/ParticleSystemRenderer.h"
+
+namespace Core {
+
+    const UInt32 PersistentRenderList::MinPurgeCount;
+
+    PersistentRenderList::PersistentRenderList(): currentFrame(1), usedEntryCount(0) {
+    }
+
+    /*
+     * Get the cached render items for [object], rebuilding them first if the object's render state has
+     * changed since they were resolved. The returned entry stays valid until the next call to endFrame().
+     */
+    PersistentRenderList::Entry& PersistentRenderList::getEntry(WeakPointer<Object3D> object) {
+        this->stats.lookups++;
+        Entry& entry = this->entries[object->getID()];
+        if (entry.lastUsedFrame != this->currentFrame) {
+            entry.lastUsedFrame = this->currentFrame;
+            this->usedEntryCount++;
+        }
+        if (entry.renderStateVersion != object->getRenderStateVersion()) {
+            this->rebuildEntry(entry, object);
+        }
+        return entry;
+    }
+
+    void PersistentRenderList::endFrame() {
+        UInt32 unusedEntryCount = (UInt32)this->entries.size() - this->usedEntryCount;
+        if (unusedEntryCount >= MinPurgeCount && unusedEntryCount >= this->usedEntryCount) {
+            this->purgeUnusedEntries();
+        }
+        this->currentFrame++;
+        this->usedEntryCount = 0;
+    }
+
+    void PersistentRenderList::clear() {
+        this->entries.clear();
+        this->usedEntryCount = 0;
+    }
+
+    UInt32 PersistentRenderList::getEntryCount() const {
+        return this->entries.size();
+    }
+
+    const PersistentRenderList::Stats& PersistentRenderList::getStats() const {
+        return this->stats;
+    }
+
+    void PersistentRenderList::resetStats() {
+        this->stats = Stats();
+    }
+
+    void PersistentRenderList::rebuildEntry(Entry& entry, WeakPointer<Object3D> object) {
+        this->stats.rebuiltEntries++;
+        entry.object = object;
+        entry.meshContainer = ObjectHandle<MeshContainer>::nullHandle();
+        entry.renderStateVersion = object->getRenderStateVersion();
+        entry.items.clear();
+
+        ObjectHandle<BaseObject3DRenderer> renderer = object->getBaseRendererHandle();
+        if (!renderer.isValid()) return;
+
+        Bool isStatic = object->isStatic();
+        Int32 layer = object->getLayer();
+        ObjectHandle<MeshRenderer> meshRenderer = object->getMeshRendererHandle();
+        ObjectHandle<MeshContainer> meshContainer = object->getMeshContainerHandle();
+        ObjectHandle<ParticleSystemRenderer> particleSystemRenderer = object->getParticleSystemRendererHandle();
+        ObjectHandle<ParticleSystem> particleSystem = object->getParticleSystemHandle();
+        ObjectHandle<BaseRenderableContainer> renderableContainer = object->getBaseRenderableContainerHandle();
+        if (meshRenderer.isValid() && meshContainer.isValid()) {
+            entry.meshContainer = meshContainer;
+            UInt32 renderableCount = meshContainer->getBaseRenderableCount();
+            for (UInt32 i = 0; i < renderableCount; i++) {
+                entry.items.emplace_back();
+                RenderItem& renderItem = entry.items.back();
+                renderItem.meshRenderer = meshRenderer;
+                renderItem.mesh = meshContainer->getRenderable(i);
+            }
+        } else if (particleSystemRenderer.isValid() && particleSystem.isValid()) {
+            entry.items.emplace_back();
+            RenderItem& renderItem = entry.items.back();
+            renderItem.particleSystemRenderer = particleSystemRenderer;
+            renderItem.particleSystem = particleSystem;
+        } else if (renderableContainer.isValid()) {
+            UInt32 renderableCount = renderableContainer->getBaseRenderableCount();
+            for (UInt32 i = 0; i < renderableCount; i++) {
+                entry.items.emplace_back();
+                RenderItem& renderItem = entry.items.back();
+                renderItem.renderer = renderer;
+                renderItem.renderable = renderableContainer->getBaseRenderable(i);
+            }
+        }
+
+        for (RenderItem& renderItem : entry.items) {
+            renderItem.isStatic = isStatic;
+            renderItem.isActive = true;
+            renderItem.layer = layer;
+        }
+    }
+
+    void PersistentRenderList::purgeUnusedEntries() {
+        for (auto itr = this->entries.begin(); itr != this->entries.end();) {
+            if (itr->second.lastUsedFrame != this->currentFrame) {
+                itr = this->entries.erase(itr);
+                this->stats.purgedEntries++;
+            } else {
+                ++itr;
+            }
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include "../common/types.h"
+#include "../util/WeakPointer.h"
+#include "../base/ObjectHandle.h"
+#include "RenderItem.h"
+
+namespace Core {
+
+    // forward declarations
+    class Object3D;
+    class MeshContainer;
+
+    /*
+     * Render items that persist across frames, cached per scene object. An object's items are resolved from its
+     * renderer and renderable container once, and only rebuilt when its render state version changes
+     * (see Object3D::invalidateRenderState()), so the per-frame cost of a scene that isn't changing is one
+     * lookup per object. Materials and render queues are read from the renderer when items are drawn and
+     * therefore don't invalidate anything.
+     *
+     * Entries for objects that are no longer rendered (removed from the scene, deactivated or destroyed)
+     * are purged in bulk by endFrame() once they make up a sizeable part of the cache.
+     */
+    class PersistentRenderList {
+    public:
+
+        class Entry {
+        public:
+            ObjectHandle<Object3D> object;
+            ObjectHandle<MeshContainer> meshContainer;
+            std::vector<RenderItem> items;
+            UInt64 renderStateVersion = 0;
+            UInt64 lastUsedFrame = 0;
+        };
+
+        class Stats {
+        public:
+            UInt32 lookups = 0;
+            UInt32 rebuiltEntries = 0;
+            UInt32 purgedEntries = 0;
+        };
+
+        PersistentRenderList();
+
+        Entry& getEntry(WeakPointer<Object3D> object);
+        void endFrame();
+        void clear();
+        UInt32 getEntryCount() const;
+        const Stats& getStats() const;
+        void resetStats();
+
+    private:
+        void rebuildEntry(Entry& entry, WeakPointer<Object3D> object);
+        void purgeUnusedEntries();
+
+        // minimum number of unused entries before endFrame() bothers to purge them
+        static const UInt32 MinPurgeCount = 64;
+
+        std::unordered_map<UInt64, Entry> entries;
+        UInt64 currentFrame;
+        UInt32 usedEntryCount;
+        Stats stats;
+    };
+}
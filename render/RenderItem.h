@@ -3,8 +3,7 @@
 #include <vector>
 
 #include "../common/types.h"
-#include "../util/WeakPointer.h"
-#include "../util/PersistentWeakPointer.h"
+#include "../base/ObjectHandle.h"
 
 namespace Core {
 
@@ -19,22 +18,17 @@ namespace Core {
     class RenderItem {
     public:
         RenderItem(){
-            this->renderer = WeakPointer<BaseObject3DRenderer>::nullPtr();
-            this->renderable = WeakPointer<BaseRenderable>::nullPtr();
-            this->meshRenderer = WeakPointer<MeshRenderer>::nullPtr();
-            this->mesh = WeakPointer<Mesh>::nullPtr();
-            this->particleSystemRenderer = WeakPointer<ParticleSystemRenderer>::nullPtr();
-            this->particleSystem = WeakPointer<ParticleSystem>::nullPtr();
             this->isStatic = false;
             this->isActive = false;
+            this->layer = 0;
         }
-      
-        PersistentWeakPointer<BaseObject3DRenderer> renderer;
-        PersistentWeakPointer<BaseRenderable> renderable;
-        PersistentWeakPointer<MeshRenderer> meshRenderer;
-        PersistentWeakPointer<Mesh> mesh;
-        PersistentWeakPointer<ParticleSystemRenderer> particleSystemRenderer;
-        PersistentWeakPointer<ParticleSystem> particleSystem;
+
+        ObjectHandle<BaseObject3DRenderer> renderer;
+        ObjectHandle<BaseRenderable> renderable;
+        ObjectHandle<MeshRenderer> meshRenderer;
+        ObjectHandle<Mesh> mesh;
+        ObjectHandle<ParticleSystemRenderer> particleSystemRenderer;
+        ObjectHandle<ParticleSystem> particleSystem;
         Bool isStatic;
         Bool isActive;
         Int32 layer;
@@ -1,5 +1,11 @@
 #include "RenderList.h"
 #include "../common/Exception.h"
+#include "BaseObject3DRenderer.h"
+#include "BaseRenderable.h"
+#include "MeshRenderer.h"
+#include "../geometry/Mesh.h"
+#include "../particles/ParticleSystem.h"
+#include "../particles/renderer/ParticleSystemRenderer.h"
 
 namespace Core {
 
@@ -39,6 +45,12 @@ namespace Core {
         this->renderItems.push_back(&renderItem);
     }
 
+    void RenderList::addRenderItem(const RenderItem& source) {
+        RenderItem& renderItem = this->renderItemPool.acquireObject();
+        renderItem = source;
+        this->renderItems.push_back(&renderItem);
+    }
+
     RenderItem& RenderList::getRenderItem(UInt32 index) {
         if (index >= this->getItemCount()) {
             throw OutOfRangeException("RenderList::getRenderItem -> Index is out of bounds.");
@@ -54,12 +66,12 @@ namespace Core {
     }
 
     void RenderList::initRenderItem(RenderItem& renderItem, Bool isStatic, Bool isActive, Int32 layer) {
-        renderItem.meshRenderer = WeakPointer<MeshRenderer>::nullPtr();
-        renderItem.renderer = WeakPointer<BaseObject3DRenderer>::nullPtr();
-        renderItem.particleSystem = WeakPointer<ParticleSystem>::nullPtr();
-        renderItem.mesh = WeakPointer<Mesh>::nullPtr();
-        renderItem.renderable = WeakPointer<BaseRenderable>::nullPtr();
-        renderItem.particleSystemRenderer = WeakPointer<ParticleSystemRenderer>::nullPtr();
+        renderItem.meshRenderer = ObjectHandle<MeshRenderer>::nullHandle();
+        renderItem.renderer = ObjectHandle<BaseObject3DRenderer>::nullHandle();
+        renderItem.particleSystem = ObjectHandle<ParticleSystem>::nullHandle();
+        renderItem.mesh = ObjectHandle<Mesh>::nullHandle();
+        renderItem.renderable = ObjectHandle<BaseRenderable>::nullHandle();
+        renderItem.particleSystemRenderer = ObjectHandle<ParticleSystemRenderer>::nullHandle();
         renderItem.isStatic = isStatic;
         renderItem.isActive = isActive;
         renderItem.layer = layer;
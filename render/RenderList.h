@@ -30,6 +30,7 @@ namespace Core {
         void addItem(WeakPointer<BaseObject3DRenderer> renderer, WeakPointer<BaseRenderable> renderable, Bool isStatic, Bool isActive, Int32 layer);
         void addMesh(WeakPointer<MeshRenderer> meshRenderer, WeakPointer<Mesh> mesh, Bool isStatic, Bool isActive, Int32 layer);
         void addParticleSystem(WeakPointer<ParticleSystemRenderer> particleSystemRenderer, WeakPointer<ParticleSystem> particleSystem, Bool isStatic, Bool isActive, Int32 layer);
+        void addRenderItem(const RenderItem& source);
         RenderItem& getRenderItem(UInt32 index);
         void setAllActive();
 
@@ -2,30 +2,49 @@
 #include "../light/PointLight.h"
 #include "../geometry/Mesh.h"
 #include "../math/Quaternion.h"
+#include "../geometry/Frustum.h"
 
 namespace Core {
 
     Bool RenderUtils::isPointLightInRangeOfMesh(WeakPointer<PointLight> pointLight, WeakPointer<Mesh> mesh, WeakPointer<Object3D> meshOwner) {
-        static Point3r pointLightPos;
-        pointLightPos.set(0.0f, 0.0f, 0.0f);
+        Point3r pointLightPos(0.0f, 0.0f, 0.0f);
         pointLight->getOwner()->getTransform().applyTransformationTo(pointLightPos);
         return RenderUtils::isPointLightInRangeOfMesh(pointLightPos, pointLight->getRadius(), mesh, meshOwner);
     }
 
-    Bool RenderUtils::isPointLightInRangeOfMesh(const Point3r& pointLightPosition, Real radius, WeakPointer<Mesh> mesh, WeakPointer<Object3D> meshOwner) {
+    Bool RenderUtils::isPointLightInRangeOfMesh(const Point3r& pointLightPosition, Real radius, ObjectHandle<Mesh> mesh, ObjectHandle<Object3D> meshOwner) {
         Vector4r boundingSphere = mesh->getBoundingSphere();
         Point3r boundingSphereCenter(boundingSphere.x, boundingSphere.y, boundingSphere.z);
         meshOwner->getTransform().applyTransformationTo(boundingSphereCenter);
         Vector3r centerToLight = pointLightPosition - boundingSphereCenter;
         Real distance = centerToLight.magnitude();
 
-        static Point3r pos;
-        static Quaternion rot;
-        static Point3r scale;
+        Point3r pos;
+        Quaternion rot;
+        Point3r scale;
         Matrix4x4 meshWorldMatrix = meshOwner->getTransform().getWorldMatrix();
         meshWorldMatrix.decompose(pos, rot, scale);
         Real maxScale = Math::max(Math::max(scale.x, scale.y), scale.z);
 
         return distance <= boundingSphere.w * maxScale + radius;
     }
+
+    Bool RenderUtils::isMeshInFrustum(const Frustum& frustum, ObjectHandle<Mesh> mesh, ObjectHandle<Object3D> meshOwner) {
+        Box3 worldBounds;
+        mesh->getBoundingBox().transform(meshOwner->getTransform().getWorldMatrix(), worldBounds);
+        return frustum.intersectsBox(worldBounds);
+    }
+
+    /*
+     * The mesh's bounds go straight from model space to light space, which gives a tighter box than
+     * transforming the world space bounds a second time.
+     */
+    Bool RenderUtils::isMeshInLightSpaceVolume(const Box3& lightSpaceVolume, const Matrix4x4& lightTransformInverse,
+                                               ObjectHandle<Mesh> mesh, ObjectHandle<Object3D> meshOwner) {
+        Matrix4x4 meshToLight;
+        Matrix4x4::multiply(lightTransformInverse, meshOwner->getTransform().getWorldMatrix(), meshToLight);
+        Box3 lightSpaceBounds;
+        mesh->getBoundingBox().transform(meshToLight, lightSpaceBounds);
+        return lightSpaceVolume.intersectsBox(lightSpaceBounds);
+    }
 }
@@ -3,6 +3,7 @@
 #include "../util/PersistentWeakPointer.h"
 #include "../common/types.h"
 #include "../base/CoreObject.h"
+#include "../base/ObjectHandle.h"
 #include "../geometry/Vector3.h"
 
 namespace Core {
@@ -11,12 +12,18 @@ namespace Core {
     class PointLight;
     class Object3D;
     class Mesh;
+    class Frustum;
+    class Box3;
+    class Matrix4x4;
 
     class RenderUtils {
     public:
 
         static Bool isPointLightInRangeOfMesh(WeakPointer<PointLight>, WeakPointer<Mesh> mesh, WeakPointer<Object3D> meshOwner);
-        static Bool isPointLightInRangeOfMesh(const Point3r& pointLightPosition, Real radius, WeakPointer<Mesh> mesh, WeakPointer<Object3D> meshOwner);
+        static Bool isPointLightInRangeOfMesh(const Point3r& pointLightPosition, Real radius, ObjectHandle<Mesh> mesh, ObjectHandle<Object3D> meshOwner);
+        static Bool isMeshInFrustum(const Frustum& frustum, ObjectHandle<Mesh> mesh, ObjectHandle<Object3D> meshOwner);
+        static Bool isMeshInLightSpaceVolume(const Box3& lightSpaceVolume, const Matrix4x4& lightTransformInverse,
+                                             ObjectHandle<Mesh> mesh, ObjectHandle<Object3D> meshOwner);
 
     };
 
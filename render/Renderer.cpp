@@ -3,6 +3,8 @@
 #include <iostream>
 #include <random>
 #include <ctime>
+#include <cstring>
+#include <limits>
 
 #include "../Engine.h"
 #include "../common/Constants.h"
@@ -13,6 +15,7 @@
 #include "RenderTargetCube.h"
 #include "RenderTarget2D.h"
 #include "../math/Matrix4x4.h"
+#include "../util/WorkerPool.h"
 #include "../render/BaseRenderableContainer.h"
 #include "../render/MeshRenderer.h"
 #include "../render/RenderableContainer.h"
@@ -42,6 +45,8 @@
 #include "../light/AmbientIBLLight.h"
 #include "../light/LightPack.h"
 #include "../geometry/Mesh.h"
+#include "../geometry/Frustum.h"
+#include "../geometry/Box3.h"
 #include "../util/Time.h"
 #include "../util/Profiler.h"
 #include "ReflectionProbe.h"
@@ -50,8 +55,22 @@
 
 namespace Core {
 
-    Renderer::Renderer() {
-        
+    const UInt32 Renderer::TraversalJobsPerThread;
+    const UInt32 Renderer::DrawRecordingBatchSize;
+    const UInt32 Renderer::DefaultMaxLightsPerObject;
+    const UInt32 Renderer::DefaultSceneOctreeExtent;
+    const UInt32 Renderer::MaxRenderedViewCount;
+
+    Renderer::Renderer(): lightAssignmentID(0), maxLightsPerObject(DefaultMaxLightsPerObject), clusteredLightingEnabled(false),
+                          sceneOctree(Box3(-(Real)DefaultSceneOctreeExtent, -(Real)DefaultSceneOctreeExtent, -(Real)DefaultSceneOctreeExtent,
+                                           (Real)DefaultSceneOctreeExtent, (Real)DefaultSceneOctreeExtent, (Real)DefaultSceneOctreeExtent)),
+                          sceneOctreeObjects(nullptr) {
+        this->cubeFaceOrientations[(UInt16)CubeFace::Forward].lookAt(Vector3r::Zero, Vector3r::Backward, Vector3r::Down);
+        this->cubeFaceOrientations[(UInt16)CubeFace::Backward].lookAt(Vector3r::Zero, Vector3r::Forward, Vector3r::Down);
+        this->cubeFaceOrientations[(UInt16)CubeFace::Up].lookAt(Vector3r::Zero, Vector3r::Up, Vector3r::Backward);
+        this->cubeFaceOrientations[(UInt16)CubeFace::Down].lookAt(Vector3r::Zero, Vector3r::Down, Vector3r::Forward);
+        this->cubeFaceOrientations[(UInt16)CubeFace::Left].lookAt(Vector3r::Zero, Vector3r::Left, Vector3r::Down);
+        this->cubeFaceOrientations[(UInt16)CubeFace::Right].lookAt(Vector3r::Zero, Vector3r::Right, Vector3r::Down);
     }
 
     Renderer::~Renderer() {
@@ -132,38 +151,35 @@ namespace Core {
 
     UInt32 profileType = 0;
     void Renderer::renderScene(WeakPointer<Object3D> rootObject, WeakPointer<Material> overrideMaterial) {
-        static std::vector<WeakPointer<Object3D>> objectList;
-        static std::vector<WeakPointer<Camera>> cameraList;
-        static std::vector<WeakPointer<Light>> lightList;
-        static std::vector<WeakPointer<Light>> nonIBLLightList;
-        static std::vector<WeakPointer<DirectionalLight>> directionalLightList;
-        static std::vector<WeakPointer<PointLight>> pointLightList;
-        static std::vector<WeakPointer<AmbientLight>> ambientLightList;
-        static std::vector<WeakPointer<AmbientIBLLight>> ambientIBLLightList;
-        static LightPack lightPack;
-        static LightPack nonIBLLightPack;
-        static std::vector<WeakPointer<ReflectionProbe>> reflectionProbeList;
-        static std::vector<WeakPointer<Object3D>> renderProbeObjects;
-        objectList.resize(0);
-        cameraList.resize(0);
-        lightList.resize(0);
-        nonIBLLightList.resize(0);
-        directionalLightList.resize(0);
-        pointLightList.resize(0);
-        ambientIBLLightList.resize(0);
-        ambientLightList.resize(0);
+        FrameArena::Scope frameScope(this->frameArena);
+        FrameVector<WeakPointer<Object3D>> objectList(this->frameArena);
+        FrameVector<WeakPointer<Camera>> cameraList(this->frameArena);
+        FrameVector<WeakPointer<DirectionalLight>> directionalLightList(this->frameArena);
+        FrameVector<WeakPointer<PointLight>> pointLightList(this->frameArena);
+        FrameVector<WeakPointer<AmbientLight>> ambientLightList(this->frameArena);
+        FrameVector<WeakPointer<AmbientIBLLight>> ambientIBLLightList(this->frameArena);
+        FrameVector<WeakPointer<ReflectionProbe>> reflectionProbeList(this->frameArena);
+        FrameVector<WeakPointer<Object3D>> renderProbeObjects(this->frameArena);
+        LightPack& lightPack = this->sceneLightPack;
+        LightPack& nonIBLLightPack = this->sceneNonIBLLightPack;
         lightPack.clear();
         nonIBLLightPack.clear();
-        reflectionProbeList.resize(0);
-        renderProbeObjects.resize(0);
-
-        
+        this->resetFrustumCullingStats();
+        this->resetShadowCasterCullingStats();
+        this->resetShadowCacheStats();
+        this->resetLightAssignmentStats();
+        this->resetTransformUpdateStats();
+        this->resetStateChangeStats();
+        this->persistentRenderList.endFrame();
+        this->persistentRenderList.resetStats();
+        this->renderedViews.clear();
 
         WeakPointer<Graphics> graphics = Engine::instance()->getGraphicsSystem();
         this->collectSceneObjectsAndComputeTransforms(rootObject, objectList);
 
-        this->collectSceneObjectComponents(objectList, cameraList, reflectionProbeList, nonIBLLightList,
-                                           directionalLightList, pointLightList, ambientLightList, ambientIBLLightList, lightList);
+        this->collectSceneObjectComponents(objectList, cameraList, reflectionProbeList,
+                                           directionalLightList, pointLightList, ambientLightList, ambientIBLLightList);
+        this->updateSceneOctree(objectList);
 
         for (UInt32 i = 0; i < directionalLightList.size(); i++) {
             lightPack.addDirectionalLight(directionalLightList[i]);
@@ -178,6 +194,7 @@ namespace Core {
             nonIBLLightPack.addAmbientLight(ambientLightList[i]);
         }
         for (UInt32 i = 0; i < ambientIBLLightList.size(); i++) lightPack.addAmbientIBLLight(ambientIBLLightList[i]);
+        this->assignLightsToObjects(objectList, lightPack);
 
         // TODO: Decide how to classify objects as either contributors to ambient light or not
         /*for (UInt32 i = 0; i < objectList.size(); i++) {
@@ -192,12 +209,12 @@ namespace Core {
 
         if (profileType == 1) Profiler::SingleFunction::quickSinglePassStart(40.0f);
 
-        this->renderPointLightShadowMaps(pointLightList, objectList);
+        this->renderPointLightShadowMaps(lightPack.getPointLights(), objectList);
 
         if (profileType == 1) Profiler::SingleFunction::quickSinglePassSection("Point light shadows: ");
 
         for (auto camera : cameraList) {
-            this->renderDirectionalLightShadowMaps(directionalLightList, objectList, camera);
+            this->renderDirectionalLightShadowMaps(lightPack.getDirectionalLights(), objectList, camera);
         }
 
         if (profileType == 1) Profiler::SingleFunction::quickSinglePassSection("Directional light shadows: ");
@@ -211,55 +228,51 @@ namespace Core {
 
         if (profileType == 1) Profiler::SingleFunction::quickSinglePassSection("Rendering scene: ");
         if (profileType == 1) Profiler::SingleFunction::quickSinglePassEnd(true);
+        this->sceneOctreeObjects = nullptr;
     }
 
-    void Renderer::collectSceneObjectComponents(std::vector<WeakPointer<Object3D>>& sceneObjects, std::vector<WeakPointer<Camera>>& cameraList,
-                                                std::vector<WeakPointer<ReflectionProbe>>& reflectionProbeList, std::vector<WeakPointer<Light>>& nonIBLLightList,
-                                                std::vector<WeakPointer<DirectionalLight>>& directionalLightList, std::vector<WeakPointer<PointLight>>& pointLightList,
-                                                std::vector<WeakPointer<AmbientLight>>& ambientLightList, std::vector<WeakPointer<AmbientIBLLight>>& ambientIBLLightList,
-                                                std::vector<WeakPointer<Light>>& lightList) {
+    void Renderer::collectSceneObjectComponents(FrameVector<WeakPointer<Object3D>>& sceneObjects, FrameVector<WeakPointer<Camera>>& cameraList,
+                                                FrameVector<WeakPointer<ReflectionProbe>>& reflectionProbeList,
+                                                FrameVector<WeakPointer<DirectionalLight>>& directionalLightList, FrameVector<WeakPointer<PointLight>>& pointLightList,
+                                                FrameVector<WeakPointer<AmbientLight>>& ambientLightList, FrameVector<WeakPointer<AmbientIBLLight>>& ambientIBLLightList) {
         for (WeakPointer<Object3D> object : sceneObjects) {
-            WeakPointer<Camera> camera = object->getCamera();
+            ObjectHandle<Camera> camera = object->getCameraHandle();
             if (camera.isValid() && camera->isActive()) {
-                cameraList.push_back(camera);
+                cameraList.push_back(camera.toWeakPointer());
             }
-            WeakPointer<ReflectionProbe> reflectionProbe = object->getReflectionProbe();
+            ObjectHandle<ReflectionProbe> reflectionProbe = object->getReflectionProbeHandle();
             if (reflectionProbe.isValid() && reflectionProbe->isActive()) {
-                reflectionProbeList.push_back(reflectionProbe);
+                reflectionProbeList.push_back(reflectionProbe.toWeakPointer());
             }
-            WeakPointer<Light> light = object->getLight();
+            ObjectHandle<Light> light = object->getLightHandle();
             if (light.isValid() && light->isActive()) {
                 LightType lightType = light->getType();
-                if (lightType != LightType::AmbientIBL) {
-                    nonIBLLightList.push_back(light);
-                    if (lightType == LightType::Directional) directionalLightList.push_back(object->getDirectionalLight());
-                    else if (lightType == LightType::Point) pointLightList.push_back(object->getPointLight());
-                    else if (lightType == LightType::Ambient) ambientLightList.push_back(object->getAmbientLight());
-                } else {
-                    ambientIBLLightList.push_back(object->getAmbientIBLLight());
-                }
-                lightList.push_back(light);
+                if (lightType == LightType::Directional) directionalLightList.push_back(object->getDirectionalLight());
+                else if (lightType == LightType::Point) pointLightList.push_back(object->getPointLight());
+                else if (lightType == LightType::Ambient) ambientLightList.push_back(object->getAmbientLight());
+                else if (lightType == LightType::AmbientIBL) ambientIBLLightList.push_back(object->getAmbientIBLLight());
             }
         }
     }
 
     void Renderer::renderSceneBasic(WeakPointer<Object3D> rootObject, WeakPointer<Camera> camera, Bool matchPhysicalPropertiesWithLighting) {
-        static std::vector<WeakPointer<Object3D>> objectList;
-        objectList.resize(0);
+        FrameArena::Scope frameScope(this->frameArena);
+        FrameVector<WeakPointer<Object3D>> objectList(this->frameArena);
 
         Matrix4x4 baseTransformation;
         rootObject->getTransform().getAncestorWorldMatrix(baseTransformation);
+        this->sceneOctreeObjects = nullptr;
 
         this->collectSceneObjectsAndComputeTransforms(rootObject, objectList, baseTransformation);
         this->renderForCamera(camera, objectList, matchPhysicalPropertiesWithLighting);
     }
 
-    void Renderer::renderForCamera(WeakPointer<Camera> camera, std::vector<WeakPointer<Object3D>>& objects, Bool matchPhysicalPropertiesWithLighting) {
-        static LightPack lightPack;
+    void Renderer::renderForCamera(WeakPointer<Camera> camera, FrameVector<WeakPointer<Object3D>>& objects, Bool matchPhysicalPropertiesWithLighting) {
+        LightPack lightPack;
         this->renderForCamera(camera, objects, lightPack, matchPhysicalPropertiesWithLighting);
     }
 
-    void Renderer::renderForCamera(WeakPointer<Camera> camera, std::vector<WeakPointer<Object3D>>& objects, const LightPack& lightPack,
+    void Renderer::renderForCamera(WeakPointer<Camera> camera, FrameVector<WeakPointer<Object3D>>& objects, const LightPack& lightPack,
                                    Bool matchPhysicalPropertiesWithLighting) {
         WeakPointer<Graphics> graphics = Engine::instance()->getGraphicsSystem();
         WeakPointer<RenderTarget> nextRenderTarget = camera->getRenderTarget();
@@ -290,16 +303,30 @@ namespace Core {
         }
     }
 
-    void Renderer::renderForStandardCamera(WeakPointer<Camera> camera, std::vector<WeakPointer<Object3D>>& objects, const LightPack& lightPack,
+    void Renderer::renderForStandardCamera(WeakPointer<Camera> camera, FrameVector<WeakPointer<Object3D>>& objects, const LightPack& lightPack,
                                            Bool matchPhysicalPropertiesWithLighting, WeakPointer<Texture2D> ssaoMap) {
         ViewDescriptor viewDescriptor;
         this->getViewDescriptorForCamera(camera, viewDescriptor);
         viewDescriptor.ssaoMap = ssaoMap;
         viewDescriptor.ssaoEnabled = ssaoMap.isValid();
+
+        if (this->renderedViews.size() < MaxRenderedViewCount) {
+            const Real* cameraMatrix = viewDescriptor.cameraTransformation.getConstData();
+            this->renderedViews.emplace_back();
+            this->renderedViews.back().frustum = viewDescriptor.frustum;
+            this->renderedViews.back().position.set(cameraMatrix[12], cameraMatrix[13], cameraMatrix[14]);
+        }
+
+        if (this->clusteredLightingEnabled && camera->isClusteredLightingEnabled()) {
+            WeakPointer<WorkerPool> workerPool = Engine::instance()->getWorkerPool();
+            camera->getLightClusterGrid().build(viewDescriptor.projectionMatrix, viewDescriptor.inverseCameraTransformation,
+                                                camera->getNear(), camera->getFar(), lightPack, workerPool.get());
+        }
+
         this->renderForViewDescriptor(viewDescriptor, objects, lightPack, matchPhysicalPropertiesWithLighting);
     }
 
-    void Renderer::renderForCubeCamera(WeakPointer<Camera> camera, std::vector<WeakPointer<Object3D>>& objects,
+    void Renderer::renderForCubeCamera(WeakPointer<Camera> camera, FrameVector<WeakPointer<Object3D>>& objects,
                                        const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting) {
         ViewDescriptor viewDesc;
         for (UInt32 i = 0; i < 6; i++) {
@@ -308,38 +335,180 @@ namespace Core {
         }
     }
 
-    void Renderer::renderForViewDescriptor(ViewDescriptor& viewDescriptor, std::vector<WeakPointer<Object3D>>& objectList, 
-                                           const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting) {
-        static RenderQueueManager renderQueueManager;
-        renderQueueManager.clearAll();
-
-        Int32 overrideRenderQueueID = viewDescriptor.overrideMaterial.isValid() ? viewDescriptor.overrideMaterial->getRenderQueueID() : -1;
-        this->sortObjectsIntoRenderQueues(objectList, renderQueueManager, overrideRenderQueueID);
-        this->renderForViewDescriptor(viewDescriptor, renderQueueManager, lightPack, matchPhysicalPropertiesWithLighting);
-    }
-
-    void Renderer::renderForViewDescriptor(ViewDescriptor& viewDescriptor, RenderQueueManager& renderQueueManager, 
+    void Renderer::renderForViewDescriptor(ViewDescriptor& viewDescriptor, FrameVector<WeakPointer<Object3D>>& objectList, 
                                            const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting) {
         WeakPointer<RenderTarget> currentRenderTarget = this->preRenderForViewDescriptor(viewDescriptor);
 
-        UInt32 renderQueueCount = renderQueueManager.getRenderQueueCount();
-        for (UInt32 q = 0; q < renderQueueCount; q++) {
-            this->renderRenderList(viewDescriptor, renderQueueManager.getRenderQueue(q), lightPack, matchPhysicalPropertiesWithLighting);
+        this->drawCommandBuffer.clear();
+        if (viewDescriptor.frustumCullingEnabled && this->isSceneOctreeObjectList(objectList)) {
+            FrameArena::Scope frameScope(this->frameArena);
+            FrameVector<WeakPointer<Object3D>> visibleObjects(this->frameArena);
+            this->sceneOctree.queryFrustum(viewDescriptor.frustum, visibleObjects);
+            this->frustumCullingStats.culledObjects += this->sceneOctree.getObjectCount() - (UInt32)visibleObjects.size();
+            this->recordDrawCommands(viewDescriptor, visibleObjects);
+        } else {
+            this->recordDrawCommands(viewDescriptor, objectList);
         }
+        this->sortDrawCommands();
+        this->executeDrawCommands(viewDescriptor, lightPack, matchPhysicalPropertiesWithLighting);
+
         this->postRenderForViewDescriptor(viewDescriptor, currentRenderTarget);
     }
 
+    /*
+     * Items in a plain RenderList do not come pre-sorted into queues, so each one is keyed by the render queue
+     * of its own renderer.
+     */
     void Renderer::renderForViewDescriptor(ViewDescriptor& viewDescriptor, RenderList& renderList, 
                                            const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting) {
         WeakPointer<RenderTarget> currentRenderTarget = this->preRenderForViewDescriptor(viewDescriptor);
-        this->renderRenderList(viewDescriptor, renderList, lightPack, matchPhysicalPropertiesWithLighting);
+
+        this->drawCommandBuffer.clear();
+        this->recordDrawCommands(viewDescriptor, renderList, -1);
+        this->sortDrawCommands();
+        this->executeDrawCommands(viewDescriptor, lightPack, matchPhysicalPropertiesWithLighting);
+
         this->postRenderForViewDescriptor(viewDescriptor, currentRenderTarget);
     }
 
-    void Renderer::renderRenderList(ViewDescriptor& viewDescriptor, RenderList& renderList, 
-                                    const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting) {
+    /*
+     * Record a draw packet for every render item of [objects] that survives frustum culling. The items come from
+     * the persistent render list, so nothing is resolved or allocated per object unless its render state changed.
+     * Queues are taken from each item's renderer (or the view's override material).
+     *
+     * Culling and key computation run on the worker pool in batches of DrawRecordingBatchSize objects. Each batch
+     * collects its packets separately and the batches are merged in object order, so the result is identical to
+     * recording on a single thread.
+     */
+    void Renderer::recordDrawCommands(ViewDescriptor& viewDescriptor, FrameVector<WeakPointer<Object3D>>& objects) {
+        // looking up (and possibly rebuilding) cache entries modifies the cache, so it stays on this thread
+        UInt32 objectCount = (UInt32)objects.size();
+        this->recordingEntries.resize(objectCount);
+        for (UInt32 i = 0; i < objectCount; i++) {
+            this->recordingEntries[i] = &this->persistentRenderList.getEntry(objects[i]);
+        }
+
+        UInt32 batchCount = (objectCount + DrawRecordingBatchSize - 1) / DrawRecordingBatchSize;
+        if (this->drawRecordingBatches.size() < batchCount) this->drawRecordingBatches.resize(batchCount);
+        const Frustum* cullingFrustum = viewDescriptor.frustumCullingEnabled ? &viewDescriptor.frustum : nullptr;
+        WeakPointer<WorkerPool> workerPool = Engine::instance()->getWorkerPool();
+        workerPool->execute(batchCount, [this, &viewDescriptor, &objects, objectCount, cullingFrustum](UInt32 batchIndex) {
+            DrawRecordingBatch& batch = this->drawRecordingBatches[batchIndex];
+            batch.candidates.clear();
+            batch.frustumCullingStats = FrustumCullingStats();
+            UInt32 end = Math::min((batchIndex + 1) * DrawRecordingBatchSize, objectCount);
+            for (UInt32 i = batchIndex * DrawRecordingBatchSize; i < end; i++) {
+                PersistentRenderList::Entry& entry = *this->recordingEntries[i];
+                for (RenderItem& renderItem : entry.items) {
+                    if (cullingFrustum != nullptr && renderItem.mesh.isValid() &&
+                        isMeshFrustumCulled(*cullingFrustum, entry.object, entry.meshContainer, renderItem.mesh, batch.frustumCullingStats)) continue;
+                    batch.candidates.emplace_back();
+                    this->describeDrawCommand(viewDescriptor, renderItem, -1, batch.candidates.back());
+                }
+            }
+        });
+
+        for (UInt32 b = 0; b < batchCount; b++) {
+            DrawRecordingBatch& batch = this->drawRecordingBatches[b];
+            this->frustumCullingStats.testedItems += batch.frustumCullingStats.testedItems;
+            this->frustumCullingStats.culledItems += batch.frustumCullingStats.culledItems;
+            for (const DrawCandidate& candidate : batch.candidates) this->addDrawCommand(candidate);
+        }
+    }
+
+    /*
+     * Record a draw packet for every active item in [renderList]. A negative [queueID] means the queue is taken
+     * from the item's renderer (or the view's override material).
+     */
+    void Renderer::recordDrawCommands(ViewDescriptor& viewDescriptor, RenderList& renderList, Int32 queueID) {
         for (UInt32 i = 0; i < renderList.getItemCount(); i++) {
             RenderItem& renderItem = renderList.getRenderItem(i);
+            if (!renderItem.isActive) continue;
+            this->recordDrawCommand(viewDescriptor, renderItem, queueID);
+        }
+    }
+
+    void Renderer::recordDrawCommand(ViewDescriptor& viewDescriptor, RenderItem& renderItem, Int32 queueID) {
+        DrawCandidate candidate;
+        this->describeDrawCommand(viewDescriptor, renderItem, queueID, candidate);
+        this->addDrawCommand(candidate);
+    }
+
+    /*
+     * Work out the render queue, material, mesh and camera distance of a draw packet for [renderItem]. This only reads
+     * shared state, so it may run on several worker threads at once.
+     */
+    void Renderer::describeDrawCommand(ViewDescriptor& viewDescriptor, RenderItem& renderItem, Int32 queueID, DrawCandidate& candidate) {
+        BaseObject3DRenderer* renderer;
+        WeakPointer<Material> material;
+        UInt64 meshID = 0;
+        if (renderItem.meshRenderer.isValid()) {
+            renderer = renderItem.meshRenderer.get();
+            material = renderItem.meshRenderer->getMaterial();
+            meshID = renderItem.mesh->getObjectID();
+
+            // mirror the material selection in MeshRenderer::forwardRenderMesh()
+            Bool renderingDepthOutput = material->hasCustomDepthOutput() && viewDescriptor.depthOutputOverride != DepthOutputOverride::None;
+            if (!renderingDepthOutput && viewDescriptor.overrideMaterial.isValid()) material = viewDescriptor.overrideMaterial;
+        } else if (renderItem.particleSystemRenderer.isValid()) {
+            renderer = renderItem.particleSystemRenderer.get();
+        } else {
+            renderer = renderItem.renderer.get();
+        }
+
+        if (queueID < 0) {
+            // dereference a copy; the view's own pointer caches its target on first use, which is not thread-safe
+            WeakPointer<Material> overrideMaterial = viewDescriptor.overrideMaterial;
+            queueID = overrideMaterial.isValid() ? overrideMaterial->getRenderQueueID() : renderer->getRenderQueueID();
+        }
+
+        const Matrix4x4& worldMatrix = renderer->getOwner()->getTransform().getConstWorldMatrix();
+        const Real* worldData = worldMatrix.getConstData();
+        Real dx = worldData[12] - viewDescriptor.cameraPosition.x;
+        Real dy = worldData[13] - viewDescriptor.cameraPosition.y;
+        Real dz = worldData[14] - viewDescriptor.cameraPosition.z;
+
+        candidate.renderItem = &renderItem;
+        candidate.queueID = queueID;
+        candidate.depth = dx * dx + dy * dy + dz * dz;
+        candidate.shaderID = material.isValid() && material->getShader().isValid() ? material->getShader()->getObjectID() : 0;
+        candidate.materialID = material.isValid() ? material->getObjectID() : 0;
+        candidate.meshID = meshID;
+    }
+
+    void Renderer::addDrawCommand(const DrawCandidate& candidate) {
+        if (candidate.queueID >= (Int32)EngineRenderQueue::Transparent) {
+            this->drawCommandBuffer.addTransparentCommand(candidate.renderItem, candidate.queueID, candidate.depth,
+                                                          candidate.shaderID, candidate.materialID, candidate.meshID);
+        } else {
+            this->drawCommandBuffer.addOpaqueCommand(candidate.renderItem, candidate.queueID, candidate.shaderID,
+                                                     candidate.materialID, candidate.meshID, candidate.depth);
+        }
+    }
+
+    /*
+     * Sort the recorded draw commands and note how many shader, material and mesh switches the sort saved
+     * compared to drawing in collection order.
+     */
+    void Renderer::sortDrawCommands() {
+        DrawCommandBuffer::StateChanges unsortedChanges;
+        this->drawCommandBuffer.countStateChanges(unsortedChanges);
+        this->drawCommandBuffer.sort();
+        DrawCommandBuffer::StateChanges sortedChanges;
+        this->drawCommandBuffer.countStateChanges(sortedChanges);
+
+        this->stateChangeStats.drawCommands += this->drawCommandBuffer.getCommandCount();
+        this->stateChangeStats.shaderChanges += sortedChanges.shaderChanges;
+        this->stateChangeStats.materialChanges += sortedChanges.materialChanges;
+        this->stateChangeStats.meshChanges += sortedChanges.meshChanges;
+        this->stateChangeStats.shaderChangesAvoided += (Int32)unsortedChanges.shaderChanges - (Int32)sortedChanges.shaderChanges;
+        this->stateChangeStats.materialChangesAvoided += (Int32)unsortedChanges.materialChanges - (Int32)sortedChanges.materialChanges;
+        this->stateChangeStats.meshChangesAvoided += (Int32)unsortedChanges.meshChanges - (Int32)sortedChanges.meshChanges;
+    }
+
+    void Renderer::executeDrawCommands(ViewDescriptor& viewDescriptor, const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting) {
+        for (UInt32 i = 0; i < this->drawCommandBuffer.getCommandCount(); i++) {
+            RenderItem& renderItem = *this->drawCommandBuffer.getCommand(i).renderItem;
             this->renderRenderItem(viewDescriptor, renderItem, lightPack, matchPhysicalPropertiesWithLighting);
         }
     }
@@ -348,13 +517,13 @@ namespace Core {
                                     const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting) {
         if (renderItem.isActive) {
             if (renderItem.meshRenderer.isValid()) {
-                renderItem.meshRenderer->forwardRenderMesh(viewDescriptor, renderItem.mesh, renderItem.isStatic,
+                renderItem.meshRenderer->forwardRenderMesh(viewDescriptor, renderItem.mesh.toWeakPointer(), renderItem.isStatic,
                                                            renderItem.layer, lightPack, matchPhysicalPropertiesWithLighting);
             } else if(renderItem.particleSystemRenderer.isValid()) {
-                renderItem.particleSystemRenderer->forwardRenderParticleSystem(viewDescriptor, renderItem.particleSystem, renderItem.isStatic,
+                renderItem.particleSystemRenderer->forwardRenderParticleSystem(viewDescriptor, renderItem.particleSystem.toWeakPointer(), renderItem.isStatic,
                                                                                renderItem.layer, lightPack, matchPhysicalPropertiesWithLighting);
             } else if (renderItem.renderer.isValid()) {
-                renderItem.renderer->forwardRenderObject(viewDescriptor, renderItem.renderable, renderItem.isStatic,
+                renderItem.renderer->forwardRenderObject(viewDescriptor, renderItem.renderable.toWeakPointer(), renderItem.isStatic,
                                                          renderItem.layer, lightPack, matchPhysicalPropertiesWithLighting);
             }
         }
@@ -385,22 +554,184 @@ namespace Core {
         this->setViewportAndMipLevelForRenderTarget(currentRenderTarget, -1);
     }
 
-    void Renderer::cullRenderListForDirectionalLight(RenderList& renderList, WeakPointer<DirectionalLight> directionalLight) {
+    /*
+     * Deactivate the items of [renderList] that can't cast a shadow into cascade [cascadeIndex] of [directionalLight]
+     * and return the number left active. The cascade's projection must already have been built. Meshes without
+     * calculated bounds and skinned meshes are always kept.
+     */
+    UInt32 Renderer::cullRenderListForDirectionalLight(RenderList& renderList, WeakPointer<DirectionalLight> directionalLight, UInt32 cascadeIndex,
+                                                       const Matrix4x4& lightTransformInverse) {
+        Box3 casterVolume;
+        directionalLight->getShadowCasterVolume(cascadeIndex, casterVolume);
+        UInt32 activeItems = 0;
         for (UInt32 i = 0; i < renderList.getItemCount(); i++) {
             RenderItem& renderItem = renderList.getRenderItem(i);
+            if (!renderItem.isActive) continue;
             if (renderItem.mesh.isValid()) {
-                Bool layerValidForLight = IntMaskUtil::isBitSet(directionalLight->getCullingMask(), renderItem.meshRenderer->getOwner()->getLayer());
+                ObjectHandle<Object3D> owner = renderItem.meshRenderer->getOwner();
+                Bool layerValidForLight = IntMaskUtil::isBitSet(directionalLight->getCullingMask(), owner->getLayer());
                 if (!layerValidForLight) {
                     renderItem.isActive = false;
                     continue;
                 }
+                ObjectHandle<MeshContainer> meshContainer = owner->getMeshContainerHandle();
+                if (!renderItem.mesh->hasBoundingBox() || meshContainer->hasVertexBoneMap(renderItem.mesh->getObjectID())) {
+                    activeItems++;
+                    continue;
+                }
+                this->shadowCasterCullingStats.testedCasters++;
+                if (!RenderUtils::isMeshInLightSpaceVolume(casterVolume, lightTransformInverse, renderItem.mesh, owner)) {
+                    this->shadowCasterCullingStats.culledCasters++;
+                    renderItem.isActive = false;
+                    continue;
+                }
+            }
+            activeItems++;
+        }
+        return activeItems;
+    }
+
+    /*
+     * Deactivate the active items of [renderList] that fall outside [faceFrustum], the 90 degree frustum of one face
+     * of a point light's shadow cube, and return the number left active. Meshes without calculated bounds and
+     * skinned meshes are always kept.
+     */
+    UInt32 Renderer::cullRenderListForCubeFace(RenderList& renderList, const Frustum& faceFrustum) {
+        UInt32 activeItems = 0;
+        for (UInt32 i = 0; i < renderList.getItemCount(); i++) {
+            RenderItem& renderItem = renderList.getRenderItem(i);
+            if (!renderItem.isActive) continue;
+            if (renderItem.mesh.isValid() && renderItem.mesh->hasBoundingBox()) {
+                ObjectHandle<Object3D> owner = renderItem.meshRenderer->getOwner();
+                if (owner->getMeshContainerHandle()->hasVertexBoneMap(renderItem.mesh->getObjectID())) {
+                    activeItems++;
+                    continue;
+                }
+                this->shadowCasterCullingStats.testedCasters++;
+                if (!RenderUtils::isMeshInFrustum(faceFrustum, renderItem.mesh, owner)) {
+                    this->shadowCasterCullingStats.culledCasters++;
+                    renderItem.isActive = false;
+                    continue;
+                }
             }
+            activeItems++;
         }
+        return activeItems;
+    }
+
+    /*
+     * Pick the lights each mesh renderer in [objects] is drawn with when rendered with [lightPack], so the per-draw
+     * light loop only visits those. Point lights come from querying the light BVH with the world bounding sphere of
+     * each of the renderer's meshes (the same sphere MeshRenderer's per-draw range test uses), so every light that
+     * passes that test is a candidate. If more candidates than the renderer can use are found, the most influential
+     * are kept. Ambient, IBL and directional lights are always kept.
+     */
+    void Renderer::assignLightsToObjects(FrameVector<WeakPointer<Object3D>>& objects, LightPack& lightPack) {
+        FrameArena::Scope frameScope(this->frameArena);
+        FrameVector<LightCandidate> candidates(this->frameArena);
+        // the renderer that last collected each point light, so a light reaching several meshes is only added once
+        FrameVector<UInt32> pointLightStamps(this->frameArena);
+        pointLightStamps.resize(lightPack.getPointLights().size(), 0);
+        UInt32 rendererStamp = 0;
+
+        this->lightAssignmentID++;
+        lightPack.setLightAssignmentID(this->lightAssignmentID);
+        this->lightBVH.build(lightPack.getPointLights());
+
+        for (UInt32 o = 0; o < objects.size(); o++) {
+            PersistentRenderList::Entry& entry = this->persistentRenderList.getEntry(objects[o]);
+            ObjectHandle<MeshRenderer> meshRenderer;
+            Real maxScale = 1.0f;
+            for (const RenderItem& renderItem : entry.items) {
+                if (!renderItem.meshRenderer.isValid()) continue;
+                ObjectHandle<Object3D> owner = renderItem.meshRenderer->getOwner();
+                // world matrices were computed by the scene traversal at the start of the frame
+                const Matrix4x4& worldMatrix = owner->getTransform().getConstWorldMatrix();
+                if (renderItem.meshRenderer != meshRenderer) {
+                    if (meshRenderer.isValid()) this->selectLightsForMeshRenderer(meshRenderer, candidates);
+                    meshRenderer = renderItem.meshRenderer;
+                    rendererStamp++;
+                    candidates.clear();
+                    for (UInt32 i = 0; i < lightPack.lightCount(); i++) {
+                        WeakPointer<Light> light = lightPack.getLight(i);
+                        if (light->getType() == LightType::Point) continue;
+                        if (!IntMaskUtil::isBitSet(light->getCullingMask(), renderItem.layer)) continue;
+                        candidates.push_back({i, std::numeric_limits<Real>::max()});
+                    }
+
+                    Point3r pos;
+                    Quaternion rot;
+                    Point3r scale;
+                    worldMatrix.decompose(pos, rot, scale);
+                    maxScale = Math::max(Math::max(scale.x, scale.y), scale.z);
+                }
+
+                const Vector4r& boundingSphere = renderItem.mesh->getBoundingSphere();
+                Point3r center(boundingSphere.x, boundingSphere.y, boundingSphere.z);
+                worldMatrix.transform(center);
+                Real radius = boundingSphere.w * maxScale;
+                this->lightQueryResults.resize(0);
+                this->lightBVH.queryLightsInRange(center, radius, this->lightQueryResults);
+                for (UInt32 pointLightIndex : this->lightQueryResults) {
+                    WeakPointer<PointLight> pointLight = lightPack.getPointLight(pointLightIndex);
+                    if (!IntMaskUtil::isBitSet(pointLight->getCullingMask(), renderItem.layer)) continue;
+
+                    // intensity scaled by a linear falloff from the light to the nearest point of the bounding sphere
+                    Vector3r toLight = this->lightBVH.getLightPosition(pointLightIndex) - center;
+                    Real distance = Math::max(toLight.magnitude() - radius, 0.0f);
+                    Real influence = pointLight->getIntensity() * Math::max(1.0f - distance / pointLight->getRadius(), 0.0f);
+                    UInt32 lightIndex = lightPack.getLightIndexOfPointLight(pointLightIndex);
+                    if (pointLightStamps[pointLightIndex] != rendererStamp) {
+                        pointLightStamps[pointLightIndex] = rendererStamp;
+                        candidates.push_back({lightIndex, influence});
+                        this->lightAssignmentStats.candidateLights++;
+                    } else {
+                        for (LightCandidate& candidate : candidates) {
+                            if (candidate.lightIndex == lightIndex) candidate.influence = Math::max(candidate.influence, influence);
+                        }
+                    }
+                }
+            }
+            if (meshRenderer.isValid()) this->selectLightsForMeshRenderer(meshRenderer, candidates);
+        }
+    }
+
+    /*
+     * Keep the point lights in [candidates] with the highest influence, up to the renderer's limit, and hand the
+     * result to [meshRenderer] in LightPack order, which keeps the per-draw loop's behaviour unchanged whenever
+     * nothing was dropped. Single pass materials are limited to the lights their shader can take, so they get the
+     * most influential ones rather than the first ones in the pack.
+     */
+    void Renderer::selectLightsForMeshRenderer(ObjectHandle<MeshRenderer> meshRenderer, FrameVector<LightCandidate>& candidates) {
+        UInt32 maxLights = this->maxLightsPerObject;
+        WeakPointer<Material> material = meshRenderer->getMaterial();
+        if (material.isValid() && material->getRenderPath() == RenderPath::SinglePassMultiLight) {
+            maxLights = Math::min(maxLights, Math::min(material->maxLightCount(), Constants::MaxShaderLights));
+        }
+
+        UInt32 pointLightCount = 0;
+        for (const LightCandidate& candidate : candidates) {
+            if (candidate.influence != std::numeric_limits<Real>::max()) pointLightCount++;
+        }
+        UInt32 keptCount = candidates.size();
+        if (pointLightCount > maxLights) {
+            keptCount = candidates.size() - (pointLightCount - maxLights);
+            std::nth_element(candidates.begin(), candidates.begin() + keptCount, candidates.end(), [](const LightCandidate& a, const LightCandidate& b) {
+                return a.influence > b.influence;
+            });
+        }
+
+        this->selectedLightIndices.resize(keptCount);
+        for (UInt32 i = 0; i < keptCount; i++) this->selectedLightIndices[i] = candidates[i].lightIndex;
+        std::sort(this->selectedLightIndices.begin(), this->selectedLightIndices.end());
+        meshRenderer->setLightSelection(this->lightAssignmentID, this->selectedLightIndices);
+
+        this->lightAssignmentStats.assignedRenderers++;
+        this->lightAssignmentStats.selectedLights += Math::min(pointLightCount, maxLights);
     }
 
     void Renderer::cullRenderListForPointLight(RenderList& renderList, WeakPointer<PointLight> pointLight) {
-        static Point3r pointLightPos;
-        pointLightPos.set(0.0f, 0.0f, 0.0f);
+        Point3r pointLightPos(0.0f, 0.0f, 0.0f);
         pointLight->getOwner()->getTransform().applyTransformationTo(pointLightPos);
         for (UInt32 i = 0; i < renderList.getItemCount(); i++) {
             RenderItem& renderItem = renderList.getRenderItem(i);
@@ -418,7 +749,7 @@ namespace Core {
     }
 
     void Renderer::renderSkybox(ViewDescriptor& viewDescriptor) {
-        static LightPack lightPack;
+        LightPack lightPack;
         if (viewDescriptor.skybox != nullptr) {
             WeakPointer<BaseObject3DRenderer> renderer = viewDescriptor.skybox->getSkyboxObject()->getBaseRenderer();
             if (renderer) {
@@ -434,7 +765,7 @@ namespace Core {
     }
 
     void Renderer::renderObjectDirect(WeakPointer<Object3D> object, WeakPointer<Camera> camera, Bool matchPhysicalPropertiesWithLighting) {
-        static LightPack lightPack;
+        LightPack lightPack;
         this->renderObjectDirect(object, camera, lightPack, matchPhysicalPropertiesWithLighting);
     }
 
@@ -457,43 +788,35 @@ namespace Core {
     }
 
     void Renderer::renderDirectionalLightShadowMaps(const std::vector<WeakPointer<DirectionalLight>>& lights,
-                                                    std::vector<WeakPointer<Object3D>>& objects, WeakPointer<Camera> renderCamera) {
-        static std::vector<std::vector<WeakPointer<Object3D>>> toRenderDirectional;
-        static std::vector<WeakPointer<DirectionalLight>> renderLights;
-        static LightPack lightPack;
-        static RenderList renderList;
+                                                    FrameVector<WeakPointer<Object3D>>& objects, WeakPointer<Camera> renderCamera) {
+        FrameArena::Scope frameScope(this->frameArena);
+        FrameVector<WeakPointer<DirectionalLight>> renderLights(this->frameArena);
+        FrameVector<WeakPointer<Object3D>> shadowCasters(this->frameArena);
+        LightPack lightPack;
+        RenderList& renderList = this->shadowRenderList;
 
         if (!this->orthoShadowMapCamera.isValid()) {
             this->orthoShadowMapCameraObject = Engine::instance()->createObject3D();
             this->orthoShadowMapCamera = Engine::instance()->createOrthographicCamera(orthoShadowMapCameraObject, 1.0f, -1.0f, -1.0f, 1.0f, PointLight::NearPlane, PointLight::FarPlane);
         }
 
-        UInt32 lightCount = 0;
-        renderLights.resize(0);
         for (auto light: lights) {
             if (!this->isShadowCastingCapableLight(light)) continue;
-            if (lightCount >= toRenderDirectional.size()) {
-                toRenderDirectional.emplace_back();
-            }
-            std::vector<WeakPointer<Object3D>>& renderObjects = toRenderDirectional[lightCount];
-            renderObjects.resize(0);
-            lightCount++;
             renderLights.push_back(light);
         }
-        for (UInt32 i = 0; i < objects.size(); i++) {
-            WeakPointer<Object3D> object = objects[i];
-            WeakPointer<BaseObject3DRenderer> renderer = object->getBaseRenderer();
-            if (renderer && renderer->castsShadows()) {
-                UInt32 curLight = 0;
-                for (auto light: renderLights) {
-                    std::vector<WeakPointer<Object3D>>& renderObjects = toRenderDirectional[curLight];
-                    renderObjects.push_back(object);
-                    curLight++;
-                }
-            }
+        if (renderLights.size() == 0) return;
+
+        // with the scene octree each light only gathers the casters near its cascades, otherwise all lights share
+        // one list of every caster in [objects]
+        Bool queryCasters = this->isSceneOctreeObjectList(objects);
+        FrameVector<WeakPointer<Object3D>> candidates(this->frameArena);
+        UInt64 staticCasterSignature = 0;
+        if (!queryCasters) {
+            this->collectShadowCasters(objects, shadowCasters);
+            this->buildRenderListFromObjects(shadowCasters, renderList);
+            staticCasterSignature = Renderer::getStaticCasterSignature(renderList);
         }
 
-        UInt32 curLight = 0;
         WeakPointer<Graphics> graphics = Engine::instance()->getGraphicsSystem();
         for (auto directionalLight: renderLights) {
             if (directionalLight->getShadowsEnabled()) {
@@ -501,14 +824,31 @@ namespace Core {
                 this->depthMaterial->setCullFace(directionalLight->getCullFace());
                 std::vector<DirectionalLight::OrthoProjection>& projections = directionalLight->buildProjections(renderCamera);
                 Matrix4x4 viewTrans = directionalLight->getOwner()->getTransform().getWorldMatrix();
+                Matrix4x4 viewTransInverse = viewTrans;
+                viewTransInverse.invert();
+
+                if (queryCasters) {
+                    // every cascade shares the light's orientation, so their caster volumes combine into one light space box
+                    Box3 casterVolume;
+                    Box3 cascadeVolume;
+                    for (UInt32 i = 0; i < directionalLight->getCascadeCount(); i++) {
+                        directionalLight->getShadowCasterVolume(i, i == 0 ? casterVolume : cascadeVolume);
+                        if (i > 0) casterVolume.expandByBox(cascadeVolume);
+                    }
+                    Frustum casterQueryFrustum;
+                    Renderer::getShadowCasterQueryFrustum(casterVolume, viewTransInverse, casterQueryFrustum);
+                    candidates.clear();
+                    shadowCasters.clear();
+                    this->sceneOctree.queryFrustum(casterQueryFrustum, candidates);
+                    this->collectShadowCasters(candidates, shadowCasters);
+                    this->buildRenderListFromObjects(shadowCasters, renderList);
+                    staticCasterSignature = Renderer::getStaticCasterSignature(renderList);
+                }
                 ViewDescriptor viewDesc;
                 viewDesc.indirectHDREnabled = false;
                 viewDesc.cubeFace = -1;
                 viewDesc.overrideMaterial = this->depthMaterial;
                 viewDesc.depthOutputOverride = DepthOutputOverride::Depth;
-                std::vector<WeakPointer<Object3D>>& renderObjects = toRenderDirectional[curLight];
-                renderList.clear();
-                this->buildRenderListFromObjects(renderObjects, renderList);
                 for (UInt32 i = 0; i < directionalLight->getCascadeCount(); i++) {
                     DirectionalLight::OrthoProjection& proj = projections[i];  
                     this->orthoShadowMapCamera->setDimensions(proj.top, proj.bottom, proj.left, proj.right);        
@@ -516,52 +856,55 @@ namespace Core {
                     this->getViewDescriptorTransformations(viewTrans, orthoShadowMapCamera->getProjectionMatrix(),
                                                            this->orthoShadowMapCamera->getAutoClearRenderBuffers(), viewDesc);
                     viewDesc.renderTarget = directionalLight->getShadowMap(i);
-                    this->renderForViewDescriptor(viewDesc, renderList, lightPack, true);
+
+                    renderList.setAllActive();
+                    directionalLight->shadowCasterCounts[i] = this->cullRenderListForDirectionalLight(renderList, directionalLight, i, viewTransInverse);
+                    if (directionalLight->getStaticShadowCachingEnabled()) {
+                        // cascades follow the render camera, so the projection is part of what the cache depends on
+                        UInt64 signature = Renderer::getShadowLightSignature(directionalLight, staticCasterSignature);
+                        const Real projectionValues[] = {proj.top, proj.bottom, proj.left, proj.right, proj.near, proj.far};
+                        for (Real value : projectionValues) signature = Renderer::combineHash(signature, Renderer::hashReal(value));
+                        this->renderShadowMapViewWithStaticCache(viewDesc, renderList, lightPack, directionalLight, i,
+                                                                 directionalLight->getCascadeCount(), signature);
+                    } else {
+                        this->renderForViewDescriptor(viewDesc, renderList, lightPack, true);
+                    }
                 }
             }
-            curLight++;
         }
     }
 
-    void Renderer::renderPointLightShadowMaps(const std::vector<WeakPointer<PointLight>>& lights, std::vector<WeakPointer<Object3D>>& objects) {
-        static std::vector<std::vector<WeakPointer<Object3D>>> toRenderPoint;
-        static std::vector<WeakPointer<PointLight>> renderLights;
-        static LightPack lightPack;
-        static RenderList renderList;
+    void Renderer::renderPointLightShadowMaps(const std::vector<WeakPointer<PointLight>>& lights, FrameVector<WeakPointer<Object3D>>& objects) {
+        FrameArena::Scope frameScope(this->frameArena);
+        FrameVector<WeakPointer<PointLight>> renderLights(this->frameArena);
+        FrameVector<WeakPointer<Object3D>> shadowCasters(this->frameArena);
+        LightPack lightPack;
+        RenderList& renderList = this->shadowRenderList;
 
         if (!this->perspectiveShadowMapCamera.isValid()) {
             this->perspectiveShadowMapCameraObject = Engine::instance()->createObject3D();
             this->perspectiveShadowMapCamera = Engine::instance()->createPerspectiveCamera(perspectiveShadowMapCameraObject, Math::PI / 2.0f, 1.0f, PointLight::NearPlane, PointLight::FarPlane);
         }
 
-        UInt32 lightCount = 0;
-        renderLights.resize(0);
         for (auto light: lights) {
             if (!this->isShadowCastingCapableLight(light)) continue;
-            if (lightCount >= toRenderPoint.size()) {
-                toRenderPoint.emplace_back();
-            }
-            std::vector<WeakPointer<Object3D>>& renderObjects = toRenderPoint[lightCount];
-            renderObjects.resize(0);
-            lightCount++;
             renderLights.push_back(light);
         }
-
-        for (UInt32 i = 0; i < objects.size(); i++) {
-            WeakPointer<Object3D> object = objects[i];
-            WeakPointer<BaseObject3DRenderer> renderer = object->getBaseRenderer();
-            if (renderer && renderer->castsShadows()) {
-                UInt32 curLight = 0;
-                for (auto light: renderLights) {
-                    std::vector<WeakPointer<Object3D>>& renderObjects = toRenderPoint[curLight];
-                    renderObjects.push_back(object);
-                    curLight++;
-                }
-            }
+        if (renderLights.size() == 0) return;
+
+        // with the scene octree each light only gathers the casters within its radius, otherwise all lights share
+        // one list of every caster in [objects]
+        Bool queryCasters = this->isSceneOctreeObjectList(objects);
+        FrameVector<WeakPointer<Object3D>> candidates(this->frameArena);
+        UInt64 staticCasterSignature = 0;
+        if (!queryCasters) {
+            this->collectShadowCasters(objects, shadowCasters);
+            this->buildRenderListFromObjects(shadowCasters, renderList);
+            staticCasterSignature = Renderer::getStaticCasterSignature(renderList);
         }
+        FrameVector<Byte> inRangeOfLight(this->frameArena);
 
         if (profileType == 2) Profiler::SingleFunction::quickSinglePassStart(40.0f);
-        UInt32 curLight = 0;
         WeakPointer<Graphics> graphics = Engine::instance()->getGraphicsSystem();
         for (auto pointLight: renderLights) {
             if (pointLight->getShadowsEnabled()) {
@@ -570,30 +913,184 @@ namespace Core {
                 WeakPointer<Object3D> lightObject = pointLight->getOwner();
                 Matrix4x4 lightTransform = lightObject->getTransform().getWorldMatrix();
                 this->perspectiveShadowMapCameraObject->getTransform().getWorldMatrix().copy(lightTransform);
+                if (queryCasters) {
+                    const Real* lightData = lightTransform.getConstData();
+                    candidates.clear();
+                    shadowCasters.clear();
+                    this->sceneOctree.querySphere(Point3r(lightData[12], lightData[13], lightData[14]), pointLight->getRadius(), candidates);
+                    this->collectShadowCasters(candidates, shadowCasters);
+                    this->buildRenderListFromObjects(shadowCasters, renderList);
+                    staticCasterSignature = Renderer::getStaticCasterSignature(renderList);
+                }
+                inRangeOfLight.resize(renderList.getItemCount());
                 this->perspectiveShadowMapCamera->setRenderTarget(shadowMapRenderTarget);
                 Vector4u renderTargetDimensions = shadowMapRenderTarget->getViewport();
                 this->perspectiveShadowMapCamera->setAspectRatioFromDimensions(renderTargetDimensions.z, renderTargetDimensions.w);
                 this->perspectiveShadowMapCamera->setOverrideMaterial(this->distanceMaterial);
                 this->perspectiveShadowMapCamera->setDepthOutputOverride(DepthOutputOverride::Distance);
-                std::vector<WeakPointer<Object3D>>& renderObjects = toRenderPoint[curLight];
-
-                renderList.clear();
-                this->buildRenderListFromObjects(renderObjects, renderList);
 
+                renderList.setAllActive();
                 this->cullRenderListForPointLight(renderList, pointLight);
+                for (UInt32 i = 0; i < renderList.getItemCount(); i++) inRangeOfLight[i] = renderList.getRenderItem(i).isActive ? 1 : 0;
                 ViewDescriptor viewDesc;
+                UInt64 signature = Renderer::getShadowLightSignature(pointLight, staticCasterSignature);
 
                 for (UInt32 i = 0; i < 6; i++) {
                     this->getViewDescriptorForCubeCamera(this->perspectiveShadowMapCamera, (CubeFace)i, viewDesc);
-                    this->renderForViewDescriptor(viewDesc, renderList, lightPack, true);
+                    for (UInt32 r = 0; r < renderList.getItemCount(); r++) renderList.getRenderItem(r).isActive = inRangeOfLight[r] != 0;
+                    UInt32 casterCount = this->cullRenderListForCubeFace(renderList, viewDesc.frustum);
+                    pointLight->shadowCasterCounts[i] = casterCount;
+
+                    // an empty face only has to be cleared, and only once until something is drawn into it again
+                    Byte faceBit = (Byte)(1 << i);
+                    if (casterCount == 0) {
+                        if (pointLight->clearedShadowFaces & faceBit) {
+                            this->shadowCasterCullingStats.skippedFaces++;
+                            continue;
+                        }
+                        pointLight->clearedShadowFaces |= faceBit;
+                    } else {
+                        pointLight->clearedShadowFaces &= (Byte)~faceBit;
+                    }
+
+                    if (casterCount > 0 && pointLight->getStaticShadowCachingEnabled()) {
+                        this->renderShadowMapViewWithStaticCache(viewDesc, renderList, lightPack, pointLight, i, 6, signature);
+                    } else {
+                        this->renderForViewDescriptor(viewDesc, renderList, lightPack, true);
+                    }
                 }
             }
-            curLight++;
         }
         if (profileType == 2) Profiler::SingleFunction::quickSinglePassSection("Point lights: ");
         if (profileType == 2) Profiler::SingleFunction::quickSinglePassEnd(true);
     }
 
+    /*
+     * Draw one shadow map view (a cube face or a cascade) of [light] through its static shadow cache target
+     * [cacheIndex]. The static items of [renderList] are redrawn into the cache only when [signature] differs from
+     * the one the cache was drawn with; the cache (color and depth) is then copied into the view's shadow map and
+     * the dynamic items are drawn over it, depth tested against the static ones. The active flags of [renderList]
+     * must already reflect culling for the view, and are left as they were.
+     */
+    void Renderer::renderShadowMapViewWithStaticCache(ViewDescriptor& viewDescriptor, RenderList& renderList, const LightPack& lightPack,
+                                                      WeakPointer<ShadowLight> light, UInt32 cacheIndex, UInt32 cacheCount, UInt64 signature) {
+        FrameArena::Scope frameScope(this->frameArena);
+        FrameVector<Byte> culledActive(this->frameArena);
+        UInt32 itemCount = renderList.getItemCount();
+        culledActive.resize(itemCount);
+        for (UInt32 i = 0; i < itemCount; i++) culledActive[i] = renderList.getRenderItem(i).isActive ? 1 : 0;
+
+        WeakPointer<RenderTarget2D> cache = light->getStaticShadowCache(cacheIndex, cacheCount);
+        if (light->staticShadowCacheSignatures[cacheIndex] != signature) {
+            for (UInt32 i = 0; i < itemCount; i++) {
+                RenderItem& renderItem = renderList.getRenderItem(i);
+                renderItem.isActive = culledActive[i] && renderItem.isStatic;
+            }
+            ViewDescriptor cacheViewDescriptor = viewDescriptor;
+            cacheViewDescriptor.renderTarget = cache;
+            cacheViewDescriptor.cubeFace = -1;
+            this->renderForViewDescriptor(cacheViewDescriptor, renderList, lightPack, true);
+            light->staticShadowCacheSignatures[cacheIndex] = signature;
+            this->shadowCacheStats.cacheUpdates++;
+        } else {
+            this->shadowCacheStats.cacheHits++;
+        }
+
+        WeakPointer<Graphics> graphics = Engine::instance()->getGraphicsSystem();
+        graphics->lowLevelBlit(cache, viewDescriptor.renderTarget, viewDescriptor.cubeFace, true, true);
+
+        for (UInt32 i = 0; i < itemCount; i++) {
+            RenderItem& renderItem = renderList.getRenderItem(i);
+            renderItem.isActive = culledActive[i] && !renderItem.isStatic;
+        }
+        ViewDescriptor dynamicViewDescriptor = viewDescriptor;
+        dynamicViewDescriptor.clearRenderBuffers = 0;
+        this->renderForViewDescriptor(dynamicViewDescriptor, renderList, lightPack, true);
+
+        for (UInt32 i = 0; i < itemCount; i++) renderList.getRenderItem(i).isActive = culledActive[i] != 0;
+    }
+
+    /*
+     * Changes whenever the set of static items in [renderList] or the world transform of any of their owners does.
+     */
+    UInt64 Renderer::getStaticCasterSignature(RenderList& renderList) {
+        UInt64 signature = 1;
+        for (UInt32 i = 0; i < renderList.getItemCount(); i++) {
+            RenderItem& renderItem = renderList.getRenderItem(i);
+            if (!renderItem.isStatic || !renderItem.renderer.isValid()) continue;
+            WeakPointer<Object3D> owner = renderItem.renderer->getOwner();
+            signature = Renderer::combineHash(signature, (UInt64)(uintptr_t)owner.get());
+            signature = Renderer::combineHash(signature, owner->getTransform().getWorldMatrixVersion());
+            signature = Renderer::combineHash(signature, (UInt64)(uintptr_t)(renderItem.mesh.isValid() ? renderItem.mesh.get() : nullptr));
+        }
+        return signature;
+    }
+
+    UInt64 Renderer::getShadowLightSignature(WeakPointer<ShadowLight> light, UInt64 staticCasterSignature) {
+        UInt64 signature = Renderer::combineHash(staticCasterSignature, (UInt64)(uintptr_t)light.get());
+        return Renderer::combineHash(signature, light->getOwner()->getTransform().getWorldMatrixVersion());
+    }
+
+    /*
+     * Never returns 0, which marks a stale static shadow cache.
+     */
+    UInt64 Renderer::combineHash(UInt64 seed, UInt64 value) {
+        seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+        return seed != 0 ? seed : 1;
+    }
+
+    UInt64 Renderer::hashReal(Real value) {
+        UInt32 bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    void Renderer::collectShadowCasters(FrameVector<WeakPointer<Object3D>>& objects, FrameVector<WeakPointer<Object3D>>& outShadowCasters) {
+        outShadowCasters.reserve(outShadowCasters.size() + objects.size());
+        for (UInt32 i = 0; i < objects.size(); i++) {
+            ObjectHandle<BaseObject3DRenderer> renderer = objects[i]->getBaseRendererHandle();
+            if (renderer.isValid() && renderer->castsShadows()) outShadowCasters.push_back(objects[i]);
+        }
+    }
+
+    /*
+     * Build a frustum that holds the world space points inside [lightSpaceVolume], a box in the space of a light
+     * whose world transformation is the inverse of [lightTransformInverse]. Sides of the box that are unbounded
+     * are left out.
+     */
+    void Renderer::getShadowCasterQueryFrustum(const Box3& lightSpaceVolume, const Matrix4x4& lightTransformInverse, Frustum& outFrustum) {
+        // row [r] of the column-major matrix maps a world space point to its light space coordinate [r]
+        const Real* m = lightTransformInverse.getConstData();
+        const Vector3r& min = lightSpaceVolume.getMin();
+        const Vector3r& max = lightSpaceVolume.getMax();
+        const Real unbounded = std::numeric_limits<Real>::max();
+        outFrustum = Frustum();
+        if (min.x > -unbounded) outFrustum.setPlane(Frustum::FrustumPlane::Left, m[0], m[4], m[8], m[12] - min.x);
+        if (max.x < unbounded) outFrustum.setPlane(Frustum::FrustumPlane::Right, -m[0], -m[4], -m[8], max.x - m[12]);
+        if (min.y > -unbounded) outFrustum.setPlane(Frustum::FrustumPlane::Bottom, m[1], m[5], m[9], m[13] - min.y);
+        if (max.y < unbounded) outFrustum.setPlane(Frustum::FrustumPlane::Top, -m[1], -m[5], -m[9], max.y - m[13]);
+        if (min.z > -unbounded) outFrustum.setPlane(Frustum::FrustumPlane::Near, m[2], m[6], m[10], m[14] - min.z);
+        if (max.z < unbounded) outFrustum.setPlane(Frustum::FrustumPlane::Far, -m[2], -m[6], -m[10], max.z - m[14]);
+    }
+
+    /*
+     * Mirror the objects of [objects] that have a renderer in the scene octree, so that passes over that list can
+     * query the objects near their view volume rather than testing each one. Bounds are only recomputed for objects
+     * whose transform or render state changed.
+     */
+    void Renderer::updateSceneOctree(FrameVector<WeakPointer<Object3D>>& objects) {
+        this->sceneOctree.beginSync();
+        for (WeakPointer<Object3D> object : objects) {
+            if (object->getBaseRendererHandle().isValid()) this->sceneOctree.syncObject(object);
+        }
+        this->sceneOctree.removeUnsyncedObjects();
+        this->sceneOctreeObjects = &objects;
+    }
+
+    Bool Renderer::isSceneOctreeObjectList(const FrameVector<WeakPointer<Object3D>>& objects) const {
+        return this->sceneOctreeObjects == &objects;
+    }
+
     void Renderer::setViewportAndMipLevelForRenderTarget(WeakPointer<RenderTarget> renderTarget, Int16 cubeFace) {
         WeakPointer<Graphics> graphics = Engine::instance()->getGraphicsSystem();
         UInt32 targetMipLevel = renderTarget->getMipLevel();
@@ -615,37 +1112,13 @@ namespace Core {
     }
 
     void Renderer::getViewDescriptorForCubeCamera(WeakPointer<Camera> camera, CubeFace cubeFace, ViewDescriptor& outDescriptor) {
-        static bool initialized = false;
-        static Matrix4x4 forward;
-        static Matrix4x4 left;
-        static Matrix4x4 right;
-        static Matrix4x4 up;
-        static Matrix4x4 down;
-        static Matrix4x4 backward;
-        static std::vector<Matrix4x4> orientations;
-        if (!initialized) {
-            initialized = true;
-            forward.lookAt(Vector3r::Zero, Vector3r::Backward, Vector3r::Down);
-            backward.lookAt(Vector3r::Zero, Vector3r::Forward, Vector3r::Down);
-            up.lookAt(Vector3r::Zero, Vector3r::Up, Vector3r::Backward);
-            down.lookAt(Vector3r::Zero, Vector3r::Down, Vector3r::Forward);
-            left.lookAt(Vector3r::Zero, Vector3r::Left, Vector3r::Down);
-            right.lookAt(Vector3r::Zero, Vector3r::Right, Vector3r::Down);
-            orientations.push_back(forward);
-            orientations.push_back(backward);
-            orientations.push_back(up);
-            orientations.push_back(down);
-            orientations.push_back(left);
-            orientations.push_back(right);
-        }
-
         WeakPointer<Graphics> graphics = Engine::instance()->getGraphicsSystem();
         ViewDescriptor baseViewDescriptor;
         this->getViewDescriptorForCamera(camera, baseViewDescriptor);
     
         ViewDescriptor viewDescriptor = baseViewDescriptor;
         Matrix4x4 cameraTransform = camera->getOwner()->getTransform().getWorldMatrix();
-        cameraTransform.multiply(orientations[(UInt16)cubeFace]);
+        cameraTransform.multiply(this->cubeFaceOrientations[(UInt16)cubeFace]);
         this->getViewDescriptorTransformations(cameraTransform, camera->getProjectionMatrix(),
                                                camera->getAutoClearRenderBuffers(), viewDescriptor);
         viewDescriptor.cubeFace = (UInt16)cubeFace;
@@ -701,7 +1174,7 @@ namespace Core {
         viewDescriptor.ssaoMap = WeakPointer<Texture2D>::nullPtr();
         viewDescriptor.ssaoRadius = camera->getSSAORadius();
         viewDescriptor.ssaoBias = camera->getSSAOBias();
-       
+        viewDescriptor.frustumCullingEnabled = camera->isFrustumCullingEnabled();
     }
 
     void Renderer::getViewDescriptorTransformations(const Matrix4x4& worldMatrix, const Matrix4x4& projectionMatrix,
@@ -713,45 +1186,165 @@ namespace Core {
         viewDescriptor.transposedCameraTransformation.copy(viewDescriptor.cameraTransformation);
         viewDescriptor.transposedCameraTransformation.transpose();
         viewDescriptor.clearRenderBuffers = clearBuffers;
+
+        Matrix4x4 viewProjection = viewDescriptor.inverseCameraTransformation;
+        viewProjection.preMultiply(projectionMatrix);
+        viewDescriptor.frustum.setFromMatrix(viewProjection);
     }
 
-    void Renderer::collectSceneObjectsAndComputeTransforms(WeakPointer<Scene> scene, std::vector<WeakPointer<Object3D>>& outObjects) {
+    void Renderer::collectSceneObjectsAndComputeTransforms(WeakPointer<Scene> scene, FrameVector<WeakPointer<Object3D>>& outObjects) {
         collectSceneObjectsAndComputeTransforms(scene->getRoot(), outObjects);
     }
 
-    void Renderer::collectSceneObjectsAndComputeTransforms(WeakPointer<Object3D> object, std::vector<WeakPointer<Object3D>>& outObjects) {
-        Matrix4x4 rootTransform;
-        collectSceneObjectsAndComputeTransforms(object, outObjects, rootTransform);
+    /*
+     * Collect [object] (the root of the scene being rendered) and its active descendants into [outObjects] and bring their world
+     * matrices up to date through 'sceneTransformHierarchy', which is only rebuilt, by a traversal of the scene, when the shape of the
+     * scene has changed. Objects are collected in the same depth-first order as by a traversal.
+     */
+    void Renderer::collectSceneObjectsAndComputeTransforms(WeakPointer<Object3D> object, FrameVector<WeakPointer<Object3D>>& outObjects) {
+        if (!this->sceneTransformHierarchy.isBuiltFor(object)) this->sceneTransformHierarchy.build(object);
+        WeakPointer<Engine> engine = Engine::instance();
+        WorkerPool* workerPool = engine->getWorkerCount() > 0 ? engine->getWorkerPool().get() : nullptr;
+        this->transformUpdateStats.visitedTransforms += this->sceneTransformHierarchy.getNodeCount();
+        this->transformUpdateStats.updatedTransforms += this->sceneTransformHierarchy.update(workerPool);
+
+        UInt32 firstObject = (UInt32)outObjects.size();
+        const std::vector<PersistentWeakPointer<Object3D>>& hierarchyObjects = this->sceneTransformHierarchy.getObjects();
+        outObjects.insert(outObjects.end(), hierarchyObjects.begin(), hierarchyObjects.end());
+        this->preProcessRenderers(outObjects, firstObject);
     }
 
-    void Renderer::collectSceneObjectsAndComputeTransforms(WeakPointer<Object3D> object, std::vector<WeakPointer<Object3D>>& outObjects, const Matrix4x4& curTransform) {
+    /*
+     * Collect [object] and its active descendants into [outObjects] and bring their world matrices up to date. [curTransformVersion]
+     * identifies [curTransform] (see Transform::updateWorldMatrixFromParent()); world matrices are only recomputed for objects whose
+     * local matrix changed or whose parent's world matrix changed, so static parts of the scene cost no matrix math.
+     *
+     * Objects are always collected in depth-first order, whether or not the traversal runs on the worker pool. Renderers are
+     * pre-processed afterwards.
+     */
+    void Renderer::collectSceneObjectsAndComputeTransforms(WeakPointer<Object3D> object, FrameVector<WeakPointer<Object3D>>& outObjects, const Matrix4x4& curTransform,
+                                                           UInt64 curTransformVersion) {
+        UInt32 firstObject = (UInt32)outObjects.size();
+        if (Engine::instance()->getWorkerCount() > 0) {
+            this->collectSceneObjectsInParallel(object, outObjects, curTransform, curTransformVersion);
+        } else {
+            collectSubtreeAndComputeTransforms(object, outObjects, curTransform, curTransformVersion, this->transformUpdateStats);
+        }
 
-        if (!object->isActive()) return;
-        Transform& objTransform = object->getTransform();
+        this->preProcessRenderers(outObjects, firstObject);
+    }
 
-        Matrix4x4& worldMatrix = objTransform.getWorldMatrix();
-        if (objTransform.getMatrixAutoUpdate()) {
-            worldMatrix.copy(curTransform);
-            worldMatrix.multiply(objTransform.getLocalMatrix());
+    /*
+     * Renderers are pre-processed on the calling thread, once every world matrix (including those of skeleton nodes) is current.
+     */
+    void Renderer::preProcessRenderers(FrameVector<WeakPointer<Object3D>>& objects, UInt32 firstObject) {
+        for (UInt32 i = firstObject; i < objects.size(); i++) {
+            ObjectHandle<BaseObject3DRenderer> renderer = objects[i]->getBaseRendererHandle();
+            if (renderer.isValid()) {
+                renderer->preProcess();
+            }
         }
-        Matrix4x4 nextTransform = worldMatrix;
+    }
 
-        outObjects.push_back(object);
+    /*
+     * Split the hierarchy below [object] into independent subtrees by visiting its top levels on the calling thread, until there are
+     * at least TraversalJobsPerThread subtrees per thread (or nothing left to split). Each subtree is then traversed by a worker into
+     * its own list, and the lists are stitched back together in depth-first order.
+     */
+    void Renderer::collectSceneObjectsInParallel(WeakPointer<Object3D> object, FrameVector<WeakPointer<Object3D>>& outObjects, const Matrix4x4& curTransform,
+                                                 UInt64 curTransformVersion) {
+        WeakPointer<WorkerPool> workerPool = Engine::instance()->getWorkerPool();
+        UInt32 targetJobCount = (workerPool->getWorkerCount() + 1) * TraversalJobsPerThread;
+        this->traversalSegments.clear();
+        this->traversalSegments.push_back({object, &curTransform, curTransformVersion, false, 0});
+
+        UInt32 jobCount = 1;
+        Bool splitAny = true;
+        while (jobCount < targetJobCount && splitAny) {
+            splitAny = false;
+            jobCount = 0;
+            this->nextTraversalSegments.clear();
+            for (const TraversalSegment& segment : this->traversalSegments) {
+                WeakPointer<Object3D> segmentObject = segment.object;
+                if (segment.expanded || segmentObject->childCount() == 0) {
+                    this->nextTraversalSegments.push_back(segment);
+                    if (!segment.expanded) jobCount++;
+                    continue;
+                }
+
+                if (!segmentObject->isActive()) continue;
+                updateObjectTransform(segmentObject, *segment.parentTransform, segment.parentTransformVersion, this->transformUpdateStats);
+                this->nextTraversalSegments.push_back({segmentObject, nullptr, 0, true, 0});
+
+                Transform& transform = segmentObject->getTransform();
+                for (SceneObjectIterator<Object3D> itr = segmentObject->beginIterateChildren(); itr != segmentObject->endIterateChildren(); ++itr) {
+                    this->nextTraversalSegments.push_back({*itr, &transform.getConstWorldMatrix(), transform.getWorldMatrixVersion(), false, 0});
+                    jobCount++;
+                }
+                splitAny = true;
+            }
+            std::swap(this->traversalSegments, this->nextTraversalSegments);
+        }
 
-         WeakPointer<BaseObject3DRenderer> renderer = object->getBaseRenderer();
-        if (renderer.isValid()) {
-            renderer->preProcess();
+        jobCount = 0;
+        for (UInt32 i = 0; i < this->traversalSegments.size(); i++) {
+            TraversalSegment& segment = this->traversalSegments[i];
+            if (segment.expanded) continue;
+            segment.jobIndex = jobCount++;
+            if (this->traversalJobs.size() < jobCount) this->traversalJobs.emplace_back();
+            TraversalJob& job = this->traversalJobs[segment.jobIndex];
+            job.segmentIndex = i;
+            job.objects.clear();
+            job.transformUpdateStats = TransformUpdateStats();
         }
 
+        workerPool->execute(jobCount, [this](UInt32 jobIndex) {
+            TraversalJob& job = this->traversalJobs[jobIndex];
+            const TraversalSegment& segment = this->traversalSegments[job.segmentIndex];
+            collectSubtreeAndComputeTransforms(segment.object, job.objects, *segment.parentTransform, segment.parentTransformVersion,
+                                               job.transformUpdateStats);
+        });
+
+        for (const TraversalSegment& segment : this->traversalSegments) {
+            if (segment.expanded) {
+                outObjects.push_back(segment.object);
+                continue;
+            }
+            TraversalJob& job = this->traversalJobs[segment.jobIndex];
+            outObjects.insert(outObjects.end(), job.objects.begin(), job.objects.end());
+            this->transformUpdateStats.visitedTransforms += job.transformUpdateStats.visitedTransforms;
+            this->transformUpdateStats.updatedTransforms += job.transformUpdateStats.updatedTransforms;
+        }
+    }
+
+    template <typename ObjectList>
+    void Renderer::collectSubtreeAndComputeTransforms(WeakPointer<Object3D> object, ObjectList& outObjects, const Matrix4x4& curTransform,
+                                                      UInt64 curTransformVersion, TransformUpdateStats& stats) {
+        if (!object->isActive()) return;
+        updateObjectTransform(object, curTransform, curTransformVersion, stats);
+        outObjects.push_back(object);
+
+        Transform& objTransform = object->getTransform();
+        const Matrix4x4& nextTransform = objTransform.getConstWorldMatrix();
+        UInt64 nextTransformVersion = objTransform.getWorldMatrixVersion();
         for (SceneObjectIterator<Object3D> itr = object->beginIterateChildren(); itr != object->endIterateChildren(); ++itr) {
             WeakPointer<Object3D> obj = *itr;
-            this->collectSceneObjectsAndComputeTransforms(obj, outObjects, nextTransform);
+            collectSubtreeAndComputeTransforms(obj, outObjects, nextTransform, nextTransformVersion, stats);
         }
     }
 
-    void Renderer::renderReflectionProbes(std::vector<WeakPointer<ReflectionProbe>>& reflectionProbeList, std::vector<WeakPointer<Object3D>> renderProbeObjects,
+    Bool Renderer::updateObjectTransform(WeakPointer<Object3D> object, const Matrix4x4& curTransform, UInt64 curTransformVersion, TransformUpdateStats& stats) {
+        stats.visitedTransforms++;
+        if (object->getTransform().updateWorldMatrixFromParent(curTransform, curTransformVersion)) {
+            stats.updatedTransforms++;
+            return true;
+        }
+        return false;
+    }
+
+    void Renderer::renderReflectionProbes(FrameVector<WeakPointer<ReflectionProbe>>& reflectionProbeList, FrameVector<WeakPointer<Object3D>>& renderProbeObjects,
                                           const LightPack& lightPack, const LightPack& nonIBLLightPack) {
-        static std::vector<WeakPointer<Object3D>> emptyObjectList;
+        FrameVector<WeakPointer<Object3D>> emptyObjectList(this->frameArena);
         for (auto reflectionProbe : reflectionProbeList) {
             if (reflectionProbe->getNeedsFullUpdate() || reflectionProbe->getNeedsSpecularUpdate()) {
 
@@ -776,7 +1369,7 @@ namespace Core {
     }
 
     void Renderer::renderReflectionProbe(WeakPointer<ReflectionProbe> reflectionProbe, Bool specularOnly,
-                                         std::vector<WeakPointer<Object3D>>& renderObjects, const LightPack& lightPack) {
+                                         FrameVector<WeakPointer<Object3D>>& renderObjects, const LightPack& lightPack) {
         WeakPointer<Graphics> graphics = Engine::instance()->getGraphicsSystem();
         WeakPointer<Camera> probeCam = reflectionProbe->getRenderCamera();
 
@@ -813,7 +1406,7 @@ namespace Core {
         reflectionProbe->setNeedsFullUpdate(false);
     }
 
-    void Renderer::renderSSAO(WeakPointer<Camera> camera, std::vector<WeakPointer<Object3D>>& objects) {
+    void Renderer::renderSSAO(WeakPointer<Camera> camera, FrameVector<WeakPointer<Object3D>>& objects) {
 
         ViewDescriptor viewDescriptor;
         this->getViewDescriptorForCamera(camera, viewDescriptor);
@@ -858,8 +1451,119 @@ namespace Core {
         return this->ssaoBlurMap;
     }
 
-    void Renderer::renderDepthAndNormals(ViewDescriptor& viewDescriptor, std::vector<WeakPointer<Object3D>>& objects) {
-        static LightPack lightPack;
+    const Renderer::FrustumCullingStats& Renderer::getFrustumCullingStats() const {
+        return this->frustumCullingStats;
+    }
+
+    void Renderer::resetFrustumCullingStats() {
+        this->frustumCullingStats.testedItems = 0;
+        this->frustumCullingStats.culledItems = 0;
+        this->frustumCullingStats.culledObjects = 0;
+    }
+
+    const Renderer::ShadowCacheStats& Renderer::getShadowCacheStats() const {
+        return this->shadowCacheStats;
+    }
+
+    void Renderer::resetShadowCacheStats() {
+        this->shadowCacheStats = ShadowCacheStats();
+    }
+
+    const Renderer::LightAssignmentStats& Renderer::getLightAssignmentStats() const {
+        return this->lightAssignmentStats;
+    }
+
+    void Renderer::resetLightAssignmentStats() {
+        this->lightAssignmentStats = LightAssignmentStats();
+    }
+
+    /*
+     * Limit on the point lights each mesh renderer is drawn with; when more reach it, the most influential are kept.
+     */
+    void Renderer::setMaxLightsPerObject(UInt32 maxLights) {
+        this->maxLightsPerObject = maxLights;
+    }
+
+    UInt32 Renderer::getMaxLightsPerObject() const {
+        return this->maxLightsPerObject;
+    }
+
+    /*
+     * Clustered light grids are opt-in: one is built for a camera only when it's enabled both here and on the
+     * camera (Camera::setClusteredLightingEnabled()). Both default to off.
+     */
+    void Renderer::setClusteredLightingEnabled(Bool enabled) {
+        this->clusteredLightingEnabled = enabled;
+    }
+
+    Bool Renderer::isClusteredLightingEnabled() const {
+        return this->clusteredLightingEnabled;
+    }
+
+    const Renderer::ShadowCasterCullingStats& Renderer::getShadowCasterCullingStats() const {
+        return this->shadowCasterCullingStats;
+    }
+
+    void Renderer::resetShadowCasterCullingStats() {
+        this->shadowCasterCullingStats = ShadowCasterCullingStats();
+    }
+
+    /*
+     * Number of scene objects visited and number of world matrices recomputed during the last renderScene() call.
+     */
+    const Renderer::TransformUpdateStats& Renderer::getTransformUpdateStats() const {
+        return this->transformUpdateStats;
+    }
+
+    void Renderer::resetTransformUpdateStats() {
+        this->transformUpdateStats.visitedTransforms = 0;
+        this->transformUpdateStats.updatedTransforms = 0;
+    }
+
+    const Renderer::StateChangeStats& Renderer::getStateChangeStats() const {
+        return this->stateChangeStats;
+    }
+
+    void Renderer::resetStateChangeStats() {
+        this->stateChangeStats = StateChangeStats();
+    }
+
+    /*
+     * Sorted draw packets of the most recently rendered view.
+     */
+    const DrawCommandBuffer& Renderer::getDrawCommandBuffer() const {
+        return this->drawCommandBuffer;
+    }
+
+    const PersistentRenderList& Renderer::getPersistentRenderList() const {
+        return this->persistentRenderList;
+    }
+
+    const FrameArena& Renderer::getFrameArena() const {
+        return this->frameArena;
+    }
+
+    /*
+     * Set the root cell of the scene octree. Objects outside of it are still found by queries, but are tested one
+     * by one, so the bounds should enclose most of the scene.
+     */
+    void Renderer::setSceneOctreeBounds(const Box3& worldBounds) {
+        this->sceneOctree = Octree(worldBounds);
+    }
+
+    const Octree& Renderer::getSceneOctree() const {
+        return this->sceneOctree;
+    }
+
+    /*
+     * The standard cameras rendered by the last renderScene() call; cube cameras aren't included.
+     */
+    const std::vector<Renderer::RenderedView>& Renderer::getRenderedViews() const {
+        return this->renderedViews;
+    }
+
+    void Renderer::renderDepthAndNormals(ViewDescriptor& viewDescriptor, FrameVector<WeakPointer<Object3D>>& objects) {
+        LightPack lightPack;
 
         WeakPointer<RenderTarget> saveRenderTarget = viewDescriptor.renderTarget;
         WeakPointer<RenderTarget> saveHDRRenderTarget = viewDescriptor.hdrRenderTarget;
@@ -880,8 +1584,8 @@ namespace Core {
         viewDescriptor.overrideMaterial = saveOverrideMaterial;
     }
 
-    void Renderer::renderPositionsAndNormals(ViewDescriptor& viewDescriptor, std::vector<WeakPointer<Object3D>>& objects) {
-        static LightPack lightPack;
+    void Renderer::renderPositionsAndNormals(ViewDescriptor& viewDescriptor, FrameVector<WeakPointer<Object3D>>& objects) {
+        LightPack lightPack;
 
         WeakPointer<RenderTarget> saveRenderTarget = viewDescriptor.renderTarget;
         WeakPointer<RenderTarget> saveHDRRenderTarget = viewDescriptor.hdrRenderTarget;
@@ -973,98 +1677,31 @@ namespace Core {
         }
     }
 
-    void Renderer::sortObjectsIntoRenderQueues(std::vector<WeakPointer<Object3D>>& objects, RenderQueueManager& renderQueueManager, Int32 overrideRenderQueueID) {
-        for(UInt32 i = 0; i < objects.size(); i++) {
-            WeakPointer<Object3D> object = objects[i];
-            WeakPointer<BaseObject3DRenderer> renderer = object->getBaseRenderer();
-            if (renderer.isValid()) {
-                UInt32 renderQueueID = -1;
-                if (overrideRenderQueueID >= 0) {
-                    renderQueueID = (UInt32)overrideRenderQueueID;
-                } else {
-                    renderQueueID = renderer->getRenderQueueID();
-                }
-                WeakPointer<BaseRenderableContainer> renderableContainer = object->getBaseRenderableContainer();
-                WeakPointer<MeshRenderer> meshRenderer = object->getMeshRenderer();
-                WeakPointer<MeshContainer> meshContainer = object->getMeshContainer();
-                WeakPointer<ParticleSystemRenderer> particleSystemRenderer = object->getParticleSystemRenderer();
-                WeakPointer<ParticleSystem> particleSystem = object->getParticleSystem();
-                if (meshRenderer.isValid() && meshContainer.isValid()) {
-                    UInt32 renderableCount = meshContainer->getBaseRenderableCount();
-                    for(UInt32 i = 0; i < renderableCount; i++) {
-                        WeakPointer<Mesh> mesh = meshContainer->getRenderable(i);
-                        renderQueueManager.addMeshToQueue(renderQueueID, meshRenderer, mesh, object->isStatic(), true, object->getLayer());
-                    }
-                } if (particleSystemRenderer.isValid() && particleSystem.isValid()) {
-                    renderQueueManager.addParticleSystemToQueue(renderQueueID, particleSystemRenderer, particleSystem, object->isStatic(), true, object->getLayer());
-                } else if (renderableContainer.isValid()) {
-                    UInt32 renderableCount = renderableContainer->getBaseRenderableCount();
-                    for(UInt32 i = 0; i < renderableCount; i++) {
-                        WeakPointer<BaseRenderable> renderable = renderableContainer->getBaseRenderable(i);
-                        renderQueueManager.addItemToQueue(renderQueueID, renderer, renderable, object->isStatic(), true, object->getLayer());
-                    }
-                }
-            }
-        }
-    }
-
-    void Renderer::buildRenderListFromObjects(std::vector<WeakPointer<Object3D>>& objects, RenderList& renderList) {
-        renderList.clear();
-        for(UInt32 i = 0; i < objects.size(); i++) {
-            WeakPointer<Object3D> object = objects[i];
-            WeakPointer<BaseObject3DRenderer> renderer = object->getBaseRenderer();
-            if (renderer.isValid()) {
-                WeakPointer<BaseRenderableContainer> renderableContainer = object->getBaseRenderableContainer();
-                WeakPointer<MeshContainer> meshContainer = object->getMeshContainer();
-                WeakPointer<MeshRenderer> meshRenderer = object->getMeshRenderer();
-                WeakPointer<ParticleSystemRenderer> particleSystemRenderer = object->getParticleSystemRenderer();
-                WeakPointer<ParticleSystem> particleSystem = object->getParticleSystem();
-                if (meshRenderer.isValid() && meshContainer.isValid()) {
-                    UInt32 renderableCount = meshContainer->getBaseRenderableCount();
-                    for(UInt32 i = 0; i < renderableCount; i++) {
-                        WeakPointer<Mesh> mesh = meshContainer->getRenderable(i);
-                        renderList.addMesh(meshRenderer, mesh, object->isStatic(), true, object->getLayer());
-                    }
-                } else if (particleSystemRenderer.isValid() && particleSystem.isValid()) {
-                    renderList.addParticleSystem(particleSystemRenderer, particleSystem, object->isStatic(), true, object->getLayer());
-                } else if (renderableContainer.isValid()) {
-                    UInt32 renderableCount = renderableContainer->getBaseRenderableCount();
-                    for(UInt32 i = 0; i < renderableCount; i++) {
-                        WeakPointer<BaseRenderable> renderable = renderableContainer->getBaseRenderable(i);
-                        renderList.addItem(renderer, renderable, object->isStatic(), true, object->getLayer());
-                    }
-                }
-            }
+    /*
+     * Test [mesh] against [frustum] using its world-space bounding box. Meshes without calculated
+     * bounds and skinned meshes (whose bind-pose bounds don't reflect the animated pose) are never culled.
+     */
+    Bool Renderer::isMeshFrustumCulled(const Frustum& frustum, ObjectHandle<Object3D> object, ObjectHandle<MeshContainer> meshContainer,
+                                       ObjectHandle<Mesh> mesh, FrustumCullingStats& stats) {
+        if (!mesh->hasBoundingBox()) return false;
+        if (meshContainer->hasVertexBoneMap(mesh->getObjectID())) return false;
+        stats.testedItems++;
+        if (!RenderUtils::isMeshInFrustum(frustum, mesh, object)) {
+            stats.culledItems++;
+            return true;
         }
+        return false;
     }
 
-    void Renderer::buildRenderListFromObjectsP(std::vector<WeakPointer<Object3D>>& objects, RenderList& renderList) {
+    /*
+     * Fill [renderList] with copies of the persistent render items of [objects], so they can be culled
+     * (deactivated) per light without touching the cached items.
+     */
+    void Renderer::buildRenderListFromObjects(FrameVector<WeakPointer<Object3D>>& objects, RenderList& renderList) {
         renderList.clear();
         for(UInt32 i = 0; i < objects.size(); i++) {
-            WeakPointer<Object3D> object = objects[i];
-            WeakPointer<BaseObject3DRenderer> renderer = object->getBaseRenderer();
-            if (renderer.isValid()) {
-                WeakPointer<BaseRenderableContainer> renderableContainer = object->getBaseRenderableContainer();
-                WeakPointer<MeshContainer> meshContainer = object->getMeshContainer();
-                WeakPointer<MeshRenderer> meshRenderer = object->getMeshRenderer();
-                WeakPointer<ParticleSystemRenderer> particleSystemRenderer = object->getParticleSystemRenderer();
-                WeakPointer<ParticleSystem> particleSystem = object->getParticleSystem();
-                if (meshRenderer.isValid() && meshContainer.isValid()) {
-                    UInt32 renderableCount = meshContainer->getBaseRenderableCount();
-                    for(UInt32 r = 0; r < renderableCount; r++) {
-                        WeakPointer<Mesh> mesh = meshContainer->getRenderable(r);
-                        renderList.addMesh(meshRenderer, mesh, object->isStatic(), true, object->getLayer());
-                    }
-                } else if (particleSystemRenderer.isValid() && particleSystem.isValid()) {
-                    renderList.addParticleSystem(particleSystemRenderer, particleSystem, object->isStatic(), true, object->getLayer());
-                } else if (renderableContainer.isValid()) {
-                    UInt32 renderableCount = renderableContainer->getBaseRenderableCount();
-                    for(UInt32 r = 0; r < renderableCount; r++) {
-                        WeakPointer<BaseRenderable> renderable = renderableContainer->getBaseRenderable(r);
-                        renderList.addItem(renderer, renderable, object->isStatic(), true, object->getLayer());
-                    }
-                }
-            }
+            PersistentRenderList::Entry& entry = this->persistentRenderList.getEntry(objects[i]);
+            for (const RenderItem& renderItem : entry.items) renderList.addRenderItem(renderItem);
         }
     }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "../common/complextypes.h"
@@ -7,14 +8,20 @@
 #include "../base/CoreObject.h"
 #include "RenderBuffer.h"
 #include "RenderState.h"
-#include "RenderQueueManager.h"
 #include "RenderList.h"
+#include "DrawCommandBuffer.h"
+#include "PersistentRenderList.h"
 #include "../geometry/Vector2.h"
 #include "../geometry/Vector4.h"
+#include "../geometry/Frustum.h"
 #include "../scene/Transform.h"
+#include "../scene/Octree.h"
+#include "../scene/TransformHierarchy.h"
 #include "../util/WeakPointer.h"
+#include "../util/FrameArena.h"
 #include "../light/LightType.h"
 #include "../light/LightPack.h"
+#include "../light/LightBVH.h"
 #include "../base/BitMask.h"
 #include "DepthOutputOverride.h"
 #include "CubeFace.h"
@@ -28,6 +35,8 @@ namespace Core {
     class Light;
     class DirectionalLight;
     class PointLight;
+    class MeshRenderer;
+    class ShadowLight;
     class AmbientLight;
     class AmbientIBLLight;
     class ViewDescriptor;
@@ -45,9 +54,81 @@ namespace Core {
     class ReflectionProbe;
     class Skybox;
     class Texture2D;
+    class Frustum;
+    class Mesh;
+    class MeshContainer;
 
     class Renderer : public CoreObject {
     public:
+        // a parallel scene traversal is split into at least this many subtrees per thread
+        static const UInt32 TraversalJobsPerThread = 4;
+        // maximum number of objects whose draw packets are recorded by a single worker job
+        static const UInt32 DrawRecordingBatchSize = 256;
+        // default limit on the point lights a mesh renderer is drawn with, see setMaxLightsPerObject()
+        static const UInt32 DefaultMaxLightsPerObject = 8;
+        // half the edge length of the scene octree's default root cell, see setSceneOctreeBounds()
+        static const UInt32 DefaultSceneOctreeExtent = 4096;
+        // maximum number of views recorded for getRenderedViews()
+        static const UInt32 MaxRenderedViewCount = 32;
+
+        // a standard camera rendered by the last renderScene() call, see getRenderedViews()
+        class RenderedView {
+        public:
+            Frustum frustum;
+            Point3r position;
+        };
+
+        class FrustumCullingStats {
+        public:
+            UInt32 testedItems = 0;
+            UInt32 culledItems = 0;
+            // objects left out by the scene octree query, before any of their items were tested
+            UInt32 culledObjects = 0;
+        };
+
+        class ShadowCasterCullingStats {
+        public:
+            UInt32 testedCasters = 0;
+            UInt32 culledCasters = 0;
+            // point light cube faces that were left untouched because they had no casters and were already clear
+            UInt32 skippedFaces = 0;
+        };
+
+        // shadow map views (cube faces or cascades) drawn through a static shadow cache, split by whether the
+        // cache had to be redrawn
+        class ShadowCacheStats {
+        public:
+            UInt32 cacheUpdates = 0;
+            UInt32 cacheHits = 0;
+        };
+
+        class LightAssignmentStats {
+        public:
+            UInt32 assignedRenderers = 0;
+            // point lights found in range of a renderer's meshes, and how many of them were kept
+            UInt32 candidateLights = 0;
+            UInt32 selectedLights = 0;
+        };
+
+        class TransformUpdateStats {
+        public:
+            UInt32 visitedTransforms = 0;
+            UInt32 updatedTransforms = 0;
+        };
+
+        // the "avoided" counts are relative to drawing in collection order, and can be negative for meshes
+        // (grouping by material may split runs of one mesh) and for back-to-front sorted transparent queues
+        class StateChangeStats {
+        public:
+            UInt32 drawCommands = 0;
+            UInt32 shaderChanges = 0;
+            UInt32 materialChanges = 0;
+            UInt32 meshChanges = 0;
+            Int32 shaderChangesAvoided = 0;
+            Int32 materialChangesAvoided = 0;
+            Int32 meshChangesAvoided = 0;
+        };
+
         virtual ~Renderer();
         virtual Bool init();
         void renderScene(WeakPointer<Scene> scene, WeakPointer<Material> overrideMaterial = WeakPointer<Material>::nullPtr());
@@ -57,39 +138,118 @@ namespace Core {
         void renderObjectDirect(WeakPointer<Object3D> object, WeakPointer<Camera> camera, const LightPack& lightPack,
                                 Bool matchPhysicalPropertiesWithLighting);
         WeakPointer<Texture2D> getSSAOTexture();
+        const FrustumCullingStats& getFrustumCullingStats() const;
+        void resetFrustumCullingStats();
+        const ShadowCasterCullingStats& getShadowCasterCullingStats() const;
+        void resetShadowCasterCullingStats();
+        const ShadowCacheStats& getShadowCacheStats() const;
+        void resetShadowCacheStats();
+        const LightAssignmentStats& getLightAssignmentStats() const;
+        void resetLightAssignmentStats();
+        void setMaxLightsPerObject(UInt32 maxLights);
+        UInt32 getMaxLightsPerObject() const;
+        void setClusteredLightingEnabled(Bool enabled);
+        Bool isClusteredLightingEnabled() const;
+        const TransformUpdateStats& getTransformUpdateStats() const;
+        void resetTransformUpdateStats();
+        const StateChangeStats& getStateChangeStats() const;
+        void resetStateChangeStats();
+        const DrawCommandBuffer& getDrawCommandBuffer() const;
+        const PersistentRenderList& getPersistentRenderList() const;
+        const FrameArena& getFrameArena() const;
+        void setSceneOctreeBounds(const Box3& worldBounds);
+        const Octree& getSceneOctree() const;
+        const std::vector<RenderedView>& getRenderedViews() const;
 
     protected:
+
+        class DrawCandidate {
+        public:
+            RenderItem* renderItem;
+            Int32 queueID;
+            Real depth;
+            UInt64 shaderID;
+            UInt64 materialID;
+            UInt64 meshID;
+        };
+
+        class LightCandidate {
+        public:
+            UInt32 lightIndex;
+            Real influence;
+        };
+
+        class DrawRecordingBatch {
+        public:
+            std::vector<DrawCandidate> candidates;
+            FrustumCullingStats frustumCullingStats;
+        };
+
+        // a subtree of the scene traversal: either visited up front on the calling thread (expanded) or handed to a worker
+        class TraversalSegment {
+        public:
+            WeakPointer<Object3D> object;
+            const Matrix4x4* parentTransform;
+            UInt64 parentTransformVersion;
+            Bool expanded;
+            UInt32 jobIndex;
+        };
+
+        class TraversalJob {
+        public:
+            UInt32 segmentIndex;
+            std::vector<WeakPointer<Object3D>> objects;
+            TransformUpdateStats transformUpdateStats;
+        };
+
         Renderer();
-        void renderForCamera(WeakPointer<Camera> camera, std::vector<WeakPointer<Object3D>>& objects, 
+        void renderForCamera(WeakPointer<Camera> camera, FrameVector<WeakPointer<Object3D>>& objects, 
                              Bool matchPhysicalPropertiesWithLighting);
-        void renderForCamera(WeakPointer<Camera> camera, std::vector<WeakPointer<Object3D>>& objects, 
+        void renderForCamera(WeakPointer<Camera> camera, FrameVector<WeakPointer<Object3D>>& objects, 
                              const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting);
-        void renderForStandardCamera(WeakPointer<Camera> camera, std::vector<WeakPointer<Object3D>>& objects, 
+        void renderForStandardCamera(WeakPointer<Camera> camera, FrameVector<WeakPointer<Object3D>>& objects, 
                                      const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting,
                                      WeakPointer<Texture2D> ssaoMap = WeakPointer<Texture2D>::nullPtr());
-        void renderForCubeCamera(WeakPointer<Camera> camera, std::vector<WeakPointer<Object3D>>& objects, 
+        void renderForCubeCamera(WeakPointer<Camera> camera, FrameVector<WeakPointer<Object3D>>& objects, 
                                  const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting);
-        void renderForViewDescriptor(ViewDescriptor& viewDescriptor, std::vector<WeakPointer<Object3D>>& objectList, 
-                                     const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting);
-        void renderForViewDescriptor(ViewDescriptor& viewDescriptor, RenderQueueManager& renderQueueManager, 
+        void renderForViewDescriptor(ViewDescriptor& viewDescriptor, FrameVector<WeakPointer<Object3D>>& objectList, 
                                      const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting);
         void renderForViewDescriptor(ViewDescriptor& viewDescriptor, RenderList& renderList, 
                                      const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting);
-        void renderRenderList(ViewDescriptor& viewDescriptor, RenderList& renderList, 
-                              const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting);
+        void recordDrawCommands(ViewDescriptor& viewDescriptor, FrameVector<WeakPointer<Object3D>>& objects);
+        void recordDrawCommands(ViewDescriptor& viewDescriptor, RenderList& renderList, Int32 queueID);
+        void recordDrawCommand(ViewDescriptor& viewDescriptor, RenderItem& renderItem, Int32 queueID);
+        void describeDrawCommand(ViewDescriptor& viewDescriptor, RenderItem& renderItem, Int32 queueID, DrawCandidate& candidate);
+        void addDrawCommand(const DrawCandidate& candidate);
+        void sortDrawCommands();
+        void executeDrawCommands(ViewDescriptor& viewDescriptor, const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting);
         void renderRenderItem(ViewDescriptor& viewDescriptor, RenderItem& renderItem, 
                               const LightPack& lightPack, Bool matchPhysicalPropertiesWithLighting);
         WeakPointer<RenderTarget> preRenderForViewDescriptor(ViewDescriptor& viewDescriptor);
         void postRenderForViewDescriptor(ViewDescriptor& viewDescriptor, WeakPointer<RenderTarget> currentRenderTarget);
 
-        void cullRenderListForDirectionalLight(RenderList& renderList, WeakPointer<DirectionalLight> DirectionalLight);
+        UInt32 cullRenderListForDirectionalLight(RenderList& renderList, WeakPointer<DirectionalLight> directionalLight, UInt32 cascadeIndex,
+                                                 const Matrix4x4& lightTransformInverse);
         void cullRenderListForPointLight(RenderList& renderList, WeakPointer<PointLight> pointLight);
+        void assignLightsToObjects(FrameVector<WeakPointer<Object3D>>& objects, LightPack& lightPack);
+        void selectLightsForMeshRenderer(ObjectHandle<MeshRenderer> meshRenderer, FrameVector<LightCandidate>& candidates);
+        UInt32 cullRenderListForCubeFace(RenderList& renderList, const Frustum& faceFrustum);
+        void renderShadowMapViewWithStaticCache(ViewDescriptor& viewDescriptor, RenderList& renderList, const LightPack& lightPack,
+                                                WeakPointer<ShadowLight> light, UInt32 cacheIndex, UInt32 cacheCount, UInt64 signature);
+        static UInt64 getStaticCasterSignature(RenderList& renderList);
+        static UInt64 getShadowLightSignature(WeakPointer<ShadowLight> light, UInt64 staticCasterSignature);
+        static UInt64 combineHash(UInt64 seed, UInt64 value);
+        static UInt64 hashReal(Real value);
         void renderSkybox(ViewDescriptor& viewDescriptor);
         void renderObjectDirect(WeakPointer<Object3D> object, ViewDescriptor& viewDescriptor, const LightPack& lightPack,
                                 Bool matchPhysicalPropertiesWithLighting);
         void renderDirectionalLightShadowMaps(const std::vector<WeakPointer<DirectionalLight>>& lightList,
-                                              std::vector<WeakPointer<Object3D>>& objects, WeakPointer<Camera> renderCamera);
-        void renderPointLightShadowMaps(const std::vector<WeakPointer<PointLight>>& lightList, std::vector<WeakPointer<Object3D>>& objects);
+                                              FrameVector<WeakPointer<Object3D>>& objects, WeakPointer<Camera> renderCamera);
+        void renderPointLightShadowMaps(const std::vector<WeakPointer<PointLight>>& lightList, FrameVector<WeakPointer<Object3D>>& objects);
+        void collectShadowCasters(FrameVector<WeakPointer<Object3D>>& objects, FrameVector<WeakPointer<Object3D>>& outShadowCasters);
+        static void getShadowCasterQueryFrustum(const Box3& lightSpaceVolume, const Matrix4x4& lightTransformInverse, Frustum& outFrustum);
+        void updateSceneOctree(FrameVector<WeakPointer<Object3D>>& objects);
+        Bool isSceneOctreeObjectList(const FrameVector<WeakPointer<Object3D>>& objects) const;
         void setViewportAndMipLevelForRenderTarget(WeakPointer<RenderTarget> renderTarget, Int16 cubeFace);
         void clearActiveRenderTarget(ViewDescriptor& viewDescriptor);
         void getViewDescriptorForCubeCamera(WeakPointer<Camera> camera, CubeFace cubeFace, ViewDescriptor& outDescriptor);
@@ -98,28 +258,33 @@ namespace Core {
         void getViewDescriptorForCamera(WeakPointer<Camera> camera, ViewDescriptor& viewDescriptor);
         void getViewDescriptorTransformations(const Matrix4x4& worldMatrix, const Matrix4x4& projectionMatrix,
                                               IntMask clearBuffers, ViewDescriptor& viewDescriptor);
-        void collectSceneObjectsAndComputeTransforms(WeakPointer<Scene> scene, std::vector<WeakPointer<Object3D>>& outObjects);
-        void collectSceneObjectsAndComputeTransforms(WeakPointer<Object3D> object, std::vector<WeakPointer<Object3D>>& outObjects);
-        void collectSceneObjectsAndComputeTransforms(WeakPointer<Object3D> object, std::vector<WeakPointer<Object3D>>& outObjects, const Matrix4x4& curTransform);
-        void collectSceneObjectComponents(std::vector<WeakPointer<Object3D>>& sceneObjects, std::vector<WeakPointer<Camera>>& cameraList,
-                                          std::vector<WeakPointer<ReflectionProbe>>& reflectionProbeList, std::vector<WeakPointer<Light>>& nonIBLLightList,
-                                          std::vector<WeakPointer<DirectionalLight>>& directionalLightList, std::vector<WeakPointer<PointLight>>& pointLightList,
-                                          std::vector<WeakPointer<AmbientLight>>& ambientLightList, std::vector<WeakPointer<AmbientIBLLight>>& ambientIBLLightList,
-                                          std::vector<WeakPointer<Light>>& lightList);
-        void renderReflectionProbes(std::vector<WeakPointer<ReflectionProbe>>& reflectionProbeList, std::vector<WeakPointer<Object3D>> staticObjects,
+        void collectSceneObjectsAndComputeTransforms(WeakPointer<Scene> scene, FrameVector<WeakPointer<Object3D>>& outObjects);
+        void collectSceneObjectsAndComputeTransforms(WeakPointer<Object3D> object, FrameVector<WeakPointer<Object3D>>& outObjects);
+        void collectSceneObjectsAndComputeTransforms(WeakPointer<Object3D> object, FrameVector<WeakPointer<Object3D>>& outObjects, const Matrix4x4& curTransform,
+                                                     UInt64 curTransformVersion = Transform::UntrackedParentVersion);
+        void collectSceneObjectsInParallel(WeakPointer<Object3D> object, FrameVector<WeakPointer<Object3D>>& outObjects, const Matrix4x4& curTransform,
+                                           UInt64 curTransformVersion);
+        template <typename ObjectList>
+        static void collectSubtreeAndComputeTransforms(WeakPointer<Object3D> object, ObjectList& outObjects, const Matrix4x4& curTransform,
+                                                       UInt64 curTransformVersion, TransformUpdateStats& stats);
+        void preProcessRenderers(FrameVector<WeakPointer<Object3D>>& objects, UInt32 firstObject);
+        static Bool updateObjectTransform(WeakPointer<Object3D> object, const Matrix4x4& curTransform, UInt64 curTransformVersion, TransformUpdateStats& stats);
+        void collectSceneObjectComponents(FrameVector<WeakPointer<Object3D>>& sceneObjects, FrameVector<WeakPointer<Camera>>& cameraList,
+                                          FrameVector<WeakPointer<ReflectionProbe>>& reflectionProbeList,
+                                          FrameVector<WeakPointer<DirectionalLight>>& directionalLightList, FrameVector<WeakPointer<PointLight>>& pointLightList,
+                                          FrameVector<WeakPointer<AmbientLight>>& ambientLightList, FrameVector<WeakPointer<AmbientIBLLight>>& ambientIBLLightList);
+        void renderReflectionProbes(FrameVector<WeakPointer<ReflectionProbe>>& reflectionProbeList, FrameVector<WeakPointer<Object3D>>& renderProbeObjects,
                                     const LightPack& lightPack, const LightPack& nonIBLLightPack);
         void renderReflectionProbe(WeakPointer<ReflectionProbe> reflectionProbe, Bool specularOnly,
-                                   std::vector<WeakPointer<Object3D>>& renderObjects, const LightPack& lightPack);
-        void renderSSAO(WeakPointer<Camera> camera, std::vector<WeakPointer<Object3D>>& objects);
-        void renderDepthAndNormals(ViewDescriptor& viewDescriptor, std::vector<WeakPointer<Object3D>>& objects);
-        void renderPositionsAndNormals(ViewDescriptor& viewDescriptor, std::vector<WeakPointer<Object3D>>& objects);
+                                   FrameVector<WeakPointer<Object3D>>& renderObjects, const LightPack& lightPack);
+        void renderSSAO(WeakPointer<Camera> camera, FrameVector<WeakPointer<Object3D>>& objects);
+        void renderDepthAndNormals(ViewDescriptor& viewDescriptor, FrameVector<WeakPointer<Object3D>>& objects);
+        void renderPositionsAndNormals(ViewDescriptor& viewDescriptor, FrameVector<WeakPointer<Object3D>>& objects);
         void initializeSSAO();
 
-        void sortObjectsIntoRenderQueues(std::vector<WeakPointer<Object3D>>& objects, RenderQueueManager& renderQueueManager, Int32 overrideRenderQueueID=-1);
-        void buildRenderListFromObjects(std::vector<WeakPointer<Object3D>>& objects, RenderList& renderList);
-
-
-void buildRenderListFromObjectsP(std::vector<WeakPointer<Object3D>>& objects, RenderList& renderList);
+        static Bool isMeshFrustumCulled(const Frustum& frustum, ObjectHandle<Object3D> object, ObjectHandle<MeshContainer> meshContainer,
+                                        ObjectHandle<Mesh> mesh, FrustumCullingStats& stats);
+        void buildRenderListFromObjects(FrameVector<WeakPointer<Object3D>>& objects, RenderList& renderList);
 
         static Bool isShadowCastingCapableLight(WeakPointer<Light> light);
         static Bool compareLights (WeakPointer<Light> a, WeakPointer<Light> b);
@@ -147,5 +312,39 @@ void buildRenderListFromObjectsP(std::vector<WeakPointer<Object3D>>& objects, Re
         PersistentWeakPointer<SSAOBlurMaterial> ssaoBlurMaterial;
         WeakPointer<Texture2D> ssaoNoise;
         std::vector<Vector3r> ssaoKernel;
+
+        FrustumCullingStats frustumCullingStats;
+        ShadowCasterCullingStats shadowCasterCullingStats;
+        ShadowCacheStats shadowCacheStats;
+        LightAssignmentStats lightAssignmentStats;
+        TransformUpdateStats transformUpdateStats;
+        StateChangeStats stateChangeStats;
+        DrawCommandBuffer drawCommandBuffer;
+        PersistentRenderList persistentRenderList;
+        std::vector<PersistentRenderList::Entry*> recordingEntries;
+        std::vector<DrawRecordingBatch> drawRecordingBatches;
+        std::vector<TraversalSegment> traversalSegments;
+        std::vector<TraversalSegment> nextTraversalSegments;
+        std::vector<TraversalJob> traversalJobs;
+
+        // temporaries of a frame's passes are carved from 'frameArena'; each pass rewinds it when done
+        FrameArena frameArena;
+        LightPack sceneLightPack;
+        LightPack sceneNonIBLLightPack;
+        LightBVH lightBVH;
+        UInt64 lightAssignmentID;
+        UInt32 maxLightsPerObject;
+        Bool clusteredLightingEnabled;
+        std::vector<UInt32> lightQueryResults;
+        std::vector<UInt32> selectedLightIndices;
+        RenderList shadowRenderList;
+        // renderable objects of the scene last passed to renderScene(); 'sceneOctreeObjects' is the object list it
+        // mirrors while that call is in progress, and null otherwise
+        Octree sceneOctree;
+        const FrameVector<WeakPointer<Object3D>>* sceneOctreeObjects;
+        // flat transform hierarchy of the scene last passed to renderScene()
+        TransformHierarchy sceneTransformHierarchy;
+        std::vector<RenderedView> renderedViews;
+        Matrix4x4 cubeFaceOrientations[6];
     };
 }
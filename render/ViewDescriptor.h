@@ -3,6 +3,7 @@
 #include "../util/PersistentWeakPointer.h"
 #include "../base/BitMask.h"
 #include "../math/Matrix4x4.h"
+#include "../geometry/Frustum.h"
 #include "ToneMapType.h"
 #include "DepthOutputOverride.h"
 
@@ -39,6 +40,8 @@ namespace Core {
         Real ssaoRadius = 1.5f;
         Real ssaoBias = 0.05f;
         DepthOutputOverride depthOutputOverride = DepthOutputOverride::None;
+        Frustum frustum;
+        Bool frustumCullingEnabled = false;
     };
 
 }
\ No newline at end of file
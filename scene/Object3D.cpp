@@ -1,3 +1,5 @@
+#include <atomic>
+
 #include "Object3D.h"
 #include "../Engine.h"
 #include "Transform.h"
@@ -16,13 +18,16 @@
 namespace Core {
 
     UInt64 Object3D::_nextID = 0;
+    UInt64 Object3D::_hierarchyVersion = 0;
 
-    Object3D::Object3D() : transform(*this), active(true) {
+    Object3D::Object3D() : transform(*this), active(true), objStatic(false) {
         this->id = Object3D::getNextID();
+        this->renderStateVersion = Object3D::nextRenderStateVersion();
         this->layer = (Int32) Object3D::ObjectLayer::Default;
     }
 
     Object3D::~Object3D() {
+        Object3D::invalidateHierarchy();
         for (UInt32 i = 0; i < this->children.size(); i ++) {
             WeakPointer<Object3D> child = this->children[i];
              Engine::safeReleaseObject(child);
@@ -51,6 +56,23 @@ namespace Core {
         return _nextID++;
     }
 
+    UInt64 Object3D::nextRenderStateVersion() {
+        static std::atomic<UInt64> nextVersion(1);
+        return nextVersion++;
+    }
+
+    /*
+     * Changes whenever any object is added to or removed from a parent, activated or deactivated, or destroyed,
+     * so structures derived from the shape of a scene (e.g. TransformHierarchy) know when to rebuild.
+     */
+    UInt64 Object3D::getHierarchyVersion() {
+        return _hierarchyVersion;
+    }
+
+    void Object3D::invalidateHierarchy() {
+        _hierarchyVersion++;
+    }
+
     Transform& Object3D::getTransform() {
         return this->transform;
     }
@@ -92,6 +114,7 @@ namespace Core {
 
         this->children.push_back(object);
         object->parent = this->_self;
+        Object3D::invalidateHierarchy();
     }
 
     void Object3D::removeChild(WeakPointer<Object3D> object) {
@@ -109,6 +132,7 @@ namespace Core {
             transform.getLocalMatrix().copy(transform.getWorldMatrix());
             this->children.erase(result.getSrc());
             object->parent = PersistentWeakPointer<Object3D>::nullPtr();
+            Object3D::invalidateHierarchy();
         }
     }
 
@@ -135,42 +159,43 @@ namespace Core {
         this->testAndSetComponentMemberVar<ParticleSystem>(component, this->particleSystem, std::string("particle system"));
 
         if (addedBaseObject3DRenderer) {
-            WeakPointer<MeshRenderer> meshRenderer = WeakPointer<BaseObject3DRenderer>::dynamicPointerCast<MeshRenderer>(this->baseRenderer);
+            WeakPointer<MeshRenderer> meshRenderer = WeakPointer<BaseObject3DRenderer>::dynamicPointerCast<MeshRenderer>(this->baseRenderer.toWeakPointer());
             if (meshRenderer.isValid()) {
                 this->meshRenderer = meshRenderer;
             }
-            WeakPointer<ParticleSystemRenderer> particleSystemRenderer = WeakPointer<BaseObject3DRenderer>::dynamicPointerCast<ParticleSystemRenderer>(this->baseRenderer);
+            WeakPointer<ParticleSystemRenderer> particleSystemRenderer = WeakPointer<BaseObject3DRenderer>::dynamicPointerCast<ParticleSystemRenderer>(this->baseRenderer.toWeakPointer());
             if (particleSystemRenderer.isValid()) {
                 this->particleSystemRenderer = particleSystemRenderer;
             }
         }
 
         if (addedBaseRenderableContainer) {
-            WeakPointer<MeshContainer> meshContainer = WeakPointer<BaseRenderableContainer>::dynamicPointerCast<MeshContainer>(this->baseRenderableContainer);
+            WeakPointer<MeshContainer> meshContainer = WeakPointer<BaseRenderableContainer>::dynamicPointerCast<MeshContainer>(this->baseRenderableContainer.toWeakPointer());
             if (meshContainer.isValid()) {
                 this->meshContainer = meshContainer;
             }
         }
 
         if (addedLight) {
-            WeakPointer<DirectionalLight> directionalLight = WeakPointer<Light>::dynamicPointerCast<DirectionalLight>(this->light);
+            WeakPointer<DirectionalLight> directionalLight = WeakPointer<Light>::dynamicPointerCast<DirectionalLight>(this->light.toWeakPointer());
             if (directionalLight.isValid()) {
                 this->directionalLight = directionalLight;
             }
-            WeakPointer<PointLight> pointLight = WeakPointer<Light>::dynamicPointerCast<PointLight>(this->light);
+            WeakPointer<PointLight> pointLight = WeakPointer<Light>::dynamicPointerCast<PointLight>(this->light.toWeakPointer());
             if (pointLight.isValid()) {
                 this->pointLight = pointLight;
             }
-            WeakPointer<AmbientLight> ambientLight = WeakPointer<Light>::dynamicPointerCast<AmbientLight>(this->light);
+            WeakPointer<AmbientLight> ambientLight = WeakPointer<Light>::dynamicPointerCast<AmbientLight>(this->light.toWeakPointer());
             if (ambientLight.isValid()) {
                 this->ambientLight = ambientLight;
             }
-            WeakPointer<AmbientIBLLight> ambientIBLLight = WeakPointer<Light>::dynamicPointerCast<AmbientIBLLight>(this->light);
+            WeakPointer<AmbientIBLLight> ambientIBLLight = WeakPointer<Light>::dynamicPointerCast<AmbientIBLLight>(this->light.toWeakPointer());
             if (ambientIBLLight.isValid()) {
                 this->ambientIBLLight = ambientIBLLight;
             }
         }
-        
+
+        this->invalidateRenderState();
         return true;
     }
 
@@ -180,9 +205,11 @@ namespace Core {
 
     void Object3D::setLayer(Int32 layer) {
         this->layer = layer;
+        this->invalidateRenderState();
     }
 
     void Object3D::setActive(Bool active) {
+        if (active != this->active) Object3D::invalidateHierarchy();
         this->active = active;
     }
 
@@ -192,12 +219,25 @@ namespace Core {
 
     void Object3D::setStatic(Bool objStatic) {
         this->objStatic = objStatic;
+        this->invalidateRenderState();
     }
 
     Bool Object3D::isStatic() const {
         return this->objStatic;
     }
 
+    UInt64 Object3D::getRenderStateVersion() const {
+        return this->renderStateVersion;
+    }
+
+    /*
+     * Signal that the renderer, renderables, layer or static flag of this object have changed, so any
+     * render items cached for it must be rebuilt.
+     */
+    void Object3D::invalidateRenderState() {
+        this->renderStateVersion = Object3D::nextRenderStateVersion();
+    }
+
     void Object3D::setName(const std::string& name) {
         this->name = name;
     }
@@ -215,54 +255,90 @@ namespace Core {
     }
 
     WeakPointer<BaseObject3DRenderer> Object3D::getBaseRenderer() {
-        return this->baseRenderer;
+        return this->baseRenderer.toWeakPointer();
     }
 
     WeakPointer<MeshRenderer> Object3D::getMeshRenderer() {
-        return this->meshRenderer;
+        return this->meshRenderer.toWeakPointer();
     }
 
     WeakPointer<ParticleSystemRenderer> Object3D::getParticleSystemRenderer() {
-        return this->particleSystemRenderer;
+        return this->particleSystemRenderer.toWeakPointer();
     }
 
     WeakPointer<BaseRenderableContainer> Object3D::getBaseRenderableContainer() {
-        return this->baseRenderableContainer;
+        return this->baseRenderableContainer.toWeakPointer();
     }
 
     WeakPointer<MeshContainer> Object3D::getMeshContainer() {
-        return this->meshContainer;
+        return this->meshContainer.toWeakPointer();
     }
 
     WeakPointer<ParticleSystem> Object3D::getParticleSystem() {
-        return this->particleSystem;
+        return this->particleSystem.toWeakPointer();
     }
 
     WeakPointer<Light> Object3D::getLight() {
-        return this->light;
+        return this->light.toWeakPointer();
     }
 
     WeakPointer<DirectionalLight> Object3D::getDirectionalLight() {
-        return this->directionalLight;
+        return this->directionalLight.toWeakPointer();
     }
 
     WeakPointer<PointLight> Object3D::getPointLight() {
-        return this->pointLight;
+        return this->pointLight.toWeakPointer();
     }
 
     WeakPointer<AmbientLight> Object3D::getAmbientLight() {
-        return this->ambientLight;
+        return this->ambientLight.toWeakPointer();
     }
 
     WeakPointer<AmbientIBLLight> Object3D::getAmbientIBLLight() {
-        return this->ambientIBLLight;
+        return this->ambientIBLLight.toWeakPointer();
     }
 
     WeakPointer<ReflectionProbe> Object3D::getReflectionProbe() {
-        return this->reflectionProbe;
+        return this->reflectionProbe.toWeakPointer();
     }
 
     WeakPointer<Camera> Object3D::getCamera() {
+        return this->camera.toWeakPointer();
+    }
+
+    ObjectHandle<BaseObject3DRenderer> Object3D::getBaseRendererHandle() const {
+        return this->baseRenderer;
+    }
+
+    ObjectHandle<MeshRenderer> Object3D::getMeshRendererHandle() const {
+        return this->meshRenderer;
+    }
+
+    ObjectHandle<ParticleSystemRenderer> Object3D::getParticleSystemRendererHandle() const {
+        return this->particleSystemRenderer;
+    }
+
+    ObjectHandle<BaseRenderableContainer> Object3D::getBaseRenderableContainerHandle() const {
+        return this->baseRenderableContainer;
+    }
+
+    ObjectHandle<MeshContainer> Object3D::getMeshContainerHandle() const {
+        return this->meshContainer;
+    }
+
+    ObjectHandle<Light> Object3D::getLightHandle() const {
+        return this->light;
+    }
+
+    ObjectHandle<ReflectionProbe> Object3D::getReflectionProbeHandle() const {
+        return this->reflectionProbe;
+    }
+
+    ObjectHandle<Camera> Object3D::getCameraHandle() const {
         return this->camera;
     }
+
+    ObjectHandle<ParticleSystem> Object3D::getParticleSystemHandle() const {
+        return this->particleSystem;
+    }
 }
\ No newline at end of file
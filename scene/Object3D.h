@@ -8,6 +8,7 @@
 #include "../common/assert.h"
 #include "../common/complextypes.h"
 #include "../base/CoreObject.h"
+#include "../base/ObjectHandle.h"
 #include "../render/Object3DRenderer.h"
 #include "../util/PersistentWeakPointer.h"
 #include "../util/ValueIterator.h"
@@ -46,6 +47,8 @@ namespace Core {
 
         virtual ~Object3D() override;
 
+        static UInt64 getHierarchyVersion();
+
         UInt64 getID() const;
         Transform& getTransform();
         SceneObjectIterator<Object3D> beginIterateChildren();
@@ -63,6 +66,8 @@ namespace Core {
         Bool isActive() const;
         void setStatic(Bool objStatic);
         Bool isStatic() const;
+        UInt64 getRenderStateVersion() const;
+        void invalidateRenderState();
         void setName(const std::string& name);
         const std::string& getName() const;
         UInt32 childCount();
@@ -86,6 +91,16 @@ namespace Core {
 
         WeakPointer<ParticleSystem> getParticleSystem();
 
+        ObjectHandle<BaseObject3DRenderer> getBaseRendererHandle() const;
+        ObjectHandle<MeshRenderer> getMeshRendererHandle() const;
+        ObjectHandle<ParticleSystemRenderer> getParticleSystemRendererHandle() const;
+        ObjectHandle<BaseRenderableContainer> getBaseRenderableContainerHandle() const;
+        ObjectHandle<MeshContainer> getMeshContainerHandle() const;
+        ObjectHandle<Light> getLightHandle() const;
+        ObjectHandle<ReflectionProbe> getReflectionProbeHandle() const;
+        ObjectHandle<Camera> getCameraHandle() const;
+        ObjectHandle<ParticleSystem> getParticleSystemHandle() const;
+
     protected:
         Object3D();
 
@@ -99,31 +114,36 @@ namespace Core {
         Bool objStatic;
         UInt64 id;
         std::string name;
+        // bumped whenever something that determines this object's render items changes (see PersistentRenderList)
+        UInt64 renderStateVersion;
 
-        WeakPointer<BaseObject3DRenderer> baseRenderer;
-        WeakPointer<MeshRenderer> meshRenderer;
-        WeakPointer<ParticleSystemRenderer> particleSystemRenderer;
+        ObjectHandle<BaseObject3DRenderer> baseRenderer;
+        ObjectHandle<MeshRenderer> meshRenderer;
+        ObjectHandle<ParticleSystemRenderer> particleSystemRenderer;
 
-        WeakPointer<BaseRenderableContainer> baseRenderableContainer;
-        WeakPointer<MeshContainer> meshContainer;
+        ObjectHandle<BaseRenderableContainer> baseRenderableContainer;
+        ObjectHandle<MeshContainer> meshContainer;
 
-        WeakPointer<ReflectionProbe> reflectionProbe;
-        WeakPointer<Camera> camera;
+        ObjectHandle<ReflectionProbe> reflectionProbe;
+        ObjectHandle<Camera> camera;
 
-        WeakPointer<Light> light;
-        WeakPointer<DirectionalLight> directionalLight;
-        WeakPointer<PointLight> pointLight;
-        WeakPointer<AmbientLight> ambientLight;
-        WeakPointer<AmbientIBLLight> ambientIBLLight;
+        ObjectHandle<Light> light;
+        ObjectHandle<DirectionalLight> directionalLight;
+        ObjectHandle<PointLight> pointLight;
+        ObjectHandle<AmbientLight> ambientLight;
+        ObjectHandle<AmbientIBLLight> ambientIBLLight;
 
-        WeakPointer<ParticleSystem> particleSystem;
+        ObjectHandle<ParticleSystem> particleSystem;
 
     private:
         static UInt64 getNextID();
+        static UInt64 nextRenderStateVersion();
+        static void invalidateHierarchy();
         static UInt64 _nextID;
+        static UInt64 _hierarchyVersion;
 
         template <typename T>
-        Bool testAndSetComponentMemberVar(WeakPointer<Object3DComponent> component, WeakPointer<T>& memberVar, const std::string& errComponentName) {
+        Bool testAndSetComponentMemberVar(WeakPointer<Object3DComponent> component, ObjectHandle<T>& memberVar, const std::string& errComponentName) {
             WeakPointer<T> derivedComponent = WeakPointer<Object3DComponent>::dynamicPointerCast<T>(component);
             if (derivedComponent.isValid()) {
                 if(memberVar.isValid()) {
@@ -1,5 +1,420 @@
 #include "Octree.h"
+#include "Object3D.h"
+#include "../geometry/Frustum.h"
+#include "../geometry/Ray.h"
+#include "../geometry/Mesh.h"
+#include "../render/MeshContainer.h"
+#include "../math/Math.h"
 
 namespace Core {
 
+    const UInt32 Octree::DefaultMaxDepth;
+    const UInt32 Octree::MaxSupportedDepth;
+
+    Octree::Octree(const Box3& worldBounds, UInt32 maxDepth) {
+        this->worldBounds = worldBounds;
+        // query() walks the tree with a fixed size stack, which bounds the depth
+        this->maxDepth = Math::min(maxDepth, MaxSupportedDepth);
+        this->syncID = 0;
+        this->syncedObjectCount = 0;
+        this->clear();
+    }
+
+    /*
+     * Add [object] to the octree using the world-space bounds of its meshes. Objects without
+     * usable bounds are still tracked, but are treated as overlapping every query.
+     */
+    Bool Octree::addObject(WeakPointer<Object3D> object) {
+        Box3 bounds;
+        Bool bounded = Octree::calculateObjectWorldBounds(object, bounds);
+        return this->addEntry(object, bounds, bounded);
+    }
+
+    Bool Octree::addObject(WeakPointer<Object3D> object, const Box3& worldBounds) {
+        return this->addEntry(object, worldBounds, true);
+    }
+
+    Bool Octree::updateObject(WeakPointer<Object3D> object) {
+        auto result = this->entryIndexForObject.find(object->getID());
+        if (result == this->entryIndexForObject.end()) return false;
+        this->updateEntry(result->second, object);
+        return true;
+    }
+
+    /*
+     * Move [object] to the node matching [worldBounds]. When the object still belongs in the same
+     * node (the common case for objects that move a little each frame) only the stored bounds change.
+     */
+    Bool Octree::updateObject(WeakPointer<Object3D> object, const Box3& worldBounds) {
+        auto result = this->entryIndexForObject.find(object->getID());
+        if (result == this->entryIndexForObject.end()) return false;
+        this->updateEntry(result->second, worldBounds);
+        return true;
+    }
+
+    Bool Octree::removeObject(WeakPointer<Object3D> object) {
+        auto result = this->entryIndexForObject.find(object->getID());
+        if (result == this->entryIndexForObject.end()) return false;
+        this->freeEntry(result->second);
+        return true;
+    }
+
+    Bool Octree::containsObject(WeakPointer<Object3D> object) const {
+        return this->entryIndexForObject.find(object->getID()) != this->entryIndexForObject.end();
+    }
+
+    /*
+     * Refresh the bounds of every non-static object and drop entries whose objects no longer exist.
+     */
+    void Octree::updateDynamicObjects() {
+        for (UInt32 i = 0; i < this->entries.size(); i++) {
+            Entry& entry = this->entries[i];
+            if (!entry.used) continue;
+
+            if (!entry.object.isValid()) {
+                this->freeEntry(i);
+                continue;
+            }
+
+            WeakPointer<Object3D> object = entry.object;
+            if (!object->isStatic()) this->updateObject(object);
+        }
+    }
+
+    void Octree::clear() {
+        this->nodes.clear();
+        this->entries.clear();
+        this->freeEntries.clear();
+        this->unboundedEntries.clear();
+        this->entryIndexForObject.clear();
+        this->syncedObjectCount = 0;
+
+        const Vector3r& min = this->worldBounds.getMin();
+        const Vector3r& max = this->worldBounds.getMax();
+        Real center[] = {(min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f};
+        Real halfSize = Math::max(Math::max(max.x - min.x, max.y - min.y), max.z - min.z) * 0.5f;
+        this->createNode(center, halfSize, 0);
+    }
+
+    /*
+     * Start a sync pass. Objects not passed to syncObject() before the next call to removeUnsyncedObjects()
+     * are removed by it.
+     */
+    void Octree::beginSync() {
+        this->syncID++;
+        this->syncedObjectCount = 0;
+    }
+
+    /*
+     * Keep [object] in the octree for the current sync pass, adding it if it isn't tracked yet. The bounds of an
+     * object that is already tracked are only recomputed when its world matrix or render state has changed since
+     * they were last computed.
+     */
+    void Octree::syncObject(WeakPointer<Object3D> object) {
+        UInt32 entryIndex;
+        auto result = this->entryIndexForObject.find(object->getID());
+        if (result == this->entryIndexForObject.end()) {
+            this->addObject(object);
+            entryIndex = this->entryIndexForObject[object->getID()];
+        } else {
+            entryIndex = result->second;
+            Entry& entry = this->entries[entryIndex];
+            if (entry.syncID == this->syncID) return;
+            if (entry.worldMatrixVersion != object->getTransform().getWorldMatrixVersion() ||
+                entry.renderStateVersion != object->getRenderStateVersion()) {
+                this->updateEntry(entryIndex, object);
+            }
+        }
+        this->entries[entryIndex].syncID = this->syncID;
+        this->syncedObjectCount++;
+    }
+
+    /*
+     * Remove the objects that were not synced since the last call to beginSync() and return how many were removed.
+     */
+    UInt32 Octree::removeUnsyncedObjects() {
+        if (this->syncedObjectCount == this->getObjectCount()) return 0;
+
+        UInt32 removedCount = 0;
+        for (UInt32 i = 0; i < this->entries.size(); i++) {
+            if (this->entries[i].used && this->entries[i].syncID != this->syncID) {
+                this->freeEntry(i);
+                removedCount++;
+            }
+        }
+        return removedCount;
+    }
+
+    UInt32 Octree::getObjectCount() const {
+        return (UInt32)this->entryIndexForObject.size();
+    }
+
+    UInt32 Octree::getNodeCount() const {
+        return (UInt32)this->nodes.size();
+    }
+
+    const Box3& Octree::getWorldBounds() const {
+        return this->worldBounds;
+    }
+
+    void Octree::queryFrustum(const Frustum& frustum, std::vector<WeakPointer<Object3D>>& outObjects) const {
+        this->query([&frustum](const Box3& box) {
+            return frustum.intersectsBox(box);
+        }, outObjects);
+    }
+
+    void Octree::querySphere(const Point3r& center, Real radius, std::vector<WeakPointer<Object3D>>& outObjects) const {
+        this->query([&center, radius](const Box3& box) {
+            return box.intersectsSphere(center, radius);
+        }, outObjects);
+    }
+
+    void Octree::queryBox(const Box3& queryBox, std::vector<WeakPointer<Object3D>>& outObjects) const {
+        this->query([&queryBox](const Box3& box) {
+            return queryBox.intersectsBox(box);
+        }, outObjects);
+    }
+
+    /*
+     * Collect the objects whose bounds are hit by [ray] within [maxDistance] (measured in units of
+     * the ray's direction vector). Results are not sorted by distance.
+     */
+    void Octree::queryRay(const Ray& ray, Real maxDistance, std::vector<WeakPointer<Object3D>>& outObjects) const {
+        this->query([&ray, maxDistance](const Box3& box) {
+            Real tNear, tFar;
+            return ray.intersectBox(box, tNear, tFar) && tNear <= maxDistance;
+        }, outObjects);
+    }
+
+    void Octree::queryFrustum(const Frustum& frustum, FrameVector<WeakPointer<Object3D>>& outObjects) const {
+        this->query([&frustum](const Box3& box) {
+            return frustum.intersectsBox(box);
+        }, outObjects);
+    }
+
+    void Octree::querySphere(const Point3r& center, Real radius, FrameVector<WeakPointer<Object3D>>& outObjects) const {
+        this->query([&center, radius](const Box3& box) {
+            return box.intersectsSphere(center, radius);
+        }, outObjects);
+    }
+
+    void Octree::queryBox(const Box3& queryBox, FrameVector<WeakPointer<Object3D>>& outObjects) const {
+        this->query([&queryBox](const Box3& box) {
+            return queryBox.intersectsBox(box);
+        }, outObjects);
+    }
+
+    void Octree::queryRay(const Ray& ray, Real maxDistance, FrameVector<WeakPointer<Object3D>>& outObjects) const {
+        this->query([&ray, maxDistance](const Box3& box) {
+            Real tNear, tFar;
+            return ray.intersectBox(box, tNear, tFar) && tNear <= maxDistance;
+        }, outObjects);
+    }
+
+    /*
+     * Compute the union of the world-space bounding boxes of [object]'s meshes. Returns false if the
+     * object has no meshes, if any mesh lacks a calculated bounding box, or if any mesh is skinned
+     * (its bind-pose bounds don't reflect the animated pose).
+     */
+    Bool Octree::calculateObjectWorldBounds(WeakPointer<Object3D> object, Box3& outBounds) {
+        WeakPointer<MeshContainer> meshContainer = object->getMeshContainer();
+        if (!meshContainer.isValid()) return false;
+
+        UInt32 meshCount = meshContainer->getBaseRenderableCount();
+        if (meshCount == 0) return false;
+
+        const Matrix4x4& worldMatrix = object->getTransform().getConstWorldMatrix();
+        Box3 meshBounds;
+        for (UInt32 i = 0; i < meshCount; i++) {
+            WeakPointer<Mesh> mesh = meshContainer->getRenderable(i);
+            if (!mesh->hasBoundingBox()) return false;
+            if (meshContainer->hasVertexBoneMap(mesh->getObjectID())) return false;
+            mesh->getBoundingBox().transform(worldMatrix, meshBounds);
+            if (i == 0) outBounds = meshBounds;
+            else outBounds.expandByBox(meshBounds);
+        }
+        return true;
+    }
+
+    Bool Octree::addEntry(WeakPointer<Object3D> object, const Box3& worldBounds, Bool bounded) {
+        if (this->containsObject(object)) return false;
+
+        UInt32 entryIndex = this->allocateEntry();
+        Entry& entry = this->entries[entryIndex];
+        entry.object = object;
+        entry.objectID = object->getID();
+        entry.bounds = worldBounds;
+        entry.worldMatrixVersion = object->getTransform().getWorldMatrixVersion();
+        entry.renderStateVersion = object->getRenderStateVersion();
+        entry.syncID = 0;
+        entry.bounded = bounded;
+        entry.used = true;
+        this->insertEntry(entryIndex);
+        this->entryIndexForObject[entry.objectID] = entryIndex;
+        return true;
+    }
+
+    /*
+     * Recompute the bounds of the object held by entry [entryIndex] and move it to the matching node.
+     */
+    void Octree::updateEntry(UInt32 entryIndex, WeakPointer<Object3D> object) {
+        Entry& entry = this->entries[entryIndex];
+        entry.worldMatrixVersion = object->getTransform().getWorldMatrixVersion();
+        entry.renderStateVersion = object->getRenderStateVersion();
+
+        Box3 bounds;
+        Bool bounded = Octree::calculateObjectWorldBounds(object, bounds);
+        if (!bounded) {
+            if (entry.bounded) {
+                this->detachEntry(entryIndex);
+                this->entries[entryIndex].bounded = false;
+                this->insertEntry(entryIndex);
+            }
+            return;
+        }
+        this->updateEntry(entryIndex, bounds);
+    }
+
+    void Octree::updateEntry(UInt32 entryIndex, const Box3& worldBounds) {
+        Entry& entry = this->entries[entryIndex];
+        entry.bounds = worldBounds;
+        if (entry.bounded) {
+            UInt32 targetNode = this->findNodeForBounds(worldBounds);
+            if (targetNode == this->entries[entryIndex].node) return;
+        }
+
+        this->detachEntry(entryIndex);
+        this->entries[entryIndex].bounded = true;
+        this->insertEntry(entryIndex);
+    }
+
+    void Octree::freeEntry(UInt32 entryIndex) {
+        this->detachEntry(entryIndex);
+        Entry& entry = this->entries[entryIndex];
+        this->entryIndexForObject.erase(entry.objectID);
+        entry.object = PersistentWeakPointer<Object3D>::nullPtr();
+        entry.used = false;
+        this->freeEntries.push_back(entryIndex);
+    }
+
+    UInt32 Octree::createNode(const Real* center, Real halfSize, UInt32 depth) {
+        this->nodes.emplace_back();
+        Node& node = this->nodes.back();
+        node.center[0] = center[0];
+        node.center[1] = center[1];
+        node.center[2] = center[2];
+        node.halfSize = halfSize;
+        node.depth = depth;
+        Real looseSize = halfSize * 2.0f;
+        node.looseBounds.setMin(center[0] - looseSize, center[1] - looseSize, center[2] - looseSize);
+        node.looseBounds.setMax(center[0] + looseSize, center[1] + looseSize, center[2] + looseSize);
+        for (UInt32 i = 0; i < 8; i++) node.children[i] = InvalidIndex;
+        return (UInt32)this->nodes.size() - 1;
+    }
+
+    /*
+     * Descend from the root towards the deepest node that can hold [bounds], creating nodes on the way.
+     */
+    UInt32 Octree::findNodeForBounds(const Box3& bounds) {
+        const Vector3r& min = bounds.getMin();
+        const Vector3r& max = bounds.getMax();
+        Real center[] = {(min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f};
+        Real extent = Math::max(Math::max(max.x - min.x, max.y - min.y), max.z - min.z) * 0.5f;
+
+        UInt32 nodeIndex = 0;
+        while (true) {
+            Node& node = this->nodes[nodeIndex];
+            Real childHalfSize = node.halfSize * 0.5f;
+            if (node.depth >= this->maxDepth || extent > childHalfSize) break;
+
+            UInt32 octant = 0;
+            Real childCenter[3];
+            for (UInt32 axis = 0; axis < 3; axis++) {
+                Real offset = center[axis] - node.center[axis];
+                if (Math::abs(offset) > node.halfSize) return nodeIndex;
+                if (offset >= 0.0f) {
+                    octant |= 1 << axis;
+                    childCenter[axis] = node.center[axis] + childHalfSize;
+                } else {
+                    childCenter[axis] = node.center[axis] - childHalfSize;
+                }
+            }
+
+            UInt32 childIndex = node.children[octant];
+            if (childIndex == InvalidIndex) {
+                UInt32 childDepth = node.depth + 1;
+                // createNode() may reallocate the node list, invalidating [node]
+                childIndex = this->createNode(childCenter, childHalfSize, childDepth);
+                this->nodes[nodeIndex].children[octant] = childIndex;
+            }
+            nodeIndex = childIndex;
+        }
+        return nodeIndex;
+    }
+
+    void Octree::insertEntry(UInt32 entryIndex) {
+        Entry& entry = this->entries[entryIndex];
+        if (!entry.bounded) {
+            entry.node = InvalidIndex;
+            entry.nodeSlot = (UInt32)this->unboundedEntries.size();
+            this->unboundedEntries.push_back(entryIndex);
+            return;
+        }
+
+        UInt32 nodeIndex = this->findNodeForBounds(entry.bounds);
+        std::vector<UInt32>& nodeEntries = this->nodes[nodeIndex].entries;
+        entry.node = nodeIndex;
+        entry.nodeSlot = (UInt32)nodeEntries.size();
+        nodeEntries.push_back(entryIndex);
+    }
+
+    void Octree::detachEntry(UInt32 entryIndex) {
+        Entry& entry = this->entries[entryIndex];
+        std::vector<UInt32>& list = entry.bounded ? this->nodes[entry.node].entries : this->unboundedEntries;
+        UInt32 lastEntryIndex = list.back();
+        list[entry.nodeSlot] = lastEntryIndex;
+        this->entries[lastEntryIndex].nodeSlot = entry.nodeSlot;
+        list.pop_back();
+        entry.node = InvalidIndex;
+    }
+
+    UInt32 Octree::allocateEntry() {
+        if (this->freeEntries.size() > 0) {
+            UInt32 entryIndex = this->freeEntries.back();
+            this->freeEntries.pop_back();
+            return entryIndex;
+        }
+        this->entries.emplace_back();
+        return (UInt32)this->entries.size() - 1;
+    }
+
+    template <typename OverlapTest, typename ObjectList>
+    void Octree::query(OverlapTest overlaps, ObjectList& outObjects) const {
+        for (UInt32 entryIndex : this->unboundedEntries) {
+            const Entry& entry = this->entries[entryIndex];
+            if (entry.object.isValid()) outObjects.push_back(entry.object);
+        }
+
+        // each visited node replaces itself with at most 8 children, so a depth first walk never holds more
+        // than 7 nodes per level plus one; the root node is always visited since it also holds objects that
+        // lie outside the root cell
+        UInt32 nodeStack[MaxSupportedDepth * 7 + 1];
+        UInt32 stackSize = 0;
+        nodeStack[stackSize++] = 0;
+        while (stackSize > 0) {
+            const Node& node = this->nodes[nodeStack[--stackSize]];
+
+            for (UInt32 entryIndex : node.entries) {
+                const Entry& entry = this->entries[entryIndex];
+                if (entry.object.isValid() && overlaps(entry.bounds)) outObjects.push_back(entry.object);
+            }
+
+            for (UInt32 i = 0; i < 8; i++) {
+                UInt32 childIndex = node.children[i];
+                if (childIndex != InvalidIndex && overlaps(this->nodes[childIndex].looseBounds)) {
+                    nodeStack[stackSize++] = childIndex;
+                }
+            }
+        }
+    }
 }
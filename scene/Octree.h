@@ -1,93 +1,121 @@
 #pragma once
 
-#include <memory>
 #include <vector>
+#include <unordered_map>
+
 #include "../common/types.h"
 #include "../geometry/Box3.h"
-#include "../geometry/Mesh.h"
 #include "../geometry/Vector3.h"
-#include "Object3D.h"
+#include "../util/PersistentWeakPointer.h"
+#include "../util/FrameArena.h"
 
 namespace Core {
 
+    // forward declarations
+    class Object3D;
+    class Frustum;
+    class Ray;
+
+    /*
+     * Loose octree over the world-space bounds of scene objects. Each object is stored in exactly one
+     * node: the deepest node whose tight cell contains the center of the object's bounds and whose
+     * cell is at least as large as the object. Since a node's loose bounds are twice the size of its
+     * tight cell, an object stored in a node is always fully enclosed by that node's loose bounds, so
+     * queries only need to descend into nodes whose loose bounds overlap the query volume.
+     *
+     * Objects that fall outside the root cell are kept in the root node and objects whose bounds cannot
+     * be determined (no mesh bounds, or skinned meshes) are kept in a separate unbounded list that is
+     * returned by every query.
+     *
+     * An octree that mirrors a scene can be kept up to date with a sync pass: beginSync(), then syncObject()
+     * for every object that should be in the tree, then removeUnsyncedObjects(). Only objects whose world
+     * matrix or render state changed since the previous pass have their bounds recomputed.
+     */
     class Octree {
-        class OctreeNode : public Object3D {
-        public:
-            static const UInt32 MaxLevel = 8;
+    public:
+
+        static const UInt32 DefaultMaxDepth = 8;
+        static const UInt32 MaxSupportedDepth = 16;
+
+        Octree(const Box3& worldBounds, UInt32 maxDepth = DefaultMaxDepth);
+
+        Bool addObject(WeakPointer<Object3D> object);
+        Bool addObject(WeakPointer<Object3D> object, const Box3& worldBounds);
+        Bool updateObject(WeakPointer<Object3D> object);
+        Bool updateObject(WeakPointer<Object3D> object, const Box3& worldBounds);
+        Bool removeObject(WeakPointer<Object3D> object);
+        Bool containsObject(WeakPointer<Object3D> object) const;
+        void updateDynamicObjects();
+        void clear();
+
+        void beginSync();
+        void syncObject(WeakPointer<Object3D> object);
+        UInt32 removeUnsyncedObjects();
+
+        UInt32 getObjectCount() const;
+        UInt32 getNodeCount() const;
+        const Box3& getWorldBounds() const;
 
-            OctreeNode(const Box3& bounds, UInt32 level) {
-                this->level = level;
-                this->bounds = bounds;
-            }
+        void queryFrustum(const Frustum& frustum, std::vector<WeakPointer<Object3D>>& outObjects) const;
+        void querySphere(const Point3r& center, Real radius, std::vector<WeakPointer<Object3D>>& outObjects) const;
+        void queryBox(const Box3& box, std::vector<WeakPointer<Object3D>>& outObjects) const;
+        void queryRay(const Ray& ray, Real maxDistance, std::vector<WeakPointer<Object3D>>& outObjects) const;
+        void queryFrustum(const Frustum& frustum, FrameVector<WeakPointer<Object3D>>& outObjects) const;
+        void querySphere(const Point3r& center, Real radius, FrameVector<WeakPointer<Object3D>>& outObjects) const;
+        void queryBox(const Box3& box, FrameVector<WeakPointer<Object3D>>& outObjects) const;
+        void queryRay(const Ray& ray, Real maxDistance, FrameVector<WeakPointer<Object3D>>& outObjects) const;
 
-        private:
+        static Bool calculateObjectWorldBounds(WeakPointer<Object3D> object, Box3& outBounds);
+
+    private:
+
+        static const UInt32 InvalidIndex = 0xFFFFFFFF;
+
+        class Node {
+        public:
+            Real center[3];
+            Real halfSize;
+            Box3 looseBounds;
+            UInt32 depth;
+            UInt32 children[8];
+            std::vector<UInt32> entries;
+        };
+
+        class Entry {
+        public:
+            PersistentWeakPointer<Object3D> object;
+            UInt64 objectID;
             Box3 bounds;
-            std::vector<std::shared_ptr<OctreeNode>> childNodes;
-            UInt32 level;
-
-            void buildChildNodes() {
-                const Vector3r& min = this->bounds.getMin();
-                const Vector3r& max = this->bounds.getMax();
-
-                Vector3r bounds = max - min;
-                Vector3r halfBounds = bounds * 0.5;
-
-                for (UInt32 y = 0; y < 2; y++) {
-                    for (UInt32 z = 0; z < 2; z++) {
-                        for (UInt32 x = 0; x < 2; x++) {
-                            Real minX = min.x + halfBounds.x * x;
-                            Real maxX = minX + halfBounds.x;
-
-                            Real minY = min.y + halfBounds.y * y;
-                            Real maxY = minY + halfBounds.y;
-
-                            Real minZ = min.z + halfBounds.z * z;
-                            Real maxZ = minZ + halfBounds.z;
-
-                            Vector3r newMin(minX, minY, minZ);
-                            Vector3r newMax(maxX, maxY, maxZ);
-                            Box3 childBounds(newMin, newMax);
-
-                            // std::shared_ptr<OctreeNode> newNode = std::make_shared<OctreeNode>(childBounds, this->level + 1);
-                            // this->childNodes.push_back(newNode);
-                            // this->addChild(newNode);
-                        }
-                    }
-                }
-            }
-
-            void addMesh(std::shared_ptr<Mesh> mesh) {
-                Bool meshAdded = false;
-
-                if (this->level < OctreeNode::MaxLevel) {
-                    if (this->childNodes.size() == 0) {
-                        this->buildChildNodes();
-                    }
-
-                    for (auto childNode : this->childNodes) {
-                        if (childNode->bounds.containsBox(mesh->getBoundingBox())) {
-                            meshAdded = true;
-                            childNode->addMesh(mesh);
-                        }
-                    }
-                }
-
-                if (!meshAdded) {
-                    // this->addObject(mesh);
-                }
-            }
+            UInt32 node;
+            UInt32 nodeSlot;
+            UInt64 worldMatrixVersion;
+            UInt64 renderStateVersion;
+            UInt64 syncID;
+            Bool bounded;
+            Bool used;
         };
 
-    public:
-        /*
-
-        public addMeshes(obj: Object3D) {
-              if (obj instanceof Mesh) {
-                this.addMesh(<Mesh> obj);
-              }
-              for (const child of obj.children) {
-                this.addMeshes(child);
-              }
-          }*/
+        Bool addEntry(WeakPointer<Object3D> object, const Box3& worldBounds, Bool bounded);
+        void updateEntry(UInt32 entryIndex, WeakPointer<Object3D> object);
+        void updateEntry(UInt32 entryIndex, const Box3& worldBounds);
+        void freeEntry(UInt32 entryIndex);
+        UInt32 createNode(const Real* center, Real halfSize, UInt32 depth);
+        UInt32 findNodeForBounds(const Box3& bounds);
+        void insertEntry(UInt32 entryIndex);
+        void detachEntry(UInt32 entryIndex);
+        UInt32 allocateEntry();
+
+        template <typename OverlapTest, typename ObjectList>
+        void query(OverlapTest overlaps, ObjectList& outObjects) const;
+
+        Box3 worldBounds;
+        UInt32 maxDepth;
+        std::vector<Node> nodes;
+        std::vector<Entry> entries;
+        std::vector<UInt32> freeEntries;
+        std::vector<UInt32> unboundedEntries;
+        std::unordered_map<UInt64, UInt32> entryIndexForObject;
+        UInt64 syncID;
+        UInt32 syncedObjectCount;
     };
 }
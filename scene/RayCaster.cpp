@@ -1,42 +1,64 @@
 #include <algorithm>
 #include <functional>
+#include <limits>
 
 #include "RayCaster.h"
 #include "../geometry/Mesh.h"
+#include "../geometry/MeshBVH.h"
 
 namespace Core {
 
+    RayCaster::RayCaster(): octreeDirty(true) {
+    }
+
     UInt32 RayCaster::addObject(WeakPointer<Object3D> sceneObject, WeakPointer<Mesh> mesh) {
-        UInt32 id = this->objects.size();
-        this->objects.push_back(sceneObject);
-        this->meshes.push_back(mesh);
+        UInt32 id = this->targets.size();
+        this->targets.emplace_back();
+        Target& target = this->targets.back();
+        target.object = sceneObject;
+        target.mesh = mesh;
+
+        std::vector<UInt32>& objectTargets = this->targetsForObject[sceneObject->getID()];
+        if (objectTargets.size() == 0) this->objects.push_back(sceneObject);
+        objectTargets.push_back(id);
+
+        this->octreeDirty = true;
         return id;
     }
 
-    Bool RayCaster::castRay(const Ray& ray, std::vector<Hit>& hits) {
-        if (this->objects.size() != this->meshes.size()) {
-            throw Exception("RayCaster::castRay() -> 'meshes' and 'objects' have different sizes.");
-        }
+    /*
+     * Force the top-level octree and all cached world transforms to be rebuilt on the next cast.
+     */
+    void RayCaster::invalidate() {
+        this->octreeDirty = true;
+    }
 
-        Bool hitFound = false;
-        for (UInt32 i = 0; i < this->objects.size(); i++) {
-            WeakPointer<Object3D> object = this->objects[i];
-            if (object->isActive()) {
-                WeakPointer<Mesh> mesh = this->meshes[i];
-                Transform objTransform = object->getTransform();
-                objTransform.updateWorldMatrix();
-                Matrix4x4& transform = objTransform.getWorldMatrix();
-                hitFound = this->castRay(ray, mesh, transform, hits, i) || hitFound;
-            }
-        }
+    /*
+     * Cast [ray] against all registered objects and store every hit in [hits], sorted by distance.
+     */
+    Bool RayCaster::castRay(const Ray& ray, std::vector<Hit>& hits) {
+        this->prepare();
+        Bool hitFound = this->castRayAgainstTargets(ray, false, hits);
 
         std::sort(hits.begin(), hits.end(), [](const Hit& a, const Hit& b){
-            return a.Distance <= b.Distance;
+            return a.Distance < b.Distance;
         });
 
         return hitFound;
     }
 
+    /*
+     * Cast [ray] against all registered objects, only reporting the closest hit. Triangle BVH traversal
+     * stops descending into any subtree that lies beyond the closest hit found so far.
+     */
+    Bool RayCaster::castRay(const Ray& ray, Hit& closestHit) {
+        this->prepare();
+        this->closestHitScratch.clear();
+        if (!this->castRayAgainstTargets(ray, true, this->closestHitScratch)) return false;
+        closestHit = this->closestHitScratch[0];
+        return true;
+    }
+
     Bool RayCaster::castRay(const Ray& ray, WeakPointer<Mesh> mesh, const Matrix4x4& transform, std::vector<Hit>& hits, Int32 hitID) {
         Matrix4x4 inverse = transform;
         inverse.invert();
@@ -47,22 +69,165 @@ namespace Core {
         inverse.transform(localRay.Origin);
         inverse.transform(localRay.Direction);
 
-        Hit bbHit;
-        Bool bbIntersect = localRay.intersectBox(mesh->getBoundingBox(), bbHit);
         UInt32 startIndex = hits.size();
-        if (bbIntersect) {
-            localRay.intersectMesh(mesh, hits);
-        }
+        if (!mesh->getBVH()->intersectRay(localRay, false, std::numeric_limits<Real>::max(), hits)) return false;
 
+        Real rayLength = ray.Direction.magnitude();
         for(UInt32 i = startIndex; i < hits.size(); i++) {
             Hit& hit = hits[i];
             transform.transform(hit.Origin);
             inverseTranspose.transform(hit.Normal);
-            Vector3r distanceVec = hit.Origin - ray.Origin;
-            hit.Distance = distanceVec.magnitude();
+            hit.Distance = hit.Distance * rayLength;
+            hit.Object = mesh;
             hit.ID = hitID;
         }
 
-        return hits.size() > 0;
+        return true;
+    }
+
+    /*
+     * Cast a batch of rays in closest-hit mode. Transforms and the top-level octree are refreshed once for
+     * the whole batch. [closestHits] is resized to match [rays]; entries for rays that hit nothing have an ID of -1.
+     * Returns the number of rays that hit something.
+     */
+    UInt32 RayCaster::castRays(const std::vector<Ray>& rays, std::vector<Hit>& closestHits) {
+        this->prepare();
+        closestHits.resize(rays.size());
+
+        UInt32 hitCount = 0;
+        for (UInt32 i = 0; i < rays.size(); i++) {
+            this->closestHitScratch.clear();
+            if (this->castRayAgainstTargets(rays[i], true, this->closestHitScratch)) {
+                closestHits[i] = this->closestHitScratch[0];
+                hitCount++;
+            } else {
+                closestHits[i].Object = PersistentWeakPointer<Mesh>::nullPtr();
+                closestHits[i].ID = -1;
+            }
+        }
+        return hitCount;
+    }
+
+    /*
+     * Bring cached transforms and the top-level octree up to date. After registration changes (or a call to
+     * invalidate()) everything is rebuilt; otherwise only non-static objects are refreshed.
+     */
+    void RayCaster::prepare() {
+        Box3 objectBounds;
+        if (!this->octreeDirty) {
+            for (UInt32 i = 0; i < this->dynamicObjects.size(); i++) {
+                WeakPointer<Object3D> object = this->dynamicObjects[i];
+                if (!object.isValid()) continue;
+                const std::vector<UInt32>& objectTargets = this->targetsForObject[object->getID()];
+                for (UInt32 targetIndex : objectTargets) this->updateTargetTransforms(this->targets[targetIndex]);
+                if (this->calculateObjectBounds(objectTargets, objectBounds)) this->octree->updateObject(object, objectBounds);
+            }
+            return;
+        }
+
+        Box3 sceneBounds;
+        std::vector<Box3> allObjectBounds(this->objects.size());
+        std::vector<Bool> objectHasBounds(this->objects.size(), false);
+        Bool sceneBoundsSet = false;
+        this->dynamicObjects.clear();
+        for (UInt32 i = 0; i < this->objects.size(); i++) {
+            WeakPointer<Object3D> object = this->objects[i];
+            if (!object.isValid()) continue;
+            if (!object->isStatic()) this->dynamicObjects.push_back(object);
+
+            const std::vector<UInt32>& objectTargets = this->targetsForObject[object->getID()];
+            for (UInt32 targetIndex : objectTargets) this->updateTargetTransforms(this->targets[targetIndex]);
+            objectHasBounds[i] = this->calculateObjectBounds(objectTargets, allObjectBounds[i]);
+            if (objectHasBounds[i]) {
+                if (!sceneBoundsSet) sceneBounds = allObjectBounds[i];
+                else sceneBounds.expandByBox(allObjectBounds[i]);
+                sceneBoundsSet = true;
+            }
+        }
+
+        this->octree = std::unique_ptr<Octree>(new Octree(sceneBounds));
+        for (UInt32 i = 0; i < this->objects.size(); i++) {
+            if (objectHasBounds[i]) this->octree->addObject(this->objects[i], allObjectBounds[i]);
+        }
+        this->octreeDirty = false;
+    }
+
+    void RayCaster::updateTargetTransforms(Target& target) {
+        target.object->getTransform().calculateWorldMatrix(target.worldMatrix);
+        target.inverseWorldMatrix = target.worldMatrix;
+        target.inverseWorldMatrix.invert();
+        target.inverseTransposeWorldMatrix = target.inverseWorldMatrix;
+        target.inverseTransposeWorldMatrix.transpose();
+    }
+
+    Bool RayCaster::calculateObjectBounds(const std::vector<UInt32>& targetIndices, Box3& outBounds) {
+        Bool boundsSet = false;
+        Box3 targetBounds;
+        for (UInt32 targetIndex : targetIndices) {
+            Target& target = this->targets[targetIndex];
+            WeakPointer<MeshBVH> bvh = target.mesh->getBVH();
+            if (bvh->isEmpty()) continue;
+            bvh->getBounds().transform(target.worldMatrix, targetBounds);
+            if (!boundsSet) outBounds = targetBounds;
+            else outBounds.expandByBox(targetBounds);
+            boundsSet = true;
+        }
+        return boundsSet;
+    }
+
+    Bool RayCaster::castRayAgainstTargets(const Ray& ray, Bool closestHitOnly, std::vector<Hit>& hits) {
+        this->candidateObjects.clear();
+        this->octree->queryRay(ray, std::numeric_limits<Real>::max(), this->candidateObjects);
+
+        Real rayLength = ray.Direction.magnitude();
+        Real maxDistance = std::numeric_limits<Real>::max();
+        UInt32 startIndex = hits.size();
+        Bool hitFound = false;
+        for (UInt32 i = 0; i < this->candidateObjects.size(); i++) {
+            WeakPointer<Object3D> object = this->candidateObjects[i];
+            if (!object->isActive()) continue;
+
+            const std::vector<UInt32>& objectTargets = this->targetsForObject[object->getID()];
+            for (UInt32 targetIndex : objectTargets) {
+                if (!this->castRayAgainstTarget(ray, targetIndex, closestHitOnly, maxDistance, hits)) continue;
+                hitFound = true;
+                if (closestHitOnly) {
+                    // anything reported here is closer than every earlier hit
+                    if (hits.size() > startIndex + 1) {
+                        hits[startIndex] = hits.back();
+                        hits.resize(startIndex + 1);
+                    }
+                    maxDistance = hits[startIndex].Distance / rayLength;
+                }
+            }
+        }
+        return hitFound;
+    }
+
+    /*
+     * Intersect [ray] with a single target's triangle BVH. [maxDistance] is expressed in units of the ray's
+     * direction vector, which stay the same in the target's local space since the transform is affine.
+     */
+    Bool RayCaster::castRayAgainstTarget(const Ray& ray, UInt32 targetIndex, Bool closestHitOnly, Real maxDistance, std::vector<Hit>& hits) {
+        Target& target = this->targets[targetIndex];
+
+        Ray localRay(ray.Origin, ray.Direction);
+        target.inverseWorldMatrix.transform(localRay.Origin);
+        target.inverseWorldMatrix.transform(localRay.Direction);
+
+        UInt32 startIndex = hits.size();
+        if (!target.mesh->getBVH()->intersectRay(localRay, closestHitOnly, maxDistance, hits)) return false;
+
+        Real rayLength = ray.Direction.magnitude();
+        for(UInt32 i = startIndex; i < hits.size(); i++) {
+            Hit& hit = hits[i];
+            target.worldMatrix.transform(hit.Origin);
+            target.inverseTransposeWorldMatrix.transform(hit.Normal);
+            hit.Distance = hit.Distance * rayLength;
+            hit.Object = target.mesh;
+            hit.ID = targetIndex;
+        }
+
+        return true;
     }
-}
\ No newline at end of file
+}
@@ -1,23 +1,60 @@
 #pragma once
 
+#include <memory>
 #include <vector>
+#include <unordered_map>
 
 #include "../geometry/Ray.h"
 #include "../geometry/Hit.h"
 #include "../scene/Object3D.h"
+#include "../scene/Octree.h"
 #include "../util/PersistentWeakPointer.h"
 #include "../render/RenderableContainer.h"
 
 namespace Core {
 
+    /*
+     * Casts rays against registered (object, mesh) pairs. Objects are indexed by a top-level Octree over their
+     * world bounds and each mesh is tested through its cached triangle BVH (see Mesh::getBVH()). World transforms
+     * of static objects are cached when the octree is built; call invalidate() after moving a static object.
+     * Transforms of non-static objects are refreshed once per castRay()/castRays() call.
+     */
     class RayCaster {
     public:
+        RayCaster();
+
         UInt32 addObject(WeakPointer<Object3D> sceneObject, WeakPointer<Mesh> mesh);
+        void invalidate();
+
         Bool castRay(const Ray& ray, std::vector<Hit>& hits);
+        Bool castRay(const Ray& ray, Hit& closestHit);
         Bool castRay(const Ray& ray, WeakPointer<Mesh> mesh, const Matrix4x4& transform, std::vector<Hit>& hits, Int32 hitID = -1);
+        UInt32 castRays(const std::vector<Ray>& rays, std::vector<Hit>& closestHits);
 
     private:
+
+        class Target {
+        public:
+            PersistentWeakPointer<Object3D> object;
+            PersistentWeakPointer<Mesh> mesh;
+            Matrix4x4 worldMatrix;
+            Matrix4x4 inverseWorldMatrix;
+            Matrix4x4 inverseTransposeWorldMatrix;
+        };
+
+        void prepare();
+        void updateTargetTransforms(Target& target);
+        Bool calculateObjectBounds(const std::vector<UInt32>& targetIndices, Box3& outBounds);
+        Bool castRayAgainstTargets(const Ray& ray, Bool closestHitOnly, std::vector<Hit>& hits);
+        Bool castRayAgainstTarget(const Ray& ray, UInt32 targetIndex, Bool closestHitOnly, Real maxDistance, std::vector<Hit>& hits);
+
+        std::vector<Target> targets;
+        std::unordered_map<UInt64, std::vector<UInt32>> targetsForObject;
         std::vector<PersistentWeakPointer<Object3D>> objects;
-        std::vector<PersistentWeakPointer<Mesh>> meshes;
+        std::vector<PersistentWeakPointer<Object3D>> dynamicObjects;
+        std::unique_ptr<Octree> octree;
+        Bool octreeDirty;
+        std::vector<WeakPointer<Object3D>> candidateObjects;
+        std::vector<Hit> closestHitScratch;
     };
-}
\ No newline at end of file
+}
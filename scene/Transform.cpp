@@ -3,20 +3,34 @@
 
 namespace Core {
 
+    const UInt64 Transform::UntrackedParentVersion;
+    const UInt64 Transform::IdentityParentVersion;
+
     Transform::Transform(const Object3D& target) : target(target) {
         this->localMatrix.setIdentity();
         this->worldMatrix.setIdentity();
         this->matrixAutoUpdate = true;
+        this->localMatrixDirty = true;
+        this->worldMatrixVersion = Transform::nextWorldMatrixVersion();
+        this->parentWorldMatrixVersion = UntrackedParentVersion;
     }
 
     Transform::Transform(const Object3D& target, const Matrix4x4& matrix) : target(target) {
         this->localMatrix.copy(matrix);
+        this->localMatrixDirty = true;
+        this->worldMatrixVersion = Transform::nextWorldMatrixVersion();
+        this->parentWorldMatrixVersion = UntrackedParentVersion;
     }
 
     Transform::~Transform() {
     }
 
+    /*
+     * The caller may modify the returned matrix, so this marks the local matrix as dirty. Use
+     * getConstLocalMatrix() for read-only access.
+     */
     Matrix4x4& Transform::getLocalMatrix() {
+        this->localMatrixDirty = true;
         return this->localMatrix;
     }
 
@@ -51,6 +65,7 @@ namespace Core {
     }
 
     void Transform::setLocalMatrix(const Matrix4x4& mat) {
+        this->localMatrixDirty = true;
         this->localMatrix.copy(mat);
     }
 
@@ -67,10 +82,10 @@ namespace Core {
     void Transform::calculateWorldMatrix(WeakPointer<Object3D> target, Matrix4x4& result) {
         result.setIdentity();
         if (!target.isValid()) return;
-        result.copy(target->getTransform().getLocalMatrix());
+        result.copy(target->getTransform().getConstLocalMatrix());
         WeakPointer<Object3D> parent = target->getParent();
         while (parent.isValid()) {
-            result.preMultiply(parent->getTransform().getLocalMatrix());
+            result.preMultiply(parent->getTransform().getConstLocalMatrix());
             parent = parent->getParent();
         }
     }
@@ -85,9 +100,54 @@ namespace Core {
     }
 
     void Transform::setMatrixAutoUpdate(Bool matrixAutoUpdate) {
+        if (matrixAutoUpdate && !this->matrixAutoUpdate) this->localMatrixDirty = true;
         this->matrixAutoUpdate = matrixAutoUpdate;
     }
 
+    Bool Transform::isLocalMatrixDirty() const {
+        return this->localMatrixDirty;
+    }
+
+    UInt64 Transform::getWorldMatrixVersion() const {
+        return this->worldMatrixVersion;
+    }
+
+    /*
+     * Hierarchical world matrix update: set the world matrix to [parentWorldMatrix] * local matrix, but only if the local
+     * matrix is dirty or the parent's world matrix has changed since the last update (as indicated by [parentWorldMatrixVersion]).
+     * Returns true if the world matrix was recomputed. A transform that doesn't auto-update has its world matrix managed
+     * externally, so it is left alone but always reported to its children as changed.
+     */
+    Bool Transform::updateWorldMatrixFromParent(const Matrix4x4& parentWorldMatrix, UInt64 parentWorldMatrixVersion) {
+        if (!this->matrixAutoUpdate) {
+            this->worldMatrixVersion = Transform::nextWorldMatrixVersion();
+            return false;
+        }
+
+        if (!this->needsWorldMatrixUpdate(parentWorldMatrixVersion)) return false;
+
+        this->worldMatrix.copy(parentWorldMatrix);
+        this->worldMatrix.multiply(this->localMatrix);
+        this->localMatrixDirty = false;
+        this->parentWorldMatrixVersion = parentWorldMatrixVersion;
+        this->worldMatrixVersion = Transform::nextWorldMatrixVersion();
+        return true;
+    }
+
+    /*
+     * Does the world matrix need to be derived again, given the current version of the parent's world matrix?
+     */
+    Bool Transform::needsWorldMatrixUpdate(UInt64 parentWorldMatrixVersion) const {
+        if (!this->matrixAutoUpdate) return false;
+        return this->localMatrixDirty || parentWorldMatrixVersion == UntrackedParentVersion ||
+               parentWorldMatrixVersion != this->parentWorldMatrixVersion;
+    }
+
+    UInt64 Transform::nextWorldMatrixVersion() {
+        static std::atomic<UInt64> nextVersion(IdentityParentVersion + 1);
+        return nextVersion++;
+    }
+
     void Transform::getAncestorWorldMatrix(Matrix4x4& result) {
         Transform::calculateWorldMatrix(this->target.getParent(), result);
     }
@@ -169,6 +229,7 @@ namespace Core {
     }
 
     void Transform::transformBy(const Matrix4x4& mat, TransformationSpace transformationSpace) {
+        this->localMatrixDirty = true;
         if (transformationSpace == TransformationSpace::Local) {
             this->localMatrix.multiply(mat);
         }
@@ -187,6 +248,7 @@ namespace Core {
     }
 
     void Transform::translate(Real x, Real y, Real z, TransformationSpace transformationSpace) {
+        this->localMatrixDirty = true;
         if (transformationSpace == TransformationSpace::Local) {
             this->localMatrix.translate(x, y, z);
         }
@@ -204,6 +266,7 @@ namespace Core {
     }
 
     void Transform::setLocalPosition(Real x, Real y, Real z) {
+        this->localMatrixDirty = true;
         this->localMatrix.setTranslation(x, y, z);
     }
 
@@ -222,6 +285,7 @@ namespace Core {
     }
 
     void Transform::rotate(Real x, Real y, Real z, Real angle, TransformationSpace transformationSpace) {
+        this->localMatrixDirty = true;
         if (transformationSpace == TransformationSpace::Local) {
             this->localMatrix.rotate(x, y, z, angle);
         }
@@ -242,6 +306,7 @@ namespace Core {
     }
 
     void Transform::rotateAround(Real ax, Real ay, Real az, Real px, Real py, Real pz, Real angle) {
+        this->localMatrixDirty = true;
         Matrix4x4 localTransformation;
         Matrix4x4 worldTransformation;
         worldTransformation.translate(-px, -py, -pz);
@@ -265,6 +330,7 @@ namespace Core {
     }
 
     void Transform::setWorldPosition(Real x, Real y, Real z) {
+        this->localMatrixDirty = true;
         Point3r oldPosition;
         Matrix4x4 ancestorMatrix;
         Matrix4x4 fullMatrix;
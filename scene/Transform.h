@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include "../math/Matrix4x4.h"
 #include "TransformationSpace.h"
 
@@ -11,6 +13,11 @@ namespace Core {
     class Transform final {
     public:
 
+        // parent world matrix version for a parent whose world matrix is not tracked; forces an update
+        static const UInt64 UntrackedParentVersion = 0;
+        // parent world matrix version for an identity parent transformation (e.g. the scene root)
+        static const UInt64 IdentityParentVersion = 1;
+
         Transform(const Object3D& target);
         explicit Transform(const Object3D& target, const Matrix4x4& matrix);
         ~Transform();
@@ -58,13 +65,26 @@ namespace Core {
         Bool getMatrixAutoUpdate();
         void setMatrixAutoUpdate(Bool matrixAutoUpdate);
 
+        Bool isLocalMatrixDirty() const;
+        UInt64 getWorldMatrixVersion() const;
+        Bool updateWorldMatrixFromParent(const Matrix4x4& parentWorldMatrix, UInt64 parentWorldMatrixVersion);
+        Bool needsWorldMatrixUpdate(UInt64 parentWorldMatrixVersion) const;
+
     private:
 
         static void calculateWorldMatrix(WeakPointer<Object3D> target, Matrix4x4& result);
         void getLocalTransformationFromWorldTransformation(const Matrix4x4& newWorldTransformation, Matrix4x4& localTransformation);
         void getLocalTransformationFromWorldTransformation(const Matrix4x4& newWorldTransformation, const Matrix4x4& currentFullTransformation, Matrix4x4& localTransformation);
 
+        static UInt64 nextWorldMatrixVersion();
+
         Bool matrixAutoUpdate;
+        // has the local matrix (possibly) changed since the world matrix was last derived from it?
+        Bool localMatrixDirty;
+        // unique value that changes whenever updateWorldMatrixFromParent() produces a new world matrix
+        UInt64 worldMatrixVersion;
+        // version of the parent world matrix that [worldMatrix] was derived from
+        UInt64 parentWorldMatrixVersion;
         Matrix4x4 tempMatrix;
         Matrix4x4 localMatrix;
         Matrix4x4 worldMatrix;
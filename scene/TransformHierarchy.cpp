@@ -0,0 +1,180 @@
+#include "TransformHierarchy.h"
+#include "Object3D.h"
+#include "Transform.h"
+#include "../util/WorkerPool.h"
+
+namespace Core {
+
+    const UInt32 TransformHierarchy::NoParent;
+    const UInt32 TransformHierarchy::SubtreesPerThread;
+
+    TransformHierarchy::TransformHierarchy(): root(nullptr), hierarchyVersion(0) {
+        this->identity.setIdentity();
+    }
+
+    /*
+     * Does the hierarchy mirror the active objects below [root] as they are now?
+     */
+    Bool TransformHierarchy::isBuiltFor(WeakPointer<Object3D> root) const {
+        return root.isValid() && root.get() == this->root && this->hierarchyVersion == Object3D::getHierarchyVersion();
+    }
+
+    /*
+     * Flatten [root] and its active descendants, depth-first and in child order, so the objects come out in the
+     * same order as a recursive traversal. Inactive objects are left out along with their subtrees.
+     */
+    void TransformHierarchy::build(WeakPointer<Object3D> root) {
+        this->clear();
+        if (!root.isValid()) {
+            throw InvalidArgumentException("TransformHierarchy::build() -> 'root' is invalid.");
+        }
+
+        this->addSubtree(root, NoParent);
+        UInt32 nodeCount = (UInt32)this->objects.size();
+        this->transforms.resize(nodeCount);
+        for (UInt32 i = 0; i < nodeCount; i++) {
+            this->transforms[i] = &this->objects[i]->getTransform();
+        }
+
+        // a version that no transform ever has, so every world matrix is copied by the first update
+        this->worldMatrixVersions.assign(nodeCount, Transform::UntrackedParentVersion);
+        this->worldMatrices.resize(nodeCount);
+        this->root = root.get();
+        this->hierarchyVersion = Object3D::getHierarchyVersion();
+    }
+
+    void TransformHierarchy::clear() {
+        this->root = nullptr;
+        this->objects.clear();
+        this->transforms.clear();
+        this->parentIndices.clear();
+        this->subtreeEnds.clear();
+        this->worldMatrices.clear();
+        this->worldMatrixVersions.clear();
+    }
+
+    /*
+     * Bring every world matrix in the hierarchy up to date; the root is treated as having an identity parent
+     * transformation. With a [workerPool], the nodes near the root are updated on the calling thread until the rest
+     * falls into enough independent subtrees, which are then swept in parallel. Returns the number of world matrices
+     * that were recomputed.
+     */
+    UInt32 TransformHierarchy::update(WorkerPool* workerPool) {
+        UInt32 nodeCount = (UInt32)this->transforms.size();
+        if (nodeCount == 0) return 0;
+        if (workerPool == nullptr || workerPool->getWorkerCount() == 0) return this->updateRange(0, nodeCount);
+
+        UInt32 targetJobCount = (workerPool->getWorkerCount() + 1) * SubtreesPerThread;
+        UInt32 updatedCount = 0;
+        this->subtrees.clear();
+        this->subtrees.push_back(0);
+        Bool splitAny = true;
+        while (this->subtrees.size() < targetJobCount && splitAny) {
+            splitAny = false;
+            this->nextSubtrees.clear();
+            for (UInt32 node : this->subtrees) {
+                if (this->subtreeEnds[node] == node + 1) {
+                    this->nextSubtrees.push_back(node);
+                    continue;
+                }
+                updatedCount += this->updateNode(node);
+                for (UInt32 child = node + 1; child < this->subtreeEnds[node]; child = this->subtreeEnds[child]) {
+                    this->nextSubtrees.push_back(child);
+                }
+                splitAny = true;
+            }
+            std::swap(this->subtrees, this->nextSubtrees);
+        }
+
+        // consecutive subtrees are grouped into jobs of roughly equal node counts
+        UInt32 remainingCount = 0;
+        for (UInt32 node : this->subtrees) remainingCount += this->subtreeEnds[node] - node;
+        UInt32 jobNodeCount = remainingCount / targetJobCount + 1;
+        this->jobFirstSubtrees.clear();
+        UInt32 currentJobNodeCount = jobNodeCount;
+        for (UInt32 i = 0; i < this->subtrees.size(); i++) {
+            if (currentJobNodeCount >= jobNodeCount) {
+                this->jobFirstSubtrees.push_back(i);
+                currentJobNodeCount = 0;
+            }
+            currentJobNodeCount += this->subtreeEnds[this->subtrees[i]] - this->subtrees[i];
+        }
+        UInt32 jobCount = (UInt32)this->jobFirstSubtrees.size();
+        this->jobFirstSubtrees.push_back((UInt32)this->subtrees.size());
+        this->jobUpdateCounts.assign(jobCount, 0);
+
+        workerPool->execute(jobCount, [this](UInt32 jobIndex) {
+            UInt32 jobUpdatedCount = 0;
+            for (UInt32 i = this->jobFirstSubtrees[jobIndex]; i < this->jobFirstSubtrees[jobIndex + 1]; i++) {
+                UInt32 node = this->subtrees[i];
+                jobUpdatedCount += this->updateRange(node, this->subtreeEnds[node]);
+            }
+            this->jobUpdateCounts[jobIndex] = jobUpdatedCount;
+        });
+
+        for (UInt32 jobUpdatedCount : this->jobUpdateCounts) updatedCount += jobUpdatedCount;
+        return updatedCount;
+    }
+
+    UInt32 TransformHierarchy::getNodeCount() const {
+        return (UInt32)this->objects.size();
+    }
+
+    const std::vector<PersistentWeakPointer<Object3D>>& TransformHierarchy::getObjects() const {
+        return this->objects;
+    }
+
+    UInt32 TransformHierarchy::getParentIndex(UInt32 index) const {
+        if (index >= this->parentIndices.size()) {
+            throw OutOfRangeException("TransformHierarchy::getParentIndex() -> 'index' is out of range.");
+        }
+        return this->parentIndices[index];
+    }
+
+    const Matrix4x4& TransformHierarchy::getWorldMatrix(UInt32 index) const {
+        if (index >= this->worldMatrices.size()) {
+            throw OutOfRangeException("TransformHierarchy::getWorldMatrix() -> 'index' is out of range.");
+        }
+        return this->worldMatrices[index];
+    }
+
+    void TransformHierarchy::addSubtree(WeakPointer<Object3D> object, UInt32 parentIndex) {
+        if (!object->isActive()) return;
+        UInt32 index = (UInt32)this->objects.size();
+        this->objects.push_back(object);
+        this->parentIndices.push_back(parentIndex);
+        this->subtreeEnds.push_back(index + 1);
+        for (SceneObjectIterator<Object3D> itr = object->beginIterateChildren(); itr != object->endIterateChildren(); ++itr) {
+            this->addSubtree(*itr, index);
+        }
+        this->subtreeEnds[index] = (UInt32)this->objects.size();
+    }
+
+    /*
+     * Update the world matrix of node [index], whose parent must already be up to date, and refresh the flat copy
+     * if it changed (transforms that don't auto-update get a new world matrix version every time).
+     */
+    UInt32 TransformHierarchy::updateNode(UInt32 index) {
+        Transform* transform = this->transforms[index];
+        UInt32 parentIndex = this->parentIndices[index];
+        Bool updated;
+        if (parentIndex == NoParent) {
+            updated = transform->updateWorldMatrixFromParent(this->identity, Transform::IdentityParentVersion);
+        } else {
+            updated = transform->updateWorldMatrixFromParent(this->worldMatrices[parentIndex], this->worldMatrixVersions[parentIndex]);
+        }
+
+        UInt64 worldMatrixVersion = transform->getWorldMatrixVersion();
+        if (worldMatrixVersion != this->worldMatrixVersions[index]) {
+            this->worldMatrices[index].copy(transform->getConstWorldMatrix());
+            this->worldMatrixVersions[index] = worldMatrixVersion;
+        }
+        return updated ? 1 : 0;
+    }
+
+    UInt32 TransformHierarchy::updateRange(UInt32 start, UInt32 end) {
+        UInt32 updatedCount = 0;
+        for (UInt32 i = start; i < end; i++) updatedCount += this->updateNode(i);
+        return updatedCount;
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+
+#include "../common/types.h"
+#include "../math/Matrix4x4.h"
+#include "../util/PersistentWeakPointer.h"
+
+namespace Core {
+
+    // forward declarations
+    class Object3D;
+    class Transform;
+    class WorkerPool;
+
+    /*
+     * Flat view of the active part of a scene hierarchy, used by Renderer to bring world matrices up to date.
+     * Objects are stored depth-first, so every parent comes before its children and every subtree occupies a
+     * contiguous range; their parent indices and a copy of their world matrices live in contiguous arrays. update()
+     * is then a linear sweep that reads each parent's world matrix from the flat array instead of walking the
+     * heap-allocated Object3D instances, and a subtree can be swept independently of its siblings.
+     *
+     * World matrices are derived exactly as in a recursive traversal (see Transform::updateWorldMatrixFromParent()),
+     * and written to the Transforms, which stay the owners of both local and world matrices. The hierarchy has to be
+     * rebuilt when the scene's shape changes, which isBuiltFor() detects through Object3D::getHierarchyVersion().
+     */
+    class TransformHierarchy final {
+    public:
+        static const UInt32 NoParent = 0xFFFFFFFF;
+        // the sweep is split into at least this many subtrees per thread when a worker pool is used
+        static const UInt32 SubtreesPerThread = 4;
+
+        TransformHierarchy();
+
+        Bool isBuiltFor(WeakPointer<Object3D> root) const;
+        void build(WeakPointer<Object3D> root);
+        void clear();
+        UInt32 update(WorkerPool* workerPool);
+
+        UInt32 getNodeCount() const;
+        const std::vector<PersistentWeakPointer<Object3D>>& getObjects() const;
+        UInt32 getParentIndex(UInt32 index) const;
+        const Matrix4x4& getWorldMatrix(UInt32 index) const;
+
+    private:
+        void addSubtree(WeakPointer<Object3D> object, UInt32 parentIndex);
+        UInt32 updateNode(UInt32 index);
+        UInt32 updateRange(UInt32 start, UInt32 end);
+
+        const Object3D* root;
+        UInt64 hierarchyVersion;
+        std::vector<PersistentWeakPointer<Object3D>> objects;
+        std::vector<Transform*> transforms;
+        std::vector<UInt32> parentIndices;
+        // one past the last node of the subtree rooted at each node
+        std::vector<UInt32> subtreeEnds;
+        std::vector<Matrix4x4> worldMatrices;
+        std::vector<UInt64> worldMatrixVersions;
+        Matrix4x4 identity;
+
+        // subtrees (by root node) swept as separate jobs, and the first subtree and update count of each job
+        std::vector<UInt32> subtrees;
+        std::vector<UInt32> nextSubtrees;
+        std::vector<UInt32> jobFirstSubtrees;
+        std::vector<UInt32> jobUpdateCounts;
+    };
+}
@@ -0,0 +1,98 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include "../Engine.h"
+#include "../scene/Scene.h"
+#include "../scene/Object3D.h"
+#include "../render/Camera.h"
+#include "../render/LightClusterGrid.h"
+#include "../light/PointLight.h"
+#include "../light/LightPack.h"
+#include "../util/WorkerPool.h"
+
+/*
+ * Checks that LightClusterGrid::build() produces the same arrays as the brute force reference,
+ * buildBruteForce(), for random point light sets seen through perspective and orthographic projections.
+ * Runs on the Null graphics backend.
+ */
+
+using namespace Core;
+
+static Real randomReal(Real min, Real max) {
+    return min + (max - min) * ((Real)rand() / (Real)RAND_MAX);
+}
+
+static Bool gridsMatch(const LightClusterGrid& a, const LightClusterGrid& b) {
+    return a.getClusterLightRanges() == b.getClusterLightRanges() &&
+           a.getLightIndices() == b.getLightIndices() &&
+           a.getLightData() == b.getLightData();
+}
+
+int main() {
+    Engine::setGraphicsBackend(Engine::GraphicsBackend::Null);
+    WeakPointer<Engine> engine = Engine::instance();
+    engine->setRenderSize(800, 600);
+    WeakPointer<Scene> scene = engine->createScene();
+    engine->setActiveScene(scene);
+
+    WeakPointer<Object3D> cameraObject = engine->createObject3D();
+    scene->getRoot()->addChild(cameraObject);
+    cameraObject->getTransform().translate(3.0f, 2.0f, 40.0f);
+    cameraObject->getTransform().rotate(0.0f, 1.0f, 0.0f, 0.3f);
+    const Real near = 0.5f;
+    const Real far = 150.0f;
+    WeakPointer<Camera> camera = engine->createPerspectiveCamera(cameraObject, 1.2f, 1.33f, near, far);
+
+    Matrix4x4 orthographicProjection;
+    Camera::buildOrthographicProjectionMatrix(30.0f, -30.0f, -40.0f, 40.0f, near, far, orthographicProjection);
+
+    srand(7);
+    UInt32 failures = 0;
+    const UInt32 lightCounts[] = {0, 1, 17, 250, 1000};
+    for (UInt32 lightCount : lightCounts) {
+        LightPack lightPack;
+        WeakPointer<Object3D> lightRoot = engine->createObject3D();
+        scene->getRoot()->addChild(lightRoot);
+        for (UInt32 i = 0; i < lightCount; i++) {
+            WeakPointer<Object3D> lightObject = engine->createObject3D();
+            lightRoot->addChild(lightObject);
+            lightObject->getTransform().translate(randomReal(-100.0f, 100.0f), randomReal(-20.0f, 20.0f), randomReal(-100.0f, 100.0f));
+            WeakPointer<PointLight> pointLight = engine->createPointLight<PointLight>(lightObject, false, 64, 0.1f, 0.1f);
+            pointLight->setRadius(randomReal(0.5f, 8.0f));
+            lightPack.addPointLight(pointLight);
+        }
+
+        // the grids read the lights' world matrices, which rendering the scene computes
+        engine->update();
+        engine->render();
+
+        Matrix4x4 viewMatrix;
+        viewMatrix.copy(cameraObject->getTransform().getConstWorldMatrix());
+        viewMatrix.invert();
+
+        for (UInt32 orthographic = 0; orthographic < 2; orthographic++) {
+            const Matrix4x4& projection = orthographic ? orthographicProjection : camera->getProjectionMatrix();
+            LightClusterGrid grid;
+            LightClusterGrid serialGrid;
+            LightClusterGrid referenceGrid;
+            grid.build(projection, viewMatrix, near, far, lightPack, engine->getWorkerPool().get());
+            serialGrid.build(projection, viewMatrix, near, far, lightPack, nullptr);
+            referenceGrid.buildBruteForce(projection, viewMatrix, near, far, lightPack);
+            if (!gridsMatch(grid, referenceGrid) || !gridsMatch(serialGrid, referenceGrid)) {
+                printf("LightClusterGrid mismatch: %u lights, %s projection\n", lightCount, orthographic ? "orthographic" : "perspective");
+                failures++;
+            }
+            // with this many lights some must reach the view, otherwise the grids above agree trivially
+            if (lightCount >= 250 && grid.getStats().lightReferences == 0) {
+                printf("LightClusterGrid empty: %u lights, %s projection\n", lightCount, orthographic ? "orthographic" : "perspective");
+                failures++;
+            }
+        }
+
+        scene->getRoot()->removeChild(lightRoot);
+    }
+
+    if (failures > 0) return 1;
+    printf("LightClusterGrid: build() matches buildBruteForce()\n");
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include <chrono>
+#include <cstdio>
+#include <vector>
+#include <unordered_map>
+
+#include "../common/types.h"
+#include "../util/ObjectPool.h"
+#include "../render/RenderItem.h"
+
+/*
+ * Microbenchmark for ObjectPool against the hash map based pool it replaced, using the renderer's RenderItem as
+ * the pooled type. Build the objectpool_benchmark target with optimizations and run it by hand; it prints the
+ * average time per iteration for each pool, in microseconds.
+ */
+
+namespace Core {
+
+    /*
+     * ObjectPool as it was before the free list: slot locations and object addresses are looked up in hash maps.
+     */
+    template <typename T> class HashMapObjectPool final {
+    public:
+        HashMapObjectPool(UInt32 initialCapacity) {
+            this->capacity = 0;
+            this->size = 0;
+            this->increaseCapacity(initialCapacity);
+        }
+
+        HashMapObjectPool(): HashMapObjectPool(32) {
+        }
+
+        ~HashMapObjectPool() {
+            for (UInt32 i = 0; i < this->objects.size(); i++) {
+                delete[] this->objects[i];
+            }
+        }
+
+        T& acquireObject() {
+            if (this->size >= this->capacity) this->increaseCapacity(this->capacity * 2);
+            UInt32 nextFreeLocation = this->nextFreeLocations.back();
+            StorageDesc storageDesc = this->storageMap[nextFreeLocation];
+            this->nextFreeLocations.pop_back();
+            this->size++;
+            return this->objects[storageDesc.array][storageDesc.index];
+        }
+
+        void returnObject(const T& object) {
+            auto location = this->objectLocations.find(const_cast<T*>(&object));
+            if (location != this->objectLocations.end()) {
+                this->nextFreeLocations.push_back(location->second);
+                this->size--;
+            }
+        }
+
+        void returnAll() {
+            this->objectLocations.clear();
+            this->size = 0;
+            this->nextFreeLocations.clear();
+            this->setupNextFreeLocations(0, this->capacity);
+        }
+
+    private:
+
+        class StorageDesc {
+        public:
+            UInt32 array;
+            UInt32 index;
+        };
+
+        void setupNextFreeLocations(UInt32 oldCapacity, UInt32 newCapacity) {
+            for (UInt32 i = oldCapacity; i < newCapacity; i++) {
+                this->nextFreeLocations.push_back(i);
+            }
+        }
+
+        void increaseCapacity(UInt32 newCapacity) {
+            UInt32 capacityDelta = newCapacity - this->capacity;
+            UInt32 nextArray = (UInt32)this->objects.size();
+            this->objects.push_back(new T[capacityDelta]);
+            for (UInt32 i = 0; i < capacityDelta; i++) {
+                StorageDesc storageDesc;
+                storageDesc.array = nextArray;
+                storageDesc.index = i;
+                this->storageMap[i + this->capacity] = storageDesc;
+                this->objectLocations[&this->objects[nextArray][i]] = i + this->capacity;
+            }
+            this->setupNextFreeLocations(this->capacity, newCapacity);
+            this->capacity = newCapacity;
+        }
+
+        UInt32 size;
+        UInt32 capacity;
+        std::vector<T*> objects;
+        std::unordered_map<UInt32, StorageDesc> storageMap;
+        std::unordered_map<T*, UInt32> objectLocations;
+        std::vector<UInt32> nextFreeLocations;
+    };
+
+}
+
+using namespace Core;
+
+using Clock = std::chrono::high_resolution_clock;
+
+static double elapsedMicroseconds(Clock::time_point start, UInt32 iterations) {
+    return std::chrono::duration<double, std::micro>(Clock::now() - start).count() / iterations;
+}
+
+/*
+ * The renderer's pattern: take everything back at the start of a frame, then acquire [itemCount] items.
+ */
+template <typename Pool>
+static double benchmarkFrames(UInt32 itemCount, UInt32 iterations) {
+    Pool pool;
+    Clock::time_point start = Clock::now();
+    for (UInt32 f = 0; f < iterations; f++) {
+        pool.returnAll();
+        for (UInt32 i = 0; i < itemCount; i++) pool.acquireObject().layer = i;
+    }
+    return elapsedMicroseconds(start, iterations);
+}
+
+/*
+ * Return every other item and acquire replacements.
+ */
+template <typename Pool>
+static double benchmarkChurn(UInt32 itemCount, UInt32 iterations) {
+    Pool pool;
+    std::vector<RenderItem*> items;
+    for (UInt32 i = 0; i < itemCount; i++) items.push_back(&pool.acquireObject());
+    UInt32 checksum = 0;
+    Clock::time_point start = Clock::now();
+    for (UInt32 f = 0; f < iterations; f++) {
+        for (UInt32 i = 0; i < itemCount; i += 2) pool.returnObject(*items[i]);
+        for (UInt32 i = 0; i < itemCount; i += 2) {
+            items[i] = &pool.acquireObject();
+            checksum += items[i]->layer;
+        }
+    }
+    double result = elapsedMicroseconds(start, iterations);
+    // keeps the loop from being optimized away
+    if (checksum == 1) printf(" ");
+    return result;
+}
+
+/*
+ * Fill a fresh pool from its default capacity.
+ */
+template <typename Pool>
+static double benchmarkGrowth(UInt32 itemCount, UInt32 iterations) {
+    Clock::time_point start = Clock::now();
+    for (UInt32 f = 0; f < iterations; f++) {
+        Pool pool;
+        for (UInt32 i = 0; i < itemCount; i++) pool.acquireObject().layer = i;
+    }
+    return elapsedMicroseconds(start, iterations);
+}
+
+int main() {
+    printf("%8s %24s %24s %24s\n", "items", "frame (hashmap/pool)", "churn (hashmap/pool)", "growth (hashmap/pool)");
+    for (UInt32 itemCount : {1000u, 10000u, 100000u}) {
+        UInt32 iterations = 2000000 / itemCount;
+        double hashMapFrames = benchmarkFrames<HashMapObjectPool<RenderItem>>(itemCount, iterations);
+        double poolFrames = benchmarkFrames<ObjectPool<RenderItem>>(itemCount, iterations);
+        double hashMapChurn = benchmarkChurn<HashMapObjectPool<RenderItem>>(itemCount, iterations);
+        double poolChurn = benchmarkChurn<ObjectPool<RenderItem>>(itemCount, iterations);
+        double hashMapGrowth = benchmarkGrowth<HashMapObjectPool<RenderItem>>(itemCount, iterations / 4 + 1);
+        double poolGrowth = benchmarkGrowth<ObjectPool<RenderItem>>(itemCount, iterations / 4 + 1);
+        printf("%8u %11.1f / %10.1f %11.1f / %10.1f %11.1f / %10.1f\n", itemCount,
+               hashMapFrames, poolFrames, hashMapChurn, poolChurn, hashMapGrowth, poolGrowth);
+    }
+    return 0;
+}
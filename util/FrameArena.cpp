@@ -0,0 +1,120 @@
+#include "FrameArena.h"
+#include "../common/Exception.h"
+
+namespace Core {
+
+    const UInt64 FrameArena::DefaultBlockSize;
+
+    FrameArena::Scope::Scope(FrameArena& arena): arena(arena), marker(arena.getMarker()) {
+    }
+
+    FrameArena::Scope::~Scope() {
+        this->arena.rewind(this->marker);
+    }
+
+    FrameArena::FrameArena(UInt64 initialBlockSize): currentBlock(0), offset(0), previousBlocksSize(0), peakUsedBytes(0) {
+        this->addBlock(initialBlockSize > 0 ? initialBlockSize : DefaultBlockSize);
+    }
+
+    void* FrameArena::allocate(UInt64 size, UInt64 alignment) {
+        if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+            throw InvalidArgumentException("FrameArena::allocate() -> 'alignment' must be a power of two.");
+        }
+
+        while (true) {
+            Block& block = this->blocks[this->currentBlock];
+            UInt64 address = (UInt64)(block.data.get() + this->offset);
+            UInt64 padding = (alignment - (address & (alignment - 1))) & (alignment - 1);
+            if (this->offset + padding + size <= block.size) {
+                void* pointer = block.data.get() + this->offset + padding;
+                this->offset += padding + size;
+                UInt64 usedBytes = this->getUsedBytes();
+                if (usedBytes > this->peakUsedBytes) this->peakUsedBytes = usedBytes;
+                return pointer;
+            }
+
+            // move on to the next block, replacing the ones left over from earlier frames if they're too small
+            UInt64 blockSize = block.size;
+            UInt32 nextBlock = this->currentBlock + 1;
+            if (nextBlock >= this->blocks.size() || this->blocks[nextBlock].size < size + alignment) {
+                this->blocks.resize(nextBlock);
+                this->addBlock(size + alignment);
+            }
+            this->previousBlocksSize += blockSize;
+            this->currentBlock = nextBlock;
+            this->offset = 0;
+        }
+    }
+
+    /*
+     * Give back [pointer] if it was the most recent allocation; anything else is reclaimed when the arena is rewound.
+     */
+    void FrameArena::deallocate(void* pointer, UInt64 size) {
+        Byte* blockData = this->blocks[this->currentBlock].data.get();
+        if ((Byte*)pointer + size == blockData + this->offset && (Byte*)pointer >= blockData) {
+            this->offset = (Byte*)pointer - blockData;
+        }
+    }
+
+    FrameArena::Marker FrameArena::getMarker() const {
+        Marker marker;
+        marker.block = this->currentBlock;
+        marker.offset = this->offset;
+        return marker;
+    }
+
+    void FrameArena::rewind(const Marker& marker) {
+        while (this->currentBlock > marker.block) {
+            this->currentBlock--;
+            this->previousBlocksSize -= this->blocks[this->currentBlock].size;
+        }
+        this->offset = marker.offset;
+        if (this->currentBlock == 0 && this->offset == 0) this->mergeBlocks();
+    }
+
+    void FrameArena::reset() {
+        this->currentBlock = 0;
+        this->previousBlocksSize = 0;
+        this->offset = 0;
+        this->mergeBlocks();
+    }
+
+    UInt64 FrameArena::getUsedBytes() const {
+        return this->previousBlocksSize + this->offset;
+    }
+
+    UInt64 FrameArena::getPeakUsedBytes() const {
+        return this->peakUsedBytes;
+    }
+
+    UInt64 FrameArena::getCapacity() const {
+        UInt64 capacity = 0;
+        for (const Block& block : this->blocks) capacity += block.size;
+        return capacity;
+    }
+
+    UInt32 FrameArena::getBlockCount() const {
+        return this->blocks.size();
+    }
+
+    /*
+     * Each new block is at least as big as everything allocated so far, so a pass that keeps growing
+     * only adds a logarithmic number of blocks.
+     */
+    void FrameArena::addBlock(UInt64 minimumSize) {
+        UInt64 size = minimumSize;
+        UInt64 capacity = this->getCapacity();
+        if (size < capacity) size = capacity;
+        this->blocks.emplace_back();
+        Block& block = this->blocks.back();
+        block.data = std::unique_ptr<Byte[]>(new Byte[size]);
+        block.size = size;
+    }
+
+    void FrameArena::mergeBlocks() {
+        if (this->blocks.size() <= 1) return;
+        UInt64 capacity = this->getCapacity();
+        this->blocks.clear();
+        this->addBlock(capacity);
+    }
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+#include "../common/types.h"
+
+namespace Core {
+
+    /*
+     * Linear (bump) allocator for short-lived temporaries. Memory is carved sequentially out of a list of blocks
+     * and is only reclaimed by rewinding to a marker taken earlier, so allocation is a pointer bump and freeing a
+     * whole pass's temporaries is O(1). Scope rewinds on destruction, which lets nested passes release their
+     * temporaries in LIFO order. Once the arena is rewound all the way to the start, blocks added during the frame
+     * are merged into one, so after a few frames a frame's temporaries fit in a single block and nothing is
+     * allocated from the heap.
+     *
+     * Objects placed in the arena are never destroyed by it; use FrameArenaAllocator so containers destroy their
+     * elements, and make sure they go out of scope before the arena is rewound past them.
+     */
+    class FrameArena {
+    public:
+        static const UInt64 DefaultBlockSize = 64 * 1024;
+
+        class Marker {
+            friend class FrameArena;
+            UInt32 block;
+            UInt64 offset;
+        };
+
+        class Scope {
+        public:
+            Scope(FrameArena& arena);
+            ~Scope();
+            Scope(const Scope&) = delete;
+            Scope& operator =(const Scope&) = delete;
+
+        private:
+            FrameArena& arena;
+            Marker marker;
+        };
+
+        FrameArena(UInt64 initialBlockSize = DefaultBlockSize);
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator =(const FrameArena&) = delete;
+
+        void* allocate(UInt64 size, UInt64 alignment);
+        void deallocate(void* pointer, UInt64 size);
+        Marker getMarker() const;
+        void rewind(const Marker& marker);
+        void reset();
+
+        UInt64 getUsedBytes() const;
+        UInt64 getPeakUsedBytes() const;
+        UInt64 getCapacity() const;
+        UInt32 getBlockCount() const;
+
+    private:
+        class Block {
+        public:
+            std::unique_ptr<Byte[]> data;
+            UInt64 size;
+        };
+
+        void addBlock(UInt64 minimumSize);
+        void mergeBlocks();
+
+        std::vector<Block> blocks;
+        UInt32 currentBlock;
+        UInt64 offset;
+        // combined size of the blocks before 'currentBlock'
+        UInt64 previousBlocksSize;
+        UInt64 peakUsedBytes;
+    };
+
+    /*
+     * STL allocator that takes its memory from a FrameArena. Deallocation only gives memory back when it was the
+     * most recent allocation, which covers the common case of a container freeing its buffer at the end of a pass.
+     */
+    template <typename T>
+    class FrameArenaAllocator {
+    public:
+        typedef T value_type;
+
+        template <typename U>
+        friend class FrameArenaAllocator;
+
+        FrameArenaAllocator(FrameArena& arena): arena(&arena) {
+        }
+
+        template <typename U>
+        FrameArenaAllocator(const FrameArenaAllocator<U>& other): arena(other.arena) {
+        }
+
+        T* allocate(std::size_t count) {
+            return static_cast<T*>(this->arena->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* pointer, std::size_t count) {
+            this->arena->deallocate(pointer, count * sizeof(T));
+        }
+
+        template <typename U>
+        Bool operator ==(const FrameArenaAllocator<U>& other) const {
+            return this->arena == other.arena;
+        }
+
+        template <typename U>
+        Bool operator !=(const FrameArenaAllocator<U>& other) const {
+            return this->arena != other.arena;
+        }
+
+    private:
+        FrameArena* arena;
+    };
+
+    template <typename T>
+    using FrameVector = std::vector<T, FrameArenaAllocator<T>>;
+}
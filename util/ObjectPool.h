@@ -1,110 +1,128 @@
 #pragma once
 
 #include <vector>
-#include <unordered_map>
+#include <memory>
 
 #include "../common/types.h"
 
 namespace Core {
 
+    /*
+     * Pool of default-constructed objects that are handed out and taken back without allocating. Storage is a list
+     * of chunks that never move, so references returned by acquireObject() stay valid as the pool grows; each new
+     * chunk doubles the capacity. Returned objects are kept on an intrusive free list threaded through their slots,
+     * and untouched slots are handed out in order from a cursor, so acquireObject() and returnObject() are O(1).
+     *
+     * Objects are reused as they are, not reset. returnAll() takes back every object in O(1) by rewinding the
+     * cursor and starting a new epoch: a slot only counts as acquired if it was acquired in the current epoch,
+     * so returning an object twice, or returning one that was acquired before returnAll(), is ignored.
+     */
     template <typename T> class ObjectPool final {
     public:
         ObjectPool(UInt32 initialCapacity) {
             this->capacity = 0;
             this->size = 0;
-            this->increaseCapacity(initialCapacity);
+            this->epoch = 1;
+            this->freeListHead = nullptr;
+            this->cursorChunk = 0;
+            this->cursorIndex = 0;
+            this->increaseCapacity(initialCapacity > 0 ? initialCapacity : 1);
         }
 
         ObjectPool(): ObjectPool(32) {
-            
-        }
 
-        ~ObjectPool() {
-            this->deallocateObjects();
         }
 
-        UInt32 getCapacity() {
+        ObjectPool(const ObjectPool&) = delete;
+        ObjectPool& operator =(const ObjectPool&) = delete;
+
+        UInt32 getCapacity() const {
             return this->capacity;
         }
 
+        UInt32 getSize() const {
+            return this->size;
+        }
+
         T& acquireObject() {
-            if (this->size >= this->capacity) this->increaseCapacity();
-            UInt32 nextFreeLocation = this->nextFreeLocations.back();
-            StorageDesc storageDesc = this->storageMap[nextFreeLocation];
-            this->nextFreeLocations.pop_back();
-            T& targetObj = this->objects[storageDesc.array][storageDesc.index];
+            Slot* slot = this->freeListHead;
+            if (slot != nullptr) {
+                this->freeListHead = slot->nextFree;
+            } else {
+                if (this->cursorIndex >= this->chunks[this->cursorChunk].size) {
+                    this->cursorChunk++;
+                    this->cursorIndex = 0;
+                    if (this->cursorChunk >= this->chunks.size()) this->increaseCapacity(this->capacity);
+                }
+                slot = &this->chunks[this->cursorChunk].slots[this->cursorIndex];
+                this->cursorIndex++;
+            }
+            slot->nextFree = nullptr;
+            slot->acquiredEpoch = this->epoch;
             this->size++;
-            return targetObj;
+            return slot->object;
         }
 
+        /*
+         * [object] must have come from this pool.
+         */
         void returnObject(const T& object) {
-            if (this->objectLocations.find(&object) != this->objectLocations.end()) {
-                UInt32 returnLocation = this->objectLocations[&object];
-                this->nextFreeLocations.push_back(returnLocation);
-                this->size--;
-            }
-        }   
+            // 'object' is the first member of its slot
+            Slot* slot = reinterpret_cast<Slot*>(const_cast<T*>(&object));
+            if (slot->acquiredEpoch != this->epoch) return;
+            slot->acquiredEpoch = 0;
+            slot->nextFree = this->freeListHead;
+            this->freeListHead = slot;
+            this->size--;
+        }
 
         void returnAll() {
-            this->objectLocations.clear();
+            this->epoch++;
+            // a wrapped epoch could match a slot acquired 2^32 resets ago
+            if (this->epoch == 0) this->clearEpochs();
             this->size = 0;
-            this->nextFreeLocations.clear();
-            this->setupNextFreeLocations(0, this->capacity);
+            this->freeListHead = nullptr;
+            this->cursorChunk = 0;
+            this->cursorIndex = 0;
         }
 
     private:
 
-        class StorageDesc {
-            public:
-            StorageDesc() {}
-            StorageDesc(UInt32 array, UInt32 index) {
-                this->array = array;
-                this->index = index;
-            }
-            UInt32 array;
-            UInt32 index;
+        class Slot {
+        public:
+            T object;
+            Slot* nextFree = nullptr;
+            UInt32 acquiredEpoch = 0;
         };
 
-        void deallocateObjects () {
-            for (UInt32 i = 0; i < this->objects.size(); i++) {
-                delete[] this->objects[i];
-            }
-            this->objects.erase(this->objects.begin(), this->objects.end());
-        }
-        
-        void setupNextFreeLocations(UInt32 oldCapacity, UInt32 newCapacity) {
-            for (UInt32 i = oldCapacity; i < newCapacity; i++) {
-                this->nextFreeLocations.push_back(i);
-            }
-        }
+        class Chunk {
+        public:
+            std::unique_ptr<Slot[]> slots;
+            UInt32 size;
+        };
 
-        void increaseCapacity() {
-            increaseCapacity(this->capacity * 2);
+        void increaseCapacity(UInt32 capacityDelta) {
+            this->chunks.emplace_back();
+            Chunk& chunk = this->chunks.back();
+            chunk.slots = std::unique_ptr<Slot[]>(new Slot[capacityDelta]);
+            chunk.size = capacityDelta;
+            this->capacity += capacityDelta;
         }
 
-        void increaseCapacity(UInt32 newCapacity) {
-            UInt32 capacityDelta = newCapacity - this->capacity;
-            T* temp = new T[capacityDelta];
-            UInt32 nextArray = this->objects.size();
-            this->objects.push_back(temp);
-            for (unsigned int i = 0; i < capacityDelta; i++) {
-                this->storageMap[i + this->capacity] = StorageDesc(nextArray, i);
-            }
-            for (unsigned int i = capacity; i < newCapacity; i++) {
-                StorageDesc storageDesc = this->storageMap[i];
-                T& object = this->objects[storageDesc.array][storageDesc.index];
-                this->objectLocations[&object] = i;
+        void clearEpochs() {
+            for (Chunk& chunk : this->chunks) {
+                for (UInt32 i = 0; i < chunk.size; i++) chunk.slots[i].acquiredEpoch = 0;
             }
-            setupNextFreeLocations(capacity, newCapacity);
-            this->capacity = newCapacity;
+            this->epoch = 1;
         }
 
         UInt32 size;
-        std::vector<T*> objects;
         UInt32 capacity;
-        std::unordered_map<UInt32, StorageDesc> storageMap;
-        std::unordered_map<T*, UInt32> objectLocations;
-        std::vector<UInt32> nextFreeLocations;
+        UInt32 epoch;
+        std::vector<Chunk> chunks;
+        Slot* freeListHead;
+        UInt32 cursorChunk;
+        UInt32 cursorIndex;
     };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,101 @@
+#include "WorkerPool.h"
+
+namespace Core {
+
+    WorkerPool::WorkerPool(UInt32 workerCount): currentJob(nullptr), jobCount(0), nextJob(0), busyWorkers(0), generation(0), shuttingDown(false) {
+        for (UInt32 i = 0; i < workerCount; i++) {
+            this->workers.push_back(std::thread(&WorkerPool::workerLoop, this));
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->shuttingDown = true;
+        }
+        this->workAvailable.notify_all();
+        for (std::thread& worker : this->workers) {
+            worker.join();
+        }
+    }
+
+    UInt32 WorkerPool::getWorkerCount() const {
+        return (UInt32)this->workers.size();
+    }
+
+    void WorkerPool::execute(UInt32 jobCount, const Job& job) {
+        if (jobCount == 0) return;
+        if (this->workers.size() == 0 || jobCount == 1) {
+            for (UInt32 i = 0; i < jobCount; i++) job(i);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->currentJob = &job;
+            this->jobCount = jobCount;
+            this->nextJob = 0;
+            this->busyWorkers = (UInt32)this->workers.size();
+            this->jobException = nullptr;
+            this->generation++;
+        }
+        this->workAvailable.notify_all();
+
+        this->runJobs();
+
+        std::exception_ptr exception;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->workDone.wait(lock, [this]() {
+                return this->busyWorkers == 0;
+            });
+            this->currentJob = nullptr;
+            exception = this->jobException;
+        }
+        if (exception) std::rethrow_exception(exception);
+    }
+
+    /*
+     * One worker per hardware thread, leaving one for the calling thread (which also runs jobs).
+     */
+    UInt32 WorkerPool::getDefaultWorkerCount() {
+        UInt32 hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    void WorkerPool::workerLoop() {
+        UInt64 completedGeneration = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->workAvailable.wait(lock, [this, completedGeneration]() {
+                    return this->shuttingDown || this->generation != completedGeneration;
+                });
+                if (this->shuttingDown) return;
+                completedGeneration = this->generation;
+            }
+
+            this->runJobs();
+
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->busyWorkers--;
+                if (this->busyWorkers == 0) this->workDone.notify_one();
+            }
+        }
+    }
+
+    void WorkerPool::runJobs() {
+        while (true) {
+            UInt32 jobIndex = this->nextJob.fetch_add(1);
+            if (jobIndex >= this->jobCount) break;
+            try {
+                (*this->currentJob)(jobIndex);
+            }
+            catch(...) {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                if (!this->jobException) this->jobException = std::current_exception();
+            }
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+#include "../common/types.h"
+
+namespace Core {
+
+    /*
+     * Fixed set of worker threads for data-parallel work. execute() hands out job indices to the workers
+     * and the calling thread, and returns once every job has finished. An exception thrown by a job is
+     * rethrown on the calling thread. execute() must not be called concurrently or from inside a job.
+     */
+    class WorkerPool {
+    public:
+        typedef std::function<void(UInt32 jobIndex)> Job;
+
+        WorkerPool(UInt32 workerCount);
+        ~WorkerPool();
+
+        UInt32 getWorkerCount() const;
+        void execute(UInt32 jobCount, const Job& job);
+
+        static UInt32 getDefaultWorkerCount();
+
+    private:
+        void workerLoop();
+        void runJobs();
+
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable workAvailable;
+        std::condition_variable workDone;
+        const Job* currentJob;
+        UInt32 jobCount;
+        std::atomic<UInt32> nextJob;
+        UInt32 busyWorkers;
+        UInt64 generation;
+        Bool shuttingDown;
+        std::exception_ptr jobException;
+    };
+}